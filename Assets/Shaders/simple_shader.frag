@@ -1,5 +1,11 @@
 #version 450
 
+// Specialization constants, see ShaderPermutation
+layout(constant_id = 1) const int SHAPE_MODE = 0; // 0: mesh, 1: SDF circle
+
+layout (location = 0) in vec3 fragColor;
+layout (location = 1) in vec2 fragLocalPos;
+
 layout (location = 0) out vec4 outColor;
 
 layout(push_constant) uniform Push {
@@ -10,5 +16,15 @@ layout(push_constant) uniform Push {
 
 void main()
 {
-    outColor = vec4(push.color, 1.0);
+    if (SHAPE_MODE == 1)
+    {
+        // Signed distance to the unit circle in model space
+        float dist = length(fragLocalPos) - 1.0;
+        if (dist > 0.0)
+        {
+            discard;
+        }
+    }
+
+    outColor = vec4(fragColor, 1.0);
 }
\ No newline at end of file
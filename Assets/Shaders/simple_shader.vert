@@ -1,8 +1,20 @@
 #version 450
 
+// Specialization constants, see ShaderPermutation
+layout(constant_id = 0) const int COLOR_SOURCE = 0; // 0: push constant, 1: vertex color
+
 layout(location = 0) in vec2 position;
 layout(location = 1) in vec3 color;
 
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragLocalPos;
+
+layout(set = 0, binding = 0) uniform GlobalUbo {
+  mat4 viewProj;
+  vec4 viewport; // width, height, 1 / width, 1 / height
+  vec4 time;     // seconds, frame delta
+} ubo;
+
 layout(push_constant) uniform Push {
   mat2 transform;
   vec2 offset;
@@ -10,5 +22,7 @@ layout(push_constant) uniform Push {
 } push;
 
 void main() {
-  gl_Position = vec4(push.transform * position + push.offset, 0.0, 1.0);
+  gl_Position = ubo.viewProj * vec4(push.transform * position + push.offset, 0.0, 1.0);
+  fragColor = (COLOR_SOURCE == 1) ? color : push.color;
+  fragLocalPos = position;
 }
\ No newline at end of file
@@ -0,0 +1,20 @@
+#version 450
+
+layout (location = 0) in vec2 fragUv;
+
+layout (location = 0) out vec4 outColor;
+
+// Resident mips of the sprite texture, see TextureManager
+layout(set = 1, binding = 0) uniform sampler2D spriteTexture;
+
+layout(push_constant) uniform Push {
+  mat2 transform;
+  vec2 offset;
+  vec3 tint;
+} push;
+
+void main()
+{
+    vec4 texel = texture(spriteTexture, fragUv);
+    outColor = vec4(texel.rgb * push.tint, texel.a);
+}
@@ -0,0 +1,23 @@
+#version 450
+
+layout(location = 0) in vec2 position;
+
+layout(location = 0) out vec2 fragUv;
+
+layout(set = 0, binding = 0) uniform GlobalUbo {
+  mat4 viewProj;
+  vec4 viewport; // width, height, 1 / width, 1 / height
+  vec4 time;     // seconds, frame delta
+} ubo;
+
+layout(push_constant) uniform Push {
+  mat2 transform;
+  vec2 offset;
+  vec3 tint;
+} push;
+
+void main() {
+  gl_Position = ubo.viewProj * vec4(push.transform * position + push.offset, 0.0, 1.0);
+  // Quads span [-0.5, 0.5], the top left corner samples the first texel row.
+  fragUv = position + 0.5;
+}
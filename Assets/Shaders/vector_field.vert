@@ -0,0 +1,33 @@
+#version 450
+
+layout(location = 0) in vec2 position;
+
+layout(location = 0) out vec3 fragColor;
+
+struct FieldInstance
+{
+  vec4 transform; // mat2 columns
+  vec4 offset;    // xy, unused
+};
+
+layout(set = 0, binding = 0) uniform GlobalUbo {
+  mat4 viewProj;
+  vec4 viewport; // width, height, 1 / width, 1 / height
+  vec4 time;     // seconds, frame delta
+} ubo;
+
+// Written by vector_field.comp
+layout(set = 1, binding = 0) readonly buffer Instances {
+  FieldInstance instances[];
+};
+
+layout(push_constant) uniform Push {
+  vec4 color;
+} push;
+
+void main() {
+  FieldInstance instance = instances[gl_InstanceIndex];
+  mat2 transform = mat2(instance.transform.xy, instance.transform.zw);
+  gl_Position = ubo.viewProj * vec4(transform * position + instance.offset.xy, 0.0, 1.0);
+  fragColor = push.color.rgb;
+}
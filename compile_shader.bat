@@ -30,5 +30,15 @@ for %%f in (%SHADER_DIR%*.frag) do (
     )
 )
 
+echo Compiling Compute Shader ...
+for %%f in (%SHADER_DIR%*.comp) do (
+    glslc %%f -o %OUT_DIR%\%%~nf.comp.spv
+    if errorlevel 1 (
+        echo Failed to compile : %%f
+        pause
+        exit /b 1
+    )
+)
+
 echo Shader Compilation Complete !!
 pause
\ No newline at end of file
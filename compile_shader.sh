@@ -37,4 +37,16 @@ for shader in "$shader_dir"/*.frag; do
     fi
 done
 
+echo "[Compile] Compiling Compute Shader"
+for shader in "$shader_dir"/*.comp; do 
+# Extract the base name of the shader file 
+    shader_name=$(basename -- "$shader")
+    # Compile the shader
+    glslc "$shader" -o "$output_dir${shader_name}.spv"
+    # Check if compilation was successful
+    if [ ! $? -eq 0 ]; then
+        echo "Failed to compile $shader_name."
+    fi
+done
+
 echo "Exited Script"
@@ -5,21 +5,50 @@
 #include <Graphics/GameObject.hpp>
 #include <Graphics/Renderer.ipp>
 #include <Graphics/Vulkan/VkInstanceImpl.hpp>
+#include <Graphics/Vulkan/VkPipelineBuilderImpl.hpp>
 #include <Settings.hpp>
 
 // STD Lib
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace Graphic
 {
 
+struct ApplicationConfig
+{
+    bool headless = false;         // No window, see HEADLESS_SURFACE_EXT
+    uint32_t frameCount = 0;       // Frames to render, 0 -> until the window is closed
+    uint32_t width = DISPLAY_WIDTH;
+    uint32_t height = DISPLAY_HEIGHT;
+    bool warmPipelineCache = false;
+    uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;
+    uint32_t swapChainImages = DEFAULT_SWAPCHAIN_IMAGE_COUNT; // 0 -> minImageCount + 1
+    std::string gpu;               // GPU name or UUID, empty -> GPU_SELECT_ENV / best score
+    std::string meshPath;          // glTF / OBJ drawn with vertex colors, empty -> none
+    std::string texturePath;       // TGA / PPM / KTX2 streamed in and drawn as a sprite, empty -> none
+    std::string assetArchive;      // Mounted when it exists, see ASSET_ARCHIVE_NAME
+
+    bool capture = false;          // Write every rendered frame to disk
+    std::string captureDir;        // Empty -> FRAME_CAPTURE_DIR
+    Core::ImageFileFormat captureFormat = Core::ImageFileFormat::Png;
+    bool batch = false;            // Headless capture of frameCount frames, as fast as possible
+};
+
+// Parses --headless, --frames N, --width N, --height N, --capture DIR,
+// --capture-format ppm|png|raw, --batch N, --frames-in-flight N, --swapchain-images N,
+// --gpu NAME|UUID, --mesh PATH, --texture PATH, --assets PATH and --warm-pipeline-cache.
+ApplicationConfig ParseApplicationConfig(int argc, const char* argv[]);
+
+//----------------------------------------------------------------------------//
+
 class Application
 {
 
 public:
 
-    Application();
+    Application(const ApplicationConfig& config = {});
     ~Application();
 
     Application(const Application&) = delete;
@@ -27,15 +56,22 @@ public:
 
     void RenderLoop();
 
+    // Compile the default pipelines once so the on-disk pipeline cache is populated.
+    void WarmPipelineCache();
+
 private:
 
     void LoadGameObjects();
 
-    WindowHandler window_{DISPLAY_WIDTH,DISPLAY_HEIGHT};
-    VkDeviceInstance deviceInst_{&window_};
-    Renderer renderer_{&window_, &deviceInst_};
+    ApplicationConfig config_;
+
+    std::unique_ptr<WindowHandler> window_; // Null when headless
+    VkDeviceInstance deviceInst_;
+    AsyncPipelineBuilder pipelineBuilder_;
+    Renderer renderer_;
 
     std::vector<GameObject> gameObjects_;
+    std::vector<GameObject> importedObjects_; // From config_.meshPath
 };
 
 } // namespace Graphic
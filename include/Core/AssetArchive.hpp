@@ -0,0 +1,102 @@
+#ifndef CORE_ASSETARCHIVE_HPP
+#define CORE_ASSETARCHIVE_HPP
+#pragma once
+
+#include <Core/MappedFile.hpp>
+#include <Global.hpp>
+
+// STD Lib
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core
+{
+
+constexpr uint32_t ASSET_ARCHIVE_MAGIC = 0x41584647; // "GFXA"
+constexpr uint32_t ASSET_ARCHIVE_VERSION = 1;
+
+// Entry data alignment, enough for SPIR-V words and cache line reads.
+constexpr uint64_t ASSET_ARCHIVE_ALIGNMENT = 64;
+
+enum class AssetCompression : uint8_t
+{
+    None = 0,
+    Lz4 = 1 // LZ4 block, see Core/Lz4.hpp
+};
+
+// Little endian, at offset 0.
+struct AssetArchiveHeader
+{
+    uint32_t magic = ASSET_ARCHIVE_MAGIC;
+    uint32_t version = ASSET_ARCHIVE_VERSION;
+    uint32_t entryCount = 0;
+    uint32_t reserved = 0;
+    uint64_t indexOffset = 0; // AssetArchiveEntry[entryCount], sorted by (pathHash, path)
+    uint64_t pathOffset = 0;  // Normalized paths, not null terminated
+};
+static_assert(sizeof(AssetArchiveHeader) == 32, "Asset archive header layout changed");
+
+struct AssetArchiveEntry
+{
+    uint64_t pathHash = 0;   // HashAssetPath of the normalized path
+    uint64_t offset = 0;     // ASSET_ARCHIVE_ALIGNMENT aligned
+    uint64_t storedSize = 0;
+    uint64_t size = 0;       // Uncompressed
+    uint32_t pathOffset = 0; // Into the path table
+    uint16_t pathLength = 0;
+    uint8_t compression = 0; // AssetCompression
+    uint8_t reserved = 0;
+};
+static_assert(sizeof(AssetArchiveEntry) == 40, "Asset archive entry layout changed");
+
+// Forward slashes, no leading "/" or "./", so "/Assets/a.spv" and "Assets\a.spv" match.
+std::string NormalizeAssetPath(std::string_view path);
+
+// 64 bit FNV-1a of a normalized path.
+uint64_t HashAssetPath(std::string_view normalizedPath);
+
+// Read only view of a mapped archive. Lookups binary search the index, nothing is
+// loaded up front. Safe to read from several threads.
+class AssetArchive
+{
+
+public:
+    // Validates the header, the index and every entry's bounds, including the
+    // uncompressed size of LZ4 entries against their stored size.
+    bool Open(const std::string& filePath);
+
+    // Null when missing, 'path' doesn't need to be normalized.
+    const AssetArchiveEntry* Find(std::string_view path) const;
+
+    // Stored bytes of an entry, the file data itself for uncompressed entries.
+    const uint8_t* GetStoredData(const AssetArchiveEntry& entry) const;
+    std::string_view GetPath(const AssetArchiveEntry& entry) const;
+
+    // Uncompressed copy of the entry.
+    bool Read(const AssetArchiveEntry& entry, std::vector<char>& data) const;
+
+    uint32_t GetEntryCount() const;
+    const std::string& GetFilePath() const;
+
+private:
+    MappedFile file_;
+    std::string filePath_;
+    const AssetArchiveEntry* entries_ = nullptr;
+    uint32_t entryCount_ = 0;
+    const char* paths_ = nullptr;
+};
+
+// One file to pack, 'path' is normalized by WriteAssetArchive.
+struct AssetArchiveInput
+{
+    std::string path;
+    std::vector<uint8_t> data;
+};
+
+// Entries are LZ4 compressed when that saves at least 'minSavings' (0..1) of their size.
+bool WriteAssetArchive(const std::string& filePath, const std::vector<AssetArchiveInput>& inputs, float minSavings);
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef CORE_ASSETARCHIVE_IPP
+#define CORE_ASSETARCHIVE_IPP
+#pragma once
+
+#include <Core/AssetArchive.hpp>
+#include <Core/MappedFile.ipp>
+
+namespace Core
+{
+
+inline const uint8_t* AssetArchive::GetStoredData(const AssetArchiveEntry& entry) const
+{
+    return file_.GetData() + entry.offset;
+}
+
+inline std::string_view AssetArchive::GetPath(const AssetArchiveEntry& entry) const
+{
+    return std::string_view(paths_ + entry.pathOffset, entry.pathLength);
+}
+
+inline uint32_t AssetArchive::GetEntryCount() const
+{
+    return entryCount_;
+}
+
+inline const std::string& AssetArchive::GetFilePath() const
+{
+    return filePath_;
+}
+
+} // namespace Core
+
+#endif
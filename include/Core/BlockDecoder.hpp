@@ -0,0 +1,29 @@
+#ifndef CORE_BLOCKDECODER_HPP
+#define CORE_BLOCKDECODER_HPP
+#pragma once
+
+#include <Core/ImageReader.hpp>
+
+namespace Core
+{
+
+// 4x4 block compressed formats with a CPU decoder.
+enum class BlockFormat
+{
+    BC1 = 0, // RGB + 1 bit alpha
+    BC2 = 1, // RGB + explicit 4 bit alpha
+    BC3 = 2, // RGB + interpolated alpha
+    BC4 = 3, // R, unsigned
+    BC5 = 4  // RG, unsigned
+};
+
+// Bytes per 4x4 block.
+uint32_t GetBlockByteSize(BlockFormat format);
+
+// Decodes one level to RGBA8. BC4/BC5 fill the missing channels with 0 and alpha with
+// 255. Fails when 'size' is smaller than the level's block count requires.
+bool DecodeBlocks(BlockFormat format, const uint8_t* data, size_t size, uint32_t width, uint32_t height, ImageData& image);
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef CORE_BLOCKDECODER_IPP
+#define CORE_BLOCKDECODER_IPP
+#pragma once
+
+#include <Core/BlockDecoder.hpp>
+
+namespace Core
+{
+
+inline uint32_t GetBlockByteSize(BlockFormat format)
+{
+    return ((format == BlockFormat::BC1) || (format == BlockFormat::BC4)) ? 8 : 16;
+}
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef CORE_COOKEDMESH_HPP
+#define CORE_COOKEDMESH_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <string>
+#include <vector>
+
+namespace Core
+{
+
+constexpr uint32_t COOKED_MESH_MAGIC = 0x4D584647; // "GFXM"
+constexpr uint32_t COOKED_MESH_VERSION = 1;
+constexpr const char* COOKED_MESH_EXTENSION = "gmesh";
+
+// Blobs start on a page boundary, so their pages map straight into a staging copy.
+constexpr uint64_t COOKED_MESH_ALIGNMENT = 4096;
+
+// Vertex layout the blob was cooked for, a file cooked for another one is rejected.
+enum class CookedVertexLayout : uint32_t
+{
+    Position2Color3 = 1 // Graphic::Vertex
+};
+
+// Index range of one level of detail, all levels share the vertex blob.
+struct CookedMeshLod
+{
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f;    // Largest vertex displacement, 0 for the full mesh
+    uint32_t reserved = 0;
+};
+
+// Little endian, at offset 0. Followed by the vertex blob, the uint32 index blob (every
+// level) and the LOD table, each at a COOKED_MESH_ALIGNMENT multiple.
+struct CookedMeshHeader
+{
+    uint32_t magic = COOKED_MESH_MAGIC;
+    uint32_t version = COOKED_MESH_VERSION;
+    uint32_t vertexLayout = 0;
+    uint32_t vertexStride = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t lodCount = 0;
+    uint32_t reserved = 0;
+    float boundsMin[2] = {0.0f, 0.0f};
+    float boundsMax[2] = {0.0f, 0.0f};
+    uint64_t vertexOffset = 0;
+    uint64_t indexOffset = 0;
+    uint64_t lodOffset = 0;
+};
+static_assert(sizeof(CookedMeshHeader) == 72, "Cooked mesh header layout changed");
+
+// Points into the file data, nothing is copied.
+struct CookedMeshView
+{
+    CookedMeshHeader header;
+    const uint8_t* vertexData = nullptr;
+    const uint32_t* indexData = nullptr;
+    const CookedMeshLod* lods = nullptr;
+};
+
+// Validates the header, the blob bounds, LOD ranges, index values and the expected
+// vertex layout, so a stale or corrupt file can't make the GPU fetch past the vertices.
+bool ParseCookedMesh(
+    const uint8_t* data,
+    size_t size,
+    CookedVertexLayout layout,
+    uint32_t vertexStride,
+    CookedMeshView& view);
+
+// Fills the offsets of 'header' and writes the file.
+bool WriteCookedMesh(
+    const std::string& filePath,
+    CookedMeshHeader header,
+    const void* vertexData,
+    const std::vector<uint32_t>& indices,
+    const std::vector<CookedMeshLod>& lods);
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef CORE_COOKEDMESH_IPP
+#define CORE_COOKEDMESH_IPP
+#pragma once
+
+#include <Core/CookedMesh.hpp>
+
+namespace Core
+{
+
+inline uint64_t AlignCookedOffset(uint64_t offset)
+{
+    return (offset + COOKED_MESH_ALIGNMENT - 1) & ~(COOKED_MESH_ALIGNMENT - 1);
+}
+
+} // namespace Core
+
+#endif
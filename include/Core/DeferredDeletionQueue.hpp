@@ -0,0 +1,50 @@
+#ifndef CORE_DEFERREDDELETIONQUEUE_HPP
+#define CORE_DEFERREDDELETIONQUEUE_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <deque>
+#include <functional>
+
+namespace Core
+{
+
+// Holds destruction callbacks until the GPU has finished the frame that last used
+// the resources. Frame numbers are expected to be pushed in increasing order.
+// Not thread safe, owned and flushed by the render thread.
+class DeferredDeletionQueue
+{
+
+public:
+    DeferredDeletionQueue() = default;
+    ~DeferredDeletionQueue();
+
+    DeferredDeletionQueue(const DeferredDeletionQueue&) = delete;
+    DeferredDeletionQueue& operator=(const DeferredDeletionQueue&) = delete;
+
+    // Run the deleter once frame 'lastUsedFrame' is known to be complete.
+    void Push(uint64_t lastUsedFrame, std::function<void()> deleter);
+
+    // Run every deleter whose frame is <= completedFrame.
+    void Flush(uint64_t completedFrame);
+
+    // Only safe once the device is idle.
+    void FlushAll();
+
+    size_t GetPendingCount() const;
+
+private:
+    struct PendingDeletion
+    {
+        uint64_t frame;
+        std::function<void()> deleter;
+    };
+
+    std::deque<PendingDeletion> pending_;
+};
+
+} // namespace Core
+
+#endif
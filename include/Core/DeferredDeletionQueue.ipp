@@ -0,0 +1,17 @@
+#ifndef CORE_DEFERREDDELETIONQUEUE_IPP
+#define CORE_DEFERREDDELETIONQUEUE_IPP
+#pragma once
+
+#include <Core/DeferredDeletionQueue.hpp>
+
+namespace Core
+{
+
+inline size_t DeferredDeletionQueue::GetPendingCount() const
+{
+    return pending_.size();
+}
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef CORE_HASH_HPP
+#define CORE_HASH_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <cstddef>
+#include <string_view>
+
+namespace Core
+{
+
+// 64-bit FNV-1a constants
+constexpr uint64_t FNV1A_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV1A_PRIME = 0x100000001b3ULL;
+
+// Non-cryptographic hash used for cache validation and asset lookups.
+uint64_t HashFnv1a(const void* data, size_t size, uint64_t seed = FNV1A_OFFSET_BASIS);
+
+uint64_t HashFnv1a(std::string_view text, uint64_t seed = FNV1A_OFFSET_BASIS);
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef CORE_HASH_IPP
+#define CORE_HASH_IPP
+#pragma once
+
+#include <Core/Hash.hpp>
+
+namespace Core
+{
+
+inline uint64_t HashFnv1a(const void* data, size_t size, uint64_t seed)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint64_t>(bytes[i]);
+        hash *= FNV1A_PRIME;
+    }
+
+    return hash;
+}
+
+inline uint64_t HashFnv1a(std::string_view text, uint64_t seed)
+{
+    return HashFnv1a(text.data(), text.size(), seed);
+}
+
+} // namespace Core
+
+#endif
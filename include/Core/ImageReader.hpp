@@ -0,0 +1,38 @@
+#ifndef CORE_IMAGEREADER_HPP
+#define CORE_IMAGEREADER_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <string>
+#include <vector>
+
+namespace Core
+{
+
+// Tightly packed RGBA8, rows top to bottom.
+struct ImageData
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> rgba;
+
+    bool IsValid() const;
+    size_t GetByteSize() const;
+};
+
+// Binary PPM (P6, maxval 255) and TGA (true color or grayscale, raw or RLE). The
+// format is detected from the content, not the file name.
+bool DecodeImage(const uint8_t* data, size_t size, ImageData& image);
+bool ReadImageFile(const std::string& filePath, ImageData& image);
+
+// 2x2 box filter, odd sizes repeat the last row/column. 1x1 stays 1x1.
+void HalveImage(const ImageData& src, ImageData& dst);
+
+// Number of levels of a full mip chain down to 1x1.
+uint32_t GetMipLevelCount(uint32_t width, uint32_t height);
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef CORE_IMAGEREADER_IPP
+#define CORE_IMAGEREADER_IPP
+#pragma once
+
+#include <Core/ImageReader.hpp>
+
+namespace Core
+{
+
+inline bool ImageData::IsValid() const
+{
+    return (width > 0) && (height > 0) && (rgba.size() == GetByteSize());
+}
+
+inline size_t ImageData::GetByteSize() const
+{
+    return static_cast<size_t>(width) * height * 4;
+}
+
+inline uint32_t GetMipLevelCount(uint32_t width, uint32_t height)
+{
+    uint32_t levels = 1;
+    uint32_t size = (width > height) ? width : height;
+    while (size > 1)
+    {
+        size >>= 1;
+        levels++;
+    }
+    return levels;
+}
+
+} // namespace Core
+
+#endif
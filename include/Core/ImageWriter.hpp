@@ -0,0 +1,36 @@
+#ifndef CORE_IMAGEWRITER_HPP
+#define CORE_IMAGEWRITER_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <string>
+#include <string_view>
+
+namespace Core
+{
+
+enum class ImageFileFormat : uint32_t
+{
+    Ppm = 0, // Binary P6, alpha dropped
+    Png = 1, // RGBA, stored (uncompressed) deflate blocks so encoding stays cheap
+    Raw = 2, // Tightly packed RGBA8, no header
+};
+
+const char* ImageFileExtension(ImageFileFormat format);
+
+// Accepts "ppm", "png" and "raw", returns false for anything else.
+bool ParseImageFileFormat(std::string_view name, ImageFileFormat& format);
+
+// Pixels are tightly packed RGBA8, rows top to bottom.
+bool WriteImageFile(
+    const std::string& filePath,
+    ImageFileFormat format,
+    uint32_t width,
+    uint32_t height,
+    const uint8_t* rgba);
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef CORE_IMAGEWRITER_IPP
+#define CORE_IMAGEWRITER_IPP
+#pragma once
+
+#include <Core/ImageWriter.hpp>
+
+namespace Core
+{
+
+inline const char* ImageFileExtension(ImageFileFormat format)
+{
+    switch (format)
+    {
+        case ImageFileFormat::Ppm: return ".ppm";
+        case ImageFileFormat::Png: return ".png";
+        case ImageFileFormat::Raw: return ".raw";
+    }
+    return "";
+}
+
+inline bool ParseImageFileFormat(std::string_view name, ImageFileFormat& format)
+{
+    if (name == "ppm") { format = ImageFileFormat::Ppm; return true; }
+    if (name == "png") { format = ImageFileFormat::Png; return true; }
+    if (name == "raw") { format = ImageFileFormat::Raw; return true; }
+    return false;
+}
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef CORE_JSON_HPP
+#define CORE_JSON_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Core
+{
+
+enum class JsonType
+{
+    Null = 0,
+    Bool = 1,
+    Number = 2,
+    String = 3,
+    Array = 4,
+    Object = 5
+};
+
+// Read only JSON document tree. Accessors return a fallback (or a null value) on a
+// type mismatch or a missing key, so optional fields read in a single expression.
+class JsonValue
+{
+
+public:
+    JsonType GetType() const;
+    bool IsNull() const;
+    bool IsArray() const;
+    bool IsObject() const;
+
+    bool GetBool(bool fallback = false) const;
+    double GetNumber(double fallback = 0.0) const;
+    float GetFloat(float fallback = 0.0f) const;
+    // Negative or fractional numbers give the fallback.
+    uint32_t GetUint(uint32_t fallback = 0) const;
+    const std::string& GetString() const;
+
+    // Elements of an array or members of an object.
+    size_t GetSize() const;
+    const JsonValue& operator[](size_t index) const;
+
+    // Objects keep their member order, lookups are linear.
+    const JsonValue& operator[](std::string_view key) const;
+    bool Has(std::string_view key) const;
+    const std::vector<std::pair<std::string, JsonValue>>& GetMembers() const;
+
+private:
+    friend class JsonParser;
+
+    static const JsonValue& GetNull();
+
+    JsonType type_ = JsonType::Null;
+    bool bool_ = false;
+    double number_ = 0.0;
+    std::string string_;
+    std::vector<JsonValue> array_;
+    std::vector<std::pair<std::string, JsonValue>> members_;
+};
+
+// RFC 8259 JSON, \u escapes are converted to UTF-8. On failure 'error' gets the reason
+// and the byte offset.
+bool ParseJson(std::string_view text, JsonValue& value, std::string* error = nullptr);
+
+} // namespace Core
+
+#endif
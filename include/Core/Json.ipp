@@ -0,0 +1,94 @@
+#ifndef CORE_JSON_IPP
+#define CORE_JSON_IPP
+#pragma once
+
+#include <Core/Json.hpp>
+
+namespace Core
+{
+
+inline JsonType JsonValue::GetType() const
+{
+    return type_;
+}
+
+inline bool JsonValue::IsNull() const
+{
+    return type_ == JsonType::Null;
+}
+
+inline bool JsonValue::IsArray() const
+{
+    return type_ == JsonType::Array;
+}
+
+inline bool JsonValue::IsObject() const
+{
+    return type_ == JsonType::Object;
+}
+
+inline bool JsonValue::GetBool(bool fallback) const
+{
+    return (type_ == JsonType::Bool) ? bool_ : fallback;
+}
+
+inline double JsonValue::GetNumber(double fallback) const
+{
+    return (type_ == JsonType::Number) ? number_ : fallback;
+}
+
+inline float JsonValue::GetFloat(float fallback) const
+{
+    return (type_ == JsonType::Number) ? static_cast<float>(number_) : fallback;
+}
+
+inline uint32_t JsonValue::GetUint(uint32_t fallback) const
+{
+    if ((type_ != JsonType::Number) || (number_ < 0.0) || (number_ > 4294967295.0) ||
+        (number_ != static_cast<double>(static_cast<uint32_t>(number_))))
+    {
+        return fallback;
+    }
+    return static_cast<uint32_t>(number_);
+}
+
+inline const std::string& JsonValue::GetString() const
+{
+    return string_;
+}
+
+inline size_t JsonValue::GetSize() const
+{
+    return (type_ == JsonType::Array) ? array_.size() : members_.size();
+}
+
+inline const JsonValue& JsonValue::operator[](size_t index) const
+{
+    return (index < array_.size()) ? array_[index] : GetNull();
+}
+
+inline const JsonValue& JsonValue::operator[](std::string_view key) const
+{
+    for (const auto& member : members_)
+    {
+        if (member.first == key)
+        {
+            return member.second;
+        }
+    }
+    return GetNull();
+}
+
+inline bool JsonValue::Has(std::string_view key) const
+{
+    return !(*this)[key].IsNull();
+}
+
+inline const std::vector<std::pair<std::string, JsonValue>>& JsonValue::GetMembers() const
+{
+    return members_;
+}
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef CORE_KTX2READER_HPP
+#define CORE_KTX2READER_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <cstddef>
+#include <vector>
+
+namespace Core
+{
+
+constexpr uint8_t KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+struct Ktx2Level
+{
+    const uint8_t* data = nullptr; // Points into the container, not owned
+    size_t size = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+struct Ktx2Image
+{
+    uint32_t vkFormat = 0; // VkFormat value stored in the header
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<Ktx2Level> levels; // Level 0 is the full size
+};
+
+bool IsKtx2(const uint8_t* data, size_t size);
+
+// Reads the header and level index of a KTX2 container without copying any level data.
+// Only single layer, single face 2D textures without supercompression are accepted, with
+// no more levels than the full mip chain of their base extent.
+// Basis Universal payloads (vkFormat 0) are parsed, but no loader can transcode them yet.
+bool ParseKtx2(const uint8_t* data, size_t size, Ktx2Image& image);
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef CORE_KTX2READER_IPP
+#define CORE_KTX2READER_IPP
+#pragma once
+
+#include <Core/Ktx2Reader.hpp>
+
+// STD Lib
+#include <cstring>
+
+namespace Core
+{
+
+inline bool IsKtx2(const uint8_t* data, size_t size)
+{
+    return (size >= sizeof(KTX2_IDENTIFIER)) && (memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0);
+}
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef CORE_LZ4_HPP
+#define CORE_LZ4_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <cstddef>
+
+namespace Core
+{
+
+// LZ4 block format (no frame header or checksums), compatible with LZ4_compress_default
+// and LZ4_decompress_safe. Greedy matching over a 4K entry hash table, fast rather than
+// small: asset archives decompress it at load time.
+
+// Every extra length byte of a match adds at most 255 bytes, so no block expands more.
+constexpr uint64_t LZ4_MAX_EXPANSION = 255;
+
+// Largest compressed size of 'size' input bytes.
+size_t Lz4CompressBound(size_t size);
+
+// Returns the compressed size, 0 when 'dst' is too small or the input is over 4 GB.
+size_t Lz4Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+// Bounds checked against both buffers, fails unless exactly 'dstSize' bytes come out.
+bool Lz4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef CORE_LZ4_IPP
+#define CORE_LZ4_IPP
+#pragma once
+
+#include <Core/Lz4.hpp>
+
+namespace Core
+{
+
+inline size_t Lz4CompressBound(size_t size)
+{
+    return size + (size / 255) + 16;
+}
+
+} // namespace Core
+
+#endif
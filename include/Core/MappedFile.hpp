@@ -0,0 +1,46 @@
+#ifndef CORE_MAPPEDFILE_HPP
+#define CORE_MAPPEDFILE_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <cstddef>
+#include <string>
+
+namespace Core
+{
+
+// Read only mapping of a whole file. Pages are loaded by the OS on first access, data
+// can be handed to uploads or parsers without an intermediate copy.
+class MappedFile
+{
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Empty files fail to map.
+    bool Open(const std::string& filePath);
+    void Close();
+
+    bool IsOpen() const;
+    const uint8_t* GetData() const;
+    size_t GetSize() const;
+
+    // Asks the OS to read the range ahead, so the first access doesn't stall on it.
+    void Prefetch(size_t offset, size_t size) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef CORE_MAPPEDFILE_IPP
+#define CORE_MAPPEDFILE_IPP
+#pragma once
+
+#include <Core/MappedFile.hpp>
+
+namespace Core
+{
+
+inline bool MappedFile::IsOpen() const
+{
+    return data_ != nullptr;
+}
+
+inline const uint8_t* MappedFile::GetData() const
+{
+    return data_;
+}
+
+inline size_t MappedFile::GetSize() const
+{
+    return size_;
+}
+
+} // namespace Core
+
+#endif
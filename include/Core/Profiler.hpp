@@ -0,0 +1,134 @@
+#ifndef CORE_PROFILER_HPP
+#define CORE_PROFILER_HPP
+#pragma once
+
+#include <Global.hpp>
+#include <Settings.hpp>
+
+// STD Lib
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scope names must be string literals, only the pointer is recorded.
+#if ENABLE_CPU_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ::Core::ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_THREAD_NAME(name) ::Core::Profiler::Get().SetThreadName(name)
+#define PROFILE_COLLECT() ::Core::Profiler::Get().Collect()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#define PROFILE_COLLECT() ((void)0)
+#endif
+
+namespace Core
+{
+
+struct ProfileEvent
+{
+    const char* name;
+    uint64_t startNs;
+    uint64_t endNs;
+};
+
+//----------------------------------------------------------------------------//
+
+// Single producer (the owning thread), single consumer (Profiler::Collect) ring.
+// Events are dropped instead of overwritten when the consumer falls behind.
+class ProfileEventRing
+{
+
+public:
+    ProfileEventRing(uint32_t threadId);
+
+    bool Push(const ProfileEvent& event);
+
+    template <typename Func>
+    void Drain(Func&& func);
+
+    uint32_t GetThreadId() const;
+    uint64_t GetDroppedCount() const;
+
+private:
+    std::array<ProfileEvent, CPU_PROFILER_RING_SIZE> events_;
+    std::atomic<uint64_t> head_{0}; // Next write, owned by the producer
+    std::atomic<uint64_t> tail_{0}; // Next read, owned by the consumer
+    std::atomic<uint64_t> dropped_{0};
+    uint32_t threadId_;
+};
+
+//----------------------------------------------------------------------------//
+
+class Profiler
+{
+
+public:
+    static Profiler& Get();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // Nanoseconds since the profiler was created.
+    uint64_t NowNs() const;
+
+    void Record(const char* name, uint64_t startNs, uint64_t endNs);
+    void SetThreadName(const char* name);
+
+    // Moves the events of every thread into the capture history, call once per frame
+    // so the rings don't fill up. The oldest events are dropped past CPU_PROFILER_HISTORY.
+    void Collect();
+
+    // Writes the capture history as Chrome trace JSON (chrome://tracing, Perfetto).
+    bool DumpChromeTrace(const std::string& filePath);
+
+private:
+    Profiler();
+
+    struct CapturedEvent
+    {
+        ProfileEvent event;
+        uint32_t threadId;
+    };
+
+    ProfileEventRing* GetThreadRing();
+    ProfileEventRing* RegisterThread();
+
+//----------------------------------------------------------------------------//
+
+    std::chrono::steady_clock::time_point epoch_;
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<ProfileEventRing>> rings_;
+    std::vector<std::string> threadNames_; // Indexed by thread id
+    std::deque<CapturedEvent> history_;
+};
+
+//----------------------------------------------------------------------------//
+
+class ProfileScope
+{
+
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    uint64_t startNs_;
+};
+
+} // namespace Core
+
+#endif
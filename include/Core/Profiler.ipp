@@ -0,0 +1,95 @@
+#ifndef CORE_PROFILER_IPP
+#define CORE_PROFILER_IPP
+#pragma once
+
+#include <Core/Profiler.hpp>
+
+namespace Core
+{
+
+inline bool ProfileEventRing::Push(const ProfileEvent& event)
+{
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+
+    if ((head - tail) >= CPU_PROFILER_RING_SIZE)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    events_[head % CPU_PROFILER_RING_SIZE] = event;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename Func>
+void ProfileEventRing::Drain(Func&& func)
+{
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+
+    for (uint64_t i = tail; i < head; ++i)
+    {
+        func(events_[i % CPU_PROFILER_RING_SIZE]);
+    }
+
+    tail_.store(head, std::memory_order_release);
+}
+
+inline uint32_t ProfileEventRing::GetThreadId() const
+{
+    return threadId_;
+}
+
+inline uint64_t ProfileEventRing::GetDroppedCount() const
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------//
+
+inline Profiler& Profiler::Get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+inline uint64_t Profiler::NowNs() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch_).count());
+}
+
+inline void Profiler::Record(const char* name, uint64_t startNs, uint64_t endNs)
+{
+    GetThreadRing()->Push({name, startNs, endNs});
+}
+
+inline ProfileEventRing* Profiler::GetThreadRing()
+{
+    // Registered once per thread, the ring lives as long as the profiler.
+    thread_local ProfileEventRing* ring = nullptr;
+    if (ring == nullptr)
+    {
+        ring = RegisterThread();
+    }
+    return ring;
+}
+
+//----------------------------------------------------------------------------//
+
+inline ProfileScope::ProfileScope(const char* name)
+    : name_(name), startNs_(Profiler::Get().NowNs())
+{
+}
+
+inline ProfileScope::~ProfileScope()
+{
+    Profiler& profiler = Profiler::Get();
+    profiler.Record(name_, startNs_, profiler.NowNs());
+}
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef CORE_THREADPOOL_HPP
+#define CORE_THREADPOOL_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// STD Lib
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Core
+{
+
+class ThreadPool
+{
+
+public:
+    // A thread count of 0 picks one worker per hardware thread minus the main thread.
+    explicit ThreadPool(uint32_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Enqueue(std::function<void()> job);
+
+    template <typename Func>
+    std::future<std::invoke_result_t<Func>> Submit(Func&& func);
+
+    // Block until every queued and running job has finished.
+    void WaitIdle();
+
+    uint32_t GetThreadCount() const;
+
+private:
+    void WorkerLoop();
+
+//----------------------------------------------------------------------------//
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> jobs_;
+
+    std::mutex mutex_;
+    std::condition_variable jobCondition_;
+    std::condition_variable idleCondition_;
+    uint32_t activeJobs_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef CORE_THREADPOOL_IPP
+#define CORE_THREADPOOL_IPP
+#pragma once
+
+#include <Core/ThreadPool.hpp>
+
+// STD Lib
+#include <memory>
+
+namespace Core
+{
+
+template <typename Func>
+std::future<std::invoke_result_t<Func>> ThreadPool::Submit(Func&& func)
+{
+    using ResultType = std::invoke_result_t<Func>;
+
+    // packaged_task is move only, std::function needs a copyable target.
+    auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Func>(func));
+    std::future<ResultType> result = task->get_future();
+
+    Enqueue([task]() { (*task)(); });
+    return result;
+}
+
+inline uint32_t ThreadPool::GetThreadCount() const
+{
+    return static_cast<uint32_t>(workers_.size());
+}
+
+} // namespace Core
+
+#endif
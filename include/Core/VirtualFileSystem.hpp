@@ -0,0 +1,64 @@
+#ifndef CORE_VIRTUALFILESYSTEM_HPP
+#define CORE_VIRTUALFILESYSTEM_HPP
+#pragma once
+
+#include <Core/AssetArchive.hpp>
+#include <Global.hpp>
+
+// STD Lib
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core
+{
+
+// Read only asset lookup over mounted archives, with loose files as the fallback.
+// Paths are relative to the asset root ("Assets/..." or "/Assets/..."), the last
+// mounted archive wins. Lookups are O(log n) in the archive index, no file system calls
+// once an archive serves the path.
+class VirtualFileSystem
+{
+
+public:
+    static VirtualFileSystem& Get();
+
+    VirtualFileSystem(const VirtualFileSystem&) = delete;
+    VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+
+    bool Mount(const std::string& archivePath);
+    void UnmountAll();
+
+    // Directory loose files are read from, empty -> working directory.
+    void SetLooseRoot(const std::string& directory);
+
+    bool Exists(std::string_view path) const;
+
+    // Archives first, then the loose file.
+    bool ReadFile(std::string_view path, std::vector<char>& data) const;
+
+    // Zero-copy view of an uncompressed archive entry, valid until UnmountAll. False for
+    // compressed entries and loose files, use ReadFile for those.
+    bool GetMappedData(std::string_view path, const uint8_t*& data, size_t& size) const;
+
+private:
+    VirtualFileSystem() = default;
+
+    // Must hold mutex_.
+    const AssetArchiveEntry* FindEntry(std::string_view path, const AssetArchive*& archive) const;
+    std::string GetLoosePath(std::string_view path) const;
+
+    mutable std::shared_mutex mutex_;
+    std::vector<std::unique_ptr<AssetArchive>> archives_; // Mount order
+    std::string looseRoot_;
+};
+
+// Directory of the running executable, resolved from the OS rather than argv[0] (which
+// has no directory when started through PATH). Empty when it can't be resolved.
+std::string GetExecutableDirectory();
+
+} // namespace Core
+
+#endif
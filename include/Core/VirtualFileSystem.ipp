@@ -0,0 +1,19 @@
+#ifndef CORE_VIRTUALFILESYSTEM_IPP
+#define CORE_VIRTUALFILESYSTEM_IPP
+#pragma once
+
+#include <Core/VirtualFileSystem.hpp>
+#include <Core/AssetArchive.ipp>
+
+namespace Core
+{
+
+inline VirtualFileSystem& VirtualFileSystem::Get()
+{
+    static VirtualFileSystem fileSystem;
+    return fileSystem;
+}
+
+} // namespace Core
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef GRAPHICS_CAMERA_HPP
+#define GRAPHICS_CAMERA_HPP
+#pragma once
+
+// External Lib
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace Graphic
+{
+
+// View and projection of the scene, uploaded once per frame through the global UBO.
+// Vulkan conventions: y points down and depth goes from 0 (near) to 1 (far).
+class Camera
+{
+
+public:
+    void SetOrthographicProjection(float left, float right, float top, float bottom, float near, float far);
+    void SetPerspectiveProjection(float fovy, float aspect, float near, float far);
+
+    void SetViewDirection(glm::vec3 position, glm::vec3 direction, glm::vec3 up = glm::vec3{0.0f, -1.0f, 0.0f});
+    void SetViewTarget(glm::vec3 position, glm::vec3 target, glm::vec3 up = glm::vec3{0.0f, -1.0f, 0.0f});
+
+    // Rotation applied in Y, X, Z order (Tait-Bryan angles).
+    void SetViewYXZ(glm::vec3 position, glm::vec3 rotation);
+
+    // 2D view centered on 'center'. At zoom 1 the visible height spans [-1, 1], the
+    // width follows the aspect ratio (width / height).
+    void Set2DView(glm::vec2 center, float zoom, float aspect);
+
+    const glm::mat4& GetProjection() const;
+    const glm::mat4& GetView() const;
+    glm::mat4 GetViewProjection() const;
+
+private:
+
+    glm::mat4 projection_{1.0f};
+    glm::mat4 view_{1.0f};
+};
+
+} // namespace Graphic
+
+#endif
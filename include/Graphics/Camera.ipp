@@ -0,0 +1,27 @@
+#ifndef GRAPHICS_CAMERA_IPP
+#define GRAPHICS_CAMERA_IPP
+#pragma once
+
+#include <Graphics/Camera.hpp>
+
+namespace Graphic
+{
+
+inline const glm::mat4& Camera::GetProjection() const
+{
+    return projection_;
+}
+
+inline const glm::mat4& Camera::GetView() const
+{
+    return view_;
+}
+
+inline glm::mat4 Camera::GetViewProjection() const
+{
+    return projection_ * view_;
+}
+
+} // namespace Graphic
+
+#endif
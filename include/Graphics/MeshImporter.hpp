@@ -0,0 +1,113 @@
+#ifndef GRAPHICS_MESHIMPORTER_HPP
+#define GRAPHICS_MESHIMPORTER_HPP
+#pragma once
+
+#include <Graphics/VkModel.hpp>
+#include <Core/MappedFile.hpp>
+#include <Core/ThreadPool.hpp>
+#include <Settings.hpp>
+
+// STD Lib
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forward declarations
+namespace Core { class JsonValue; }
+
+namespace Graphic
+{
+
+// Indexed triangle list, ready for VkModel.
+struct MeshData
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+// Imports glTF 2.0 (.gltf + .bin, .glb) and Wavefront OBJ files into a single mesh:
+// - files are memory mapped, accessors are read in place through their buffer views
+//   without copying the buffers first
+// - output sizes are known up front, vertices and indices are converted straight into
+//   the final arrays in MESH_IMPORT_CHUNK_SIZE tasks. OBJ files are split at line
+//   boundaries and parsed in MESH_IMPORT_OBJ_CHUNK_BYTES tasks
+// - glTF node transforms are applied, colors come from COLOR_0, the material base
+//   color or white. Vertices are 2D, z is dropped after the transform
+// Triangle primitives only, data URIs and sparse accessors aren't supported.
+class MeshImporter
+{
+
+public:
+    explicit MeshImporter(uint32_t threadCount = MESH_IMPORT_THREADS);
+
+    MeshImporter(const MeshImporter&) = delete;
+    MeshImporter& operator=(const MeshImporter&) = delete;
+
+    // Format picked from the extension. 'mesh' is left empty on failure.
+    bool Import(const std::string& filePath, MeshData& mesh);
+
+    // Import + indexed VkModel, null on failure. The upload is asynchronous, see
+    // VkModel::IsReady. Cooked meshes (.gmesh, see MeshCooker) skip the import: their
+    // blobs are copied from the mapped file as they are, with their LOD table.
+    std::shared_ptr<VkModel> LoadModel(VkDeviceInstance* deviceInst, const std::string& filePath);
+
+private:
+    // Buffer view target of an accessor, strided over the mapped file.
+    struct AccessorView
+    {
+        const uint8_t* data = nullptr;
+        size_t count = 0;
+        size_t stride = 0;
+        uint32_t componentType = 0;
+        uint32_t componentCount = 0;
+        bool normalized = false;
+    };
+
+    // One primitive of one node, written at vertexBase/indexBase.
+    struct PrimitiveJob
+    {
+        AccessorView positions;
+        AccessorView colors;     // Empty -> baseColor
+        AccessorView indices;    // Empty -> sequential
+        glm::mat4 transform{1.0f};
+        glm::vec3 baseColor{1.0f};
+        size_t vertexBase = 0;
+        size_t indexBase = 0;
+        size_t indexCount = 0;
+    };
+
+    struct GltfDocument;
+
+    bool ImportGltf(const std::string& filePath, MeshData& mesh);
+    bool ImportObj(const std::string& filePath, MeshData& mesh);
+
+    bool LoadGltfBuffers(const std::string& filePath, GltfDocument& document) const;
+    bool ResolveAccessor(const GltfDocument& document, uint32_t accessorIndex, AccessorView& view) const;
+    // Fails on nodes reached twice (shared or cyclic) and past GLTF_MAX_MESH_INSTANCES.
+    bool CollectNodes(
+        const GltfDocument& document,
+        uint32_t nodeIndex,
+        const glm::mat4& parentTransform,
+        uint32_t depth,
+        std::vector<bool>& visitedNodes,
+        std::vector<std::pair<uint32_t, glm::mat4>>& meshInstances) const;
+    // Appends after the last job, skips non triangle primitives.
+    bool AddPrimitive(
+        const GltfDocument& document,
+        const Core::JsonValue& primitive,
+        const glm::mat4& transform,
+        std::vector<PrimitiveJob>& jobs) const;
+
+    // Runs task(0..taskCount-1) on the pool and the calling thread, returns once all
+    // are done.
+    void RunParallel(size_t taskCount, const std::function<void(size_t)>& task);
+
+//----------------------------------------------------------------------------//
+
+    Core::ThreadPool threadPool_;
+};
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef GRAPHICS_MESHIMPORTER_IPP
+#define GRAPHICS_MESHIMPORTER_IPP
+#pragma once
+
+#include <Graphics/MeshImporter.hpp>
+#include <Graphics/VkModel.ipp>
+
+#endif
@@ -4,6 +4,10 @@
 
 #include <Graphics/GameObject.hpp>
 #include <Graphics/Vulkan/VkPipelineImpl.hpp>
+#include <Graphics/Vulkan/VkPipelineBuilderImpl.hpp>
+#include <Graphics/Vulkan/VkPipelineVariantImpl.hpp>
+#include <Graphics/Vulkan/VkGpuProfilerImpl.hpp>
+#include <Graphics/Vulkan/VkGlobalUboImpl.hpp>
 
 // Effects
 #include <Graphics/Pipeline/RainbowSystem.hpp>
@@ -23,26 +27,52 @@ class SimpleRenderPipeline
 
 public:
 
-    SimpleRenderPipeline(VkDeviceInstance* deviceInst, VkRenderPass renderPass);
+    // When a builder is given the pipelines are compiled asynchronously and draws are
+    // skipped (or served by the fallback pipeline) until they are ready. The global
+    // uniforms are bound at set 0 for every draw batch.
+    SimpleRenderPipeline(
+        VkDeviceInstance* deviceInst,
+        GlobalUniformBuffer* globalUniforms,
+        const RenderTargetInfo& renderTarget,
+        AsyncPipelineBuilder* pipelineBuilder = nullptr);
     ~SimpleRenderPipeline();
 
     SimpleRenderPipeline(const SimpleRenderPipeline&) = delete;
     SimpleRenderPipeline &operator=(const SimpleRenderPipeline&) = delete;
 
-    void RenderGameObjects(VkCommandBuffer commandBuffer, std::vector<GameObject>& gameObjects);
+    void RenderGameObjects(
+        VkCommandBuffer commandBuffer,
+        std::vector<GameObject>& gameObjects,
+        const ShaderPermutation& permutation = {},
+        const char* profileName = "SimpleRender");
+
+    // Draw calls are wrapped in a GPU scope when a profiler is set.
+    void SetProfiler(GpuProfiler* profiler);
+
+    bool IsPipelineReady(const ShaderPermutation& permutation = {});
+
+    // Must be created against a layout compatible with SimplePushConstants and the
+    // global set.
+    void SetFallbackPipeline(GraphicPipeline* fallback);
+
+    // Starts compiling the permutation if needed, nullptr until it is ready.
+    GraphicPipeline* GetPipeline(const ShaderPermutation& permutation = {});
 
 private:
 
     void CreatePipelineLayout();
 
-    void CreatePipeline(VkRenderPass renderPass);
+    void CreatePipeline(const RenderTargetInfo& renderTarget, AsyncPipelineBuilder* pipelineBuilder);
 
     VkDeviceInstance* deviceInst_;
+    GlobalUniformBuffer* globalUniforms_;
 
     RainbowSystem rainbow_{1.0f};
     
     VkPipelineLayout pipelineLayout_ = VK_NULL_HANDLE;
-    std::unique_ptr<GraphicPipeline> pipeline_;
+    std::unique_ptr<PipelineVariantCache> variants_;
+    GraphicPipeline* fallbackPipeline_ = nullptr;
+    GpuProfiler* profiler_ = nullptr;
 };
 
 } // namespace Graphic
@@ -3,5 +3,33 @@
 #pragma once
 
 #include <Graphics/Pipeline/SimpleRenderPipeline.hpp>
+#include <Graphics/Vulkan/VkPipelineBuilderImpl.ipp>
+#include <Graphics/Vulkan/VkPipelineVariantImpl.ipp>
+#include <Graphics/Vulkan/VkGpuProfilerImpl.ipp>
+
+namespace Graphic
+{
+
+inline bool SimpleRenderPipeline::IsPipelineReady(const ShaderPermutation& permutation)
+{
+    return (GetPipeline(permutation) != nullptr);
+}
+
+inline void SimpleRenderPipeline::SetFallbackPipeline(GraphicPipeline* fallback)
+{
+    fallbackPipeline_ = fallback;
+}
+
+inline void SimpleRenderPipeline::SetProfiler(GpuProfiler* profiler)
+{
+    profiler_ = profiler;
+}
+
+inline GraphicPipeline* SimpleRenderPipeline::GetPipeline(const ShaderPermutation& permutation)
+{
+    return variants_->GetOrCreate(permutation).Get();
+}
+
+} // namespace Graphic
 
 #endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef GRAPHICS_PIPELINE_SPRITERENDERPIPELINE_HPP
+#define GRAPHICS_PIPELINE_SPRITERENDERPIPELINE_HPP
+#pragma once
+
+#include <Graphics/GameObject.hpp>
+#include <Graphics/TextureManager.hpp>
+#include <Graphics/Vulkan/VkPipelineImpl.hpp>
+#include <Graphics/Vulkan/VkGpuProfilerImpl.hpp>
+#include <Graphics/Vulkan/VkGlobalUboImpl.hpp>
+
+// STD Lib
+#include <memory>
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+// Alpha blended, textured quads drawn over the scene. Models are expected to span
+// [-0.5, 0.5] (the UVs are derived from the position), the object color tints the
+// texture. Set 0 is the global uniforms, set 1 the texture (TextureManager).
+class SpriteRenderPipeline
+{
+
+public:
+    SpriteRenderPipeline(
+        VkDeviceInstance* deviceInst,
+        GlobalUniformBuffer* globalUniforms,
+        TextureManager* textureManager,
+        const RenderTargetInfo& renderTarget);
+    ~SpriteRenderPipeline();
+
+    SpriteRenderPipeline(const SpriteRenderPipeline&) = delete;
+    SpriteRenderPipeline& operator=(const SpriteRenderPipeline&) = delete;
+
+    // False when the sprite shaders are missing.
+    bool IsReady() const;
+
+    // Every sprite of the batch samples 'texture', the 1x1 white fallback until its first
+    // level is resident.
+    void RenderSprites(
+        VkCommandBuffer commandBuffer,
+        std::vector<GameObject>& sprites,
+        TextureHandle texture,
+        const char* profileName = "Sprites");
+
+    void SetProfiler(GpuProfiler* profiler);
+
+private:
+    void CreatePipelineLayout();
+    void CreatePipeline(const RenderTargetInfo& renderTarget);
+
+    VkDeviceInstance* deviceInst_ = nullptr;
+    GlobalUniformBuffer* globalUniforms_ = nullptr;
+    TextureManager* textureManager_ = nullptr;
+    GpuProfiler* profiler_ = nullptr;
+
+    VkPipelineLayout pipelineLayout_ = VK_NULL_HANDLE;
+    std::unique_ptr<GraphicPipeline> pipeline_;
+};
+
+} // namespace Graphic
+
+#endif
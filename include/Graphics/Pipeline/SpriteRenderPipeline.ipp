@@ -0,0 +1,24 @@
+#ifndef GRAPHICS_PIPELINE_SPRITERENDERPIPELINE_IPP
+#define GRAPHICS_PIPELINE_SPRITERENDERPIPELINE_IPP
+#pragma once
+
+#include <Graphics/Pipeline/SpriteRenderPipeline.hpp>
+#include <Graphics/Vulkan/VkPipelineImpl.ipp>
+#include <Graphics/Vulkan/VkGpuProfilerImpl.ipp>
+
+namespace Graphic
+{
+
+inline bool SpriteRenderPipeline::IsReady() const
+{
+    return pipeline_->IsValid();
+}
+
+inline void SpriteRenderPipeline::SetProfiler(GpuProfiler* profiler)
+{
+    profiler_ = profiler;
+}
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef GRAPHICS_PIPELINE_VECTORFIELDPIPELINE_HPP
+#define GRAPHICS_PIPELINE_VECTORFIELDPIPELINE_HPP
+#pragma once
+
+#include <Graphics/GameObject.hpp>
+#include <Graphics/Vulkan/VkPipelineImpl.hpp>
+#include <Graphics/Vulkan/VkGpuProfilerImpl.hpp>
+#include <Graphics/Vulkan/VkGlobalUboImpl.hpp>
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <array>
+#include <memory>
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+// Gravity field lines over a gridCount x gridCount grid covering [-1, 1]. A compute
+// shader evaluates the field of the physics bodies into a per frame slot instance
+// buffer (recorded through Renderer::BeginCompute, so it runs on the async compute
+// queue), the lines are then drawn as a single instanced draw reading that buffer.
+//
+// Set 0 of the compute layout and set 1 of the graphics layout is the instance buffer,
+// set 0 of the graphics layout the global uniforms.
+class VectorFieldPipeline
+{
+
+public:
+    VectorFieldPipeline(
+        VkDeviceInstance* deviceInst,
+        GlobalUniformBuffer* globalUniforms,
+        const RenderTargetInfo& renderTarget,
+        uint32_t gridCount);
+    ~VectorFieldPipeline();
+
+    VectorFieldPipeline(const VectorFieldPipeline&) = delete;
+    VectorFieldPipeline& operator=(const VectorFieldPipeline&) = delete;
+
+    // False when a shader is missing, the field has to be evaluated on the CPU then.
+    bool IsReady() const;
+
+    // Records the field evaluation of the frame using 'frameSlot' into a compute command
+    // buffer. Only the first VECTOR_FIELD_MAX_BODIES bodies contribute.
+    void Dispatch(
+        VkCommandBuffer commandBuffer,
+        size_t frameSlot,
+        const std::vector<GameObject>& bodies,
+        float strength);
+
+    // Draws the lines written by the last Dispatch with 'model', inside the frame's pass.
+    void Render(VkCommandBuffer commandBuffer, VkModel& model, const glm::vec3& color);
+
+    void SetProfiler(GpuProfiler* profiler);
+
+private:
+    void CreateDescriptors();
+    void CreateInstanceBuffers();
+    void CreatePipelineLayouts();
+
+    VkDeviceInstance* deviceInst_ = nullptr;
+    GlobalUniformBuffer* globalUniforms_ = nullptr;
+    GpuProfiler* profiler_ = nullptr;
+    uint32_t gridCount_ = 0;
+
+    // One per possible frame slot, so changing the frames in flight needs no reallocation
+    std::array<VkBuffer, MAX_FRAMES_IN_FLIGHT> instanceBuffers_ = {};
+    std::array<VkDeviceMemory, MAX_FRAMES_IN_FLIGHT> instanceMemory_ = {};
+    std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> instanceSets_ = {};
+    size_t lastSlot_ = SIZE_MAX; // Written by the last Dispatch
+
+    VkDescriptorSetLayout instanceSetLayout_ = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool_ = VK_NULL_HANDLE;
+
+    VkPipelineLayout computeLayout_ = VK_NULL_HANDLE;
+    VkPipelineLayout graphicsLayout_ = VK_NULL_HANDLE;
+    std::unique_ptr<ComputePipeline> computePipeline_;
+    std::unique_ptr<GraphicPipeline> graphicsPipeline_;
+};
+
+} // namespace Graphic
+
+#endif
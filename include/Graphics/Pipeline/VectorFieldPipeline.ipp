@@ -0,0 +1,24 @@
+#ifndef GRAPHICS_PIPELINE_VECTORFIELDPIPELINE_IPP
+#define GRAPHICS_PIPELINE_VECTORFIELDPIPELINE_IPP
+#pragma once
+
+#include <Graphics/Pipeline/VectorFieldPipeline.hpp>
+#include <Graphics/Vulkan/VkPipelineImpl.ipp>
+#include <Graphics/Vulkan/VkGpuProfilerImpl.ipp>
+
+namespace Graphic
+{
+
+inline bool VectorFieldPipeline::IsReady() const
+{
+    return graphicsPipeline_->IsValid() && computePipeline_->IsValid();
+}
+
+inline void VectorFieldPipeline::SetProfiler(GpuProfiler* profiler)
+{
+    profiler_ = profiler;
+}
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef GRAPHICS_RENDERGRAPH_HPP
+#define GRAPHICS_RENDERGRAPH_HPP
+#pragma once
+
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <functional>
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+namespace Graphic { class Renderer; }
+namespace Graphic { class RenderGraph; }
+
+namespace Graphic
+{
+
+enum class RGPassType
+{
+    Raster = 0,   // Attachments are begun/ended by the graph
+    Compute = 1,
+    Transfer = 2
+};
+
+// How a pass uses a resource, decides the image layout and the barrier scopes.
+enum class RGAccess
+{
+    ColorAttachment = 0, // write
+    DepthAttachment = 1, // write (depth test reads as well)
+    SampledRead = 2,
+    StorageRead = 3,
+    StorageWrite = 4,    // write
+    TransferSrc = 5,
+    TransferDst = 6      // write
+};
+
+struct RGResource
+{
+    uint32_t id = UINT32_MAX;
+    bool IsValid() const { return id != UINT32_MAX; }
+};
+
+// Transient image, only alive between its first and last use within a frame.
+struct RGImageDesc
+{
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent = {0, 0}; // {0, 0} -> swapchain extent
+    VkClearValue clearValue = {}; // Used by the first attachment write of the frame
+};
+
+// Declares what a pass reads and writes, returned by RenderGraph::AddPass.
+class RenderGraphBuilder
+{
+
+public:
+    RGResource CreateImage(const char* name, const RGImageDesc& desc);
+    RenderGraphBuilder& Read(RGResource resource, RGAccess access);
+    RenderGraphBuilder& Write(RGResource resource, RGAccess access);
+
+    // Never culled, for passes whose results leave the graph (readbacks, host writes).
+    RenderGraphBuilder& SetSideEffect();
+
+private:
+    friend class RenderGraph;
+    RenderGraphBuilder(RenderGraph* graph, uint32_t passIdx) : graph_(graph), passIdx_(passIdx) {}
+
+    RenderGraph* graph_ = nullptr;
+    uint32_t passIdx_ = 0;
+};
+
+// Frame graph rebuilt every frame on top of the Renderer frame command buffer:
+// - passes that contribute to no side effect (the backbuffer included) are culled
+// - image layouts and barriers are derived from the declared accesses, one
+//   vkCmdPipelineBarrier2 per pass at most
+// - every pass records into the frame command buffer, a single submit per frame
+// - transient images whose lifetimes don't overlap share memory. They are allocated
+//   per frame slot and only reallocated when the set of images or lifetimes changes.
+//
+// A raster pass writing the backbuffer is begun with Renderer::BeginSwapChainRenderPass
+// (swapchain depth included) and can't have other attachments. Raster passes on
+// transient images need dynamic rendering.
+class RenderGraph
+{
+
+public:
+    // Gets the recorded command buffer and the graph while executing.
+    using ExecuteFn = std::function<void(VkCommandBuffer, const RenderGraph&)>;
+
+    RenderGraph(VkDeviceInstance* deviceInst, Renderer* renderer);
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // Drops the passes and resources of the last frame, physical images are kept.
+    void Reset();
+
+    // Swapchain image of the current frame.
+    RGResource GetBackbuffer() const;
+
+    // 'name' must outlive the frame results (the GPU profiler reads it back later),
+    // pass string literals.
+    RenderGraphBuilder AddPass(const char* name, RGPassType type, ExecuteFn execute);
+
+    // Compiles and records the graph, between Renderer::BeginFrame and EndFrame.
+    void Execute(VkCommandBuffer commandBuffer);
+
+    // Valid while executing.
+    VkImage GetImage(RGResource resource) const;
+    VkImageView GetImageView(RGResource resource) const;
+    VkExtent2D GetExtent(RGResource resource) const;
+    VkFormat GetFormat(RGResource resource) const;
+
+    // Last realized slot, with and without aliasing.
+    VkDeviceSize GetTransientMemorySize() const;
+    VkDeviceSize GetUnaliasedMemorySize() const;
+
+private:
+    friend class RenderGraphBuilder;
+
+    struct ResourceNode
+    {
+        const char* name = nullptr;
+        RGImageDesc desc = {};
+        bool imported = false; // Backbuffer, owned and synchronized by the Renderer
+        VkImageUsageFlags usage = 0;
+        uint32_t refCount = 0; // Passes reading it
+        uint32_t firstPass = UINT32_MAX; // Executed pass range using it
+        uint32_t lastPass = 0;
+        uint32_t physicalIdx = UINT32_MAX;
+    };
+
+    struct PassAccess
+    {
+        uint32_t resource = 0;
+        RGAccess access = RGAccess::SampledRead;
+        bool write = false;
+    };
+
+    struct PassNode
+    {
+        const char* name = nullptr;
+        RGPassType type = RGPassType::Raster;
+        ExecuteFn execute;
+        std::vector<PassAccess> accesses;
+        bool sideEffect = false;
+        bool swapchainPass = false;
+        uint32_t refCount = 0; // Resources written
+        bool culled = false;
+    };
+
+    // Everything that decides the physical images, compared to skip reallocations.
+    struct ImageKey
+    {
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkExtent2D extent = {0, 0};
+        VkImageUsageFlags usage = 0;
+        uint32_t firstPass = 0;
+        uint32_t lastPass = 0;
+
+        bool operator==(const ImageKey& other) const;
+    };
+
+    struct PhysicalImage
+    {
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkImageAspectFlags aspect = 0;
+        uint32_t block = 0;
+    };
+
+    struct MemoryBlock
+    {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        uint32_t typeBits = 0; // Memory types every image placed in it accepts
+    };
+
+    // Physical images of one frame slot, the slot's previous frame is done with them
+    // by the time the graph executes again.
+    struct FrameResources
+    {
+        std::vector<ImageKey> keys;
+        std::vector<PhysicalImage> images;
+        std::vector<MemoryBlock> blocks;
+        VkDeviceSize aliasedSize = 0;
+        VkDeviceSize unaliasedSize = 0;
+    };
+
+    // Tracked per resource and per memory block while recording.
+    struct SyncState
+    {
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags2 writeStage = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+        VkPipelineStageFlags2 readStage = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 readAccess = VK_ACCESS_2_NONE;
+    };
+
+    void Compile();
+    void CullPasses();
+    void ComputeLifetimes();
+    void RealizeResources(FrameResources& frame);
+    void DestroyResources(FrameResources& frame);
+
+    void RecordBarriers(VkCommandBuffer commandBuffer, const PassNode& pass);
+    void FlushBarriers(VkCommandBuffer commandBuffer, const std::vector<VkImageMemoryBarrier2>& barriers);
+    void BeginRendering(VkCommandBuffer commandBuffer, const PassNode& pass, uint32_t passIdx);
+
+    VkExtent2D ResolveExtent(const RGImageDesc& desc) const;
+
+    VkDeviceInstance* deviceInst_ = nullptr;
+    Renderer* renderer_ = nullptr;
+
+    std::vector<ResourceNode> resources_;
+    std::vector<PassNode> passes_;
+    std::vector<uint32_t> executionOrder_; // Indices of the passes left after culling
+
+    std::vector<FrameResources> frames_; // One per frame in flight
+    FrameResources* currentFrame_ = nullptr;
+    std::vector<SyncState> resourceState_;
+    std::vector<SyncState> blockState_;
+
+    bool loggedDynamicRendering_ = false;
+};
+
+} // namespace Graphic
+
+#endif
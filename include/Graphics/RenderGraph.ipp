@@ -0,0 +1,61 @@
+#ifndef GRAPHICS_RENDERGRAPH_IPP
+#define GRAPHICS_RENDERGRAPH_IPP
+#pragma once
+
+#include <Graphics/RenderGraph.hpp>
+
+// STD Lib
+#include <cassert>
+
+namespace Graphic
+{
+
+inline RGResource RenderGraph::GetBackbuffer() const
+{
+    // Always the first resource, added by Reset().
+    return RGResource{0};
+}
+
+inline VkImage RenderGraph::GetImage(RGResource resource) const
+{
+    assert((currentFrame_ != nullptr) && !resources_[resource.id].imported && "Render Graph: Not a transient image");
+    return currentFrame_->images[resources_[resource.id].physicalIdx].image;
+}
+
+inline VkImageView RenderGraph::GetImageView(RGResource resource) const
+{
+    assert((currentFrame_ != nullptr) && !resources_[resource.id].imported && "Render Graph: Not a transient image");
+    return currentFrame_->images[resources_[resource.id].physicalIdx].view;
+}
+
+inline VkExtent2D RenderGraph::GetExtent(RGResource resource) const
+{
+    return ResolveExtent(resources_[resource.id].desc);
+}
+
+inline VkFormat RenderGraph::GetFormat(RGResource resource) const
+{
+    return resources_[resource.id].desc.format;
+}
+
+inline VkDeviceSize RenderGraph::GetTransientMemorySize() const
+{
+    return (currentFrame_ != nullptr) ? currentFrame_->aliasedSize : 0;
+}
+
+inline VkDeviceSize RenderGraph::GetUnaliasedMemorySize() const
+{
+    return (currentFrame_ != nullptr) ? currentFrame_->unaliasedSize : 0;
+}
+
+inline bool RenderGraph::ImageKey::operator==(const ImageKey& other) const
+{
+    return (format == other.format) &&
+           (extent.width == other.extent.width) && (extent.height == other.extent.height) &&
+           (usage == other.usage) &&
+           (firstPass == other.firstPass) && (lastPass == other.lastPass);
+}
+
+} // namespace Graphic
+
+#endif
@@ -3,12 +3,20 @@
 #pragma once
 
 #include <Graphics/Vulkan/VkSwapChainImpl.ipp>
+#include <Graphics/Vulkan/VkPipelineImpl.hpp>
+#include <Graphics/Vulkan/VkPresentTimingImpl.hpp>
+#include <Graphics/Vulkan/VkGpuProfilerImpl.hpp>
+#include <Graphics/Vulkan/VkFrameCaptureImpl.hpp>
+#include <Graphics/Vulkan/VkGlobalUboImpl.hpp>
+#include <Graphics/Camera.hpp>
+#include <Core/DeferredDeletionQueue.hpp>
 
 // External Lib
 #include <vulkan/vulkan.h>
 
 // STD Lib
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -23,7 +31,11 @@ class Renderer
 
 public:
 
-    Renderer(WindowHandler* window, VkDeviceInstance* deviceInst);
+    // Without a window (headless) the swapchain is sized to headlessExtent.
+    Renderer(
+        WindowHandler* window,
+        VkDeviceInstance* deviceInst,
+        VkExtent2D headlessExtent = {DISPLAY_WIDTH, DISPLAY_HEIGHT});
     ~Renderer();
 
     Renderer(const Renderer&) = delete;
@@ -39,25 +51,123 @@ public:
     void SetFrameInProgress(bool state);
 
     uint32_t GetCurrentImageIndex() const;
+    size_t GetCurrentFrameIndex() const;
+    VkExtent2D GetSwapChainExtent() const;
+    float GetAspectRatio() const;
 
     VkCommandBuffer GetCurrentCommandBuffer() const;
 
     VkRenderPass GetRenderPass() const;
 
+    // Render pass or attachment formats to build the swapchain pass pipelines against.
+    RenderTargetInfo GetRenderTarget() const;
+
+    // Applied by recreating the swapchain at the start of the next frame.
+    void SetPresentMode(PresentMode mode);
+    PresentMode GetPresentMode() const;
+
+    // Frame slots the CPU records ahead with, clamped to [1, MAX_FRAMES_IN_FLIGHT]. Applied
+    // at the start of the next frame after the GPU drained, per frame resources are
+    // resized then. More slots trade latency for throughput.
+    void SetFramesInFlight(uint32_t count);
+    uint32_t GetFramesInFlight() const;
+
+    // Swapchain images requested, 0 -> minImageCount + 1. Applied by recreating the
+    // swapchain at the start of the next frame, the surface may give more.
+    void SetSwapChainImageCount(uint32_t count);
+    uint32_t GetSwapChainImageCount() const;
+
+    // Caps the number of frames queued on the GPU, independent of the frames in flight.
+    // 1 gives the lowest input latency, 0 disables the limiter for max throughput.
+    void SetFrameLatencyLimit(uint32_t maxQueuedFrames);
+    uint32_t GetFrameLatencyLimit() const;
+
+    // Waits until the queue is below the latency limit. Called by BeginFrame, call it
+    // earlier (before polling input) to sample input as late as possible.
+    void ThrottleFrameLatency();
+
+    // Submit -> present -> display latency of recent frames. Display times need
+    // VK_KHR_present_wait, ENABLE_PRESENT_TIMING turns the tracking off entirely.
+    PresentStats GetPresentStats() const;
+    std::vector<FrameTiming> GetRecentFrameTimings() const;
+
+    // Frame numbers come from the graphics queue timeline, they don't count frames. IsFrameComplete() is a plain
+    // compare against the last known counter, usable by any system holding a frame number.
+    uint64_t GetLastSubmittedValue() const;
+    bool IsFrameComplete(uint64_t frameNumber) const;
+
+    // Runs the deleter once the GPU is done with the frame being recorded, or with the
+    // last submitted frame when called outside of a frame.
+    void DeferDeletion(std::function<void()> deleter);
+
+    // Compute work for the next frame, recorded before BeginFrame. It is submitted right
+    // away (async compute queue when available) and the next frame only waits for it at
+    // graphicsWaitStage, so it overlaps whatever the graphics queue is still running.
+    // Resources written here are per frame slot, like the frame command buffers.
+    VkCommandBuffer BeginCompute();
+    uint64_t SubmitCompute(
+        VkPipelineStageFlags2 graphicsWaitStage =
+            VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT);
+
+    // Writes the current frame slot of the global UBO (set 0 binding 0), called between
+    // BeginFrame and the first draw. Viewport comes from the swapchain extent.
+    void UpdateGlobalUniforms(const Camera& camera, float time, float deltaTime);
+    GlobalUniformBuffer* GetGlobalUniforms();
+
+    // Per pass GPU times, results lag the frames in flight behind.
+    GpuProfiler* GetGpuProfiler();
+
+    // Reads every following frame back and writes it to disk on a worker thread.
+    // StopCapture waits for the frames in flight and for the writer to finish.
+    bool StartCapture(const FrameCaptureConfig& config);
+    void StopCapture();
+    bool IsCapturing() const;
+    FrameCapture* GetFrameCapture();
+
 private:
 
     void CreateCommandBuffer();
     void FreeCommandBuffers();
     void RecreateSwapChain();
 
+    // Frames in flight change : drains the GPU, then resizes the per frame resources.
+    void ResizeFrameResources();
+
+    // Dynamic rendering path of Begin/EndSwapChainRenderPass, with explicit layout transitions.
+    void BeginDynamicRendering(
+        VkCommandBuffer commandBuffer,
+        const VkClearValue& colorClear,
+        const VkClearValue& depthClear);
+    void EndDynamicRendering(VkCommandBuffer commandBuffer);
+
     WindowHandler* window_ = nullptr;
     VkDeviceInstance* deviceInst_ = nullptr;
+    VkExtent2D headlessExtent_;
 
     uint32_t currImgIdx_ = 0;
     bool isFrameStarted_ = false;
 
+    // Must outlive every swapchain, including retired ones in the deletion queue
+    PresentTimingTracker presentTracker_;
+
+    GpuProfiler gpuProfiler_;
+    GlobalUniformBuffer globalUniforms_;
+    uint32_t mainPassScope_ = UINT32_MAX;
+
+    std::unique_ptr<FrameCapture> frameCapture_;
+
+    SwapChainConfig swapChainConfig_;
+    bool swapChainDirty_ = false;
+    uint32_t frameLatencyLimit_ = FRAME_LATENCY_LIMIT;
+
     std::unique_ptr<SwapChainInstance> swapChainInst_;
-    std::vector<VkCommandBuffer> commandBuffers_;
+    std::vector<VkCommandBuffer> commandBuffers_; // One per frame in flight
+    std::vector<SemaphoreSubmit> frameWaits_; // Extra waits of the frame being recorded
+    std::vector<SemaphoreSubmit> computeWaits_; // Compute submitted for the next frame
+
+    // Retired swapchains and other resources waiting for their frames to finish
+    Core::DeferredDeletionQueue deletionQueue_;
+    std::vector<std::function<void()>> frameDeletions_; // Deferred during the frame being recorded
 };
 
 } // namespace Graphic
@@ -3,6 +3,12 @@
 #pragma once
 
 #include <Graphics/Renderer.hpp>
+#include <Core/DeferredDeletionQueue.ipp>
+#include <Graphics/Vulkan/VkPresentTimingImpl.ipp>
+#include <Graphics/Vulkan/VkGpuProfilerImpl.ipp>
+#include <Graphics/Vulkan/VkFrameCaptureImpl.ipp>
+#include <Graphics/Vulkan/VkGlobalUboImpl.ipp>
+#include <Graphics/Camera.ipp>
 
 namespace Graphic
 {
@@ -22,10 +28,41 @@ inline uint32_t Renderer::GetCurrentImageIndex() const
     return currImgIdx_;
 }
 
+inline size_t Renderer::GetCurrentFrameIndex() const
+{
+    return swapChainInst_->GetCurrentFrameIndex();
+}
+
+inline VkExtent2D Renderer::GetSwapChainExtent() const
+{
+    return swapChainInst_->GetSwapChainExtent();
+}
+
+inline uint32_t Renderer::GetFramesInFlight() const
+{
+    return swapChainInst_->GetFramesInFlight();
+}
+
+inline uint32_t Renderer::GetSwapChainImageCount() const
+{
+    return static_cast<uint32_t>(swapChainInst_->GetImageCount());
+}
+
+inline float Renderer::GetAspectRatio() const
+{
+    VkExtent2D extent = swapChainInst_->GetSwapChainExtent();
+    return static_cast<float>(extent.width) / static_cast<float>(extent.height);
+}
+
+inline GlobalUniformBuffer* Renderer::GetGlobalUniforms()
+{
+    return &globalUniforms_;
+}
+
 inline VkCommandBuffer Renderer::GetCurrentCommandBuffer() const
 {
     assert(isFrameStarted_ && "Unable top get command buffer when frame not in progress");
-    return commandBuffers_[currImgIdx_];
+    return commandBuffers_[swapChainInst_->GetCurrentFrameIndex()];
 }
 
 inline VkRenderPass Renderer::GetRenderPass() const
@@ -33,6 +70,60 @@ inline VkRenderPass Renderer::GetRenderPass() const
     return swapChainInst_->GetRenderPass();
 }
 
+inline RenderTargetInfo Renderer::GetRenderTarget() const
+{
+    RenderTargetInfo target;
+    target.renderPass = swapChainInst_->GetRenderPass();
+    target.colorFormat = swapChainInst_->GetSwapChainImageFormat();
+    target.depthFormat = swapChainInst_->HasDepth() ? swapChainInst_->GetSwapChainDepthFormat() : VK_FORMAT_UNDEFINED;
+    return target;
+}
+
+inline PresentMode Renderer::GetPresentMode() const
+{
+    return swapChainInst_->GetPresentMode();
+}
+
+inline uint32_t Renderer::GetFrameLatencyLimit() const
+{
+    return frameLatencyLimit_;
+}
+
+inline PresentStats Renderer::GetPresentStats() const
+{
+    return presentTracker_.GetStats();
+}
+
+inline std::vector<FrameTiming> Renderer::GetRecentFrameTimings() const
+{
+    return presentTracker_.GetRecentTimings();
+}
+
+inline uint64_t Renderer::GetLastSubmittedValue() const
+{
+    return swapChainInst_->GetLastSubmittedValue();
+}
+
+inline bool Renderer::IsFrameComplete(uint64_t frameNumber) const
+{
+    return swapChainInst_->IsFrameComplete(frameNumber);
+}
+
+inline GpuProfiler* Renderer::GetGpuProfiler()
+{
+    return &gpuProfiler_;
+}
+
+inline bool Renderer::IsCapturing() const
+{
+    return (frameCapture_ != nullptr);
+}
+
+inline FrameCapture* Renderer::GetFrameCapture()
+{
+    return frameCapture_.get();
+}
+
 } // namespace Graphic
 
 #endif
\ No newline at end of file
@@ -0,0 +1,225 @@
+#ifndef GRAPHICS_TEXTUREMANAGER_HPP
+#define GRAPHICS_TEXTUREMANAGER_HPP
+#pragma once
+
+#include <Graphics/Vulkan/VkTransferQueueImpl.hpp>
+#include <Core/ImageReader.hpp>
+#include <Core/Ktx2Reader.hpp>
+#include <Core/MappedFile.hpp>
+#include <Core/ThreadPool.hpp>
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+namespace Graphic { class Renderer; }
+
+namespace Graphic
+{
+
+struct TextureHandle
+{
+    uint32_t id = UINT32_MAX;
+    bool IsValid() const { return id != UINT32_MAX; }
+};
+
+struct TextureStats
+{
+    uint32_t textureCount = 0;
+    uint32_t residentCount = 0;  // At least one mip on the GPU
+    uint32_t streamingCount = 0; // Decoding, uploading or waiting for mip generation
+    VkDeviceSize residentBytes = 0;
+    VkDeviceSize budget = 0;
+};
+
+// Loads textures (TGA, PPM, KTX2) on worker threads and streams their mips in,
+// coarsest first:
+// - the first step uploads a small tail level (TEXTURE_TAIL_SIZE) so the texture is
+//   usable after a frame or two, each following step adds the next finer level
+// - only one level per step goes through the transfer queue, the coarser ones are
+//   blitted from it on the graphics queue (Update)
+// - KTX2 files are memory mapped and their levels copied to staging straight from the
+//   mapping, in the stored (block compressed) format. BC1-5 data the device can't
+//   sample is decoded to RGBA8 on the worker, other formats fail to load
+// - every step creates an image holding just the resident levels, the previous one is
+//   released once the frames sampling it are done
+// - over the residency budget, textures not drawn for TEXTURE_EVICT_AFTER_FRAMES drop
+//   their finest level, least recently used first, and nothing streams in
+// Sampled through set 1 binding 0, see GetDescriptorSetLayout(). Not thread safe, owned
+// by the render thread.
+class TextureManager
+{
+
+public:
+    TextureManager(VkDeviceInstance* deviceInst, Renderer* renderer);
+    ~TextureManager();
+
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    // Returns right away, decoding happens on a worker. Loading the same path again
+    // returns the same handle.
+    TextureHandle Load(const std::string& filePath);
+
+    // Uploads decoded levels, records mip generation and evictions into the frame
+    // command buffer. Called every frame between BeginFrame and the first draw.
+    void Update(VkCommandBuffer commandBuffer);
+
+    VkDescriptorSetLayout GetDescriptorSetLayout() const;
+
+    // Marks the texture as used by the frame being recorded. Until its first level is
+    // resident (or when loading failed) a 1x1 white texture is returned instead.
+    VkDescriptorSet GetDescriptorSet(TextureHandle handle);
+
+    bool IsResident(TextureHandle handle) const;
+
+    // Finest level on the GPU, UINT32_MAX when nothing is resident.
+    uint32_t GetResidentLevel(TextureHandle handle) const;
+
+    // Full size (level 0), {0, 0} until the file has been decoded.
+    VkExtent2D GetExtent(TextureHandle handle) const;
+
+    // Applied by the next Update, evicting if needed.
+    void SetResidencyBudget(VkDeviceSize bytes);
+    TextureStats GetStats() const;
+
+private:
+    // One image holding levels [baseLevel, mipCount) of a texture.
+    struct GpuImage
+    {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkExtent2D extent = {0, 0}; // Of baseLevel
+        uint32_t baseLevel = 0;
+        uint32_t levelCount = 0;
+        VkDeviceSize size = 0;
+        bool mipsPending = false; // Only baseLevel uploaded, RecordMipGeneration adds the rest
+    };
+
+    // Mapped KTX2 container, the levels point into the mapping.
+    struct KtxSource
+    {
+        Core::MappedFile file;
+        Core::Ktx2Image image;
+    };
+
+    struct Texture
+    {
+        std::string filePath;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipCount = 0;
+        uint32_t tailLevel = 0;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+
+        GpuImage resident;
+        GpuImage incoming; // Uploading, swapped in once its mips are generated
+        TransferTicket ticket;
+
+        // Decoded level 0 or the mapped KTX2, kept until the texture is fully resident
+        // or evicted
+        std::shared_ptr<const Core::ImageData> source;
+        std::shared_ptr<const KtxSource> ktx;
+
+        bool loading = false; // Worker job queued or running
+        VkDeviceSize reservedSize = 0; // Estimated size of the level being loaded
+        bool failed = false;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    // One stream step handed to a worker. Without source/ktx the file is (re)opened.
+    struct LoadRequest
+    {
+        uint32_t textureId = 0;
+        std::string filePath;
+        uint32_t level = UINT32_MAX; // UINT32_MAX -> tail level, decided once the size is known
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        std::shared_ptr<const Core::ImageData> source;
+        std::shared_ptr<const KtxSource> ktx;
+    };
+
+    // Produced by the workers, consumed by Update.
+    struct LoadResult
+    {
+        uint32_t textureId = 0;
+        uint32_t level = 0;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        std::shared_ptr<const Core::ImageData> source;
+        std::shared_ptr<const KtxSource> ktx;
+        Core::ImageData pixels; // Level 'level' when loaded from 'source'
+        bool failed = false;
+    };
+
+    void CreateDescriptorObjects();
+    void CreateFallback();
+
+    // Run on a worker.
+    void LoadLevel(LoadRequest request);
+    bool OpenSource(LoadRequest& request) const;
+    void QueueLoad(uint32_t textureId, uint32_t level);
+
+    // Sampled, copied and enabled on the device. Immutable after construction, safe
+    // from the workers.
+    bool CanSampleFormat(VkFormat format) const;
+
+    bool CreateGpuImage(VkExtent2D extent, uint32_t baseLevel, uint32_t levelCount, VkFormat format, GpuImage& gpuImage);
+    bool CreateView(GpuImage& gpuImage);
+    void ReleaseGpuImage(GpuImage& gpuImage);
+
+    void StartUploads();
+    void FinishUploads(VkCommandBuffer commandBuffer);
+    void EvictLevels(VkCommandBuffer commandBuffer);
+    void StreamLevels();
+
+    // Levels 1.. from level 0 (TRANSFER_SRC), everything ends SHADER_READ_ONLY.
+    void RecordMipGeneration(VkCommandBuffer commandBuffer, const GpuImage& gpuImage);
+
+    // Levels of 'src' from 'dst.baseLevel' onwards, 'src' is SHADER_READ_ONLY.
+    void RecordLevelCopy(VkCommandBuffer commandBuffer, const GpuImage& src, const GpuImage& dst);
+
+    bool IsRecentlyUsed(const Texture& texture) const;
+    VkDeviceSize GetResidentBytes() const;
+    static VkDeviceSize EstimateSize(const Texture& texture, uint32_t baseLevel);
+
+//----------------------------------------------------------------------------//
+
+    VkDeviceInstance* deviceInst_ = nullptr;
+    Renderer* renderer_ = nullptr;
+
+    VkSampler sampler_ = VK_NULL_HANDLE;
+    VkDescriptorSetLayout setLayout_ = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool_ = VK_NULL_HANDLE;
+    VkFilter blitFilter_ = VK_FILTER_LINEAR;
+    std::vector<VkFormat> sampledFormats_; // Of the known texture formats
+
+    GpuImage fallback_;
+
+    std::vector<Texture> textures_;
+    std::unordered_map<std::string, uint32_t> pathLookup_;
+    VkDeviceSize budget_ = TEXTURE_RESIDENCY_BUDGET;
+    uint64_t frame_ = 0; // Update calls, drives the LRU
+
+    std::mutex resultMutex_;
+    std::vector<LoadResult> results_; // Guarded by resultMutex_
+    std::atomic<bool> stopping_{false};
+
+    // Last member, its workers are joined before the rest is destroyed.
+    Core::ThreadPool loaderPool_;
+};
+
+} // namespace Graphic
+
+#endif
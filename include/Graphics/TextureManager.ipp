@@ -0,0 +1,63 @@
+#ifndef GRAPHICS_TEXTUREMANAGER_IPP
+#define GRAPHICS_TEXTUREMANAGER_IPP
+#pragma once
+
+#include <Graphics/TextureManager.hpp>
+
+// STD Lib
+#include <cassert>
+
+namespace Graphic
+{
+
+inline VkDescriptorSetLayout TextureManager::GetDescriptorSetLayout() const
+{
+    return setLayout_;
+}
+
+inline VkDescriptorSet TextureManager::GetDescriptorSet(TextureHandle handle)
+{
+    if (!handle.IsValid())
+    {
+        return fallback_.descriptorSet;
+    }
+
+    assert((handle.id < textures_.size()) && "Texture Manager: Invalid handle");
+    Texture& texture = textures_[handle.id];
+    texture.lastUsedFrame = frame_;
+
+    return (texture.resident.descriptorSet != VK_NULL_HANDLE) ? texture.resident.descriptorSet : fallback_.descriptorSet;
+}
+
+inline bool TextureManager::IsResident(TextureHandle handle) const
+{
+    return handle.IsValid() && (textures_[handle.id].resident.image != VK_NULL_HANDLE);
+}
+
+inline uint32_t TextureManager::GetResidentLevel(TextureHandle handle) const
+{
+    return IsResident(handle) ? textures_[handle.id].resident.baseLevel : UINT32_MAX;
+}
+
+inline VkExtent2D TextureManager::GetExtent(TextureHandle handle) const
+{
+    if (!handle.IsValid())
+    {
+        return {0, 0};
+    }
+    return {textures_[handle.id].width, textures_[handle.id].height};
+}
+
+inline void TextureManager::SetResidencyBudget(VkDeviceSize bytes)
+{
+    budget_ = bytes;
+}
+
+inline bool TextureManager::IsRecentlyUsed(const Texture& texture) const
+{
+    return (frame_ - texture.lastUsedFrame) <= TEXTURE_EVICT_AFTER_FRAMES;
+}
+
+} // namespace Graphic
+
+#endif
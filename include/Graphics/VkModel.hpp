@@ -3,6 +3,8 @@
 #pragma once
 
 #include <Graphics/Vulkan/VkInstanceImpl.hpp>
+#include <Graphics/Vulkan/VkTransferQueueImpl.hpp>
+#include <Settings.hpp>
 
 // External Lib
 #define GLM_FORCE_RADIANS
@@ -24,26 +26,81 @@ struct Vertex
     static std::vector<VkVertexInputAttributeDescription> GetAttributeDescriptions();
 };
 
+// Index range of one level of detail, see VkModel::SetLods.
+struct ModelLod
+{
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+};
+
 class VkModel
 {
 public:
     VkModel(VkDeviceInstance* vkInstance, std::vector<Vertex>& vertices);
+    // Indexed, drawn with vkCmdDrawIndexed.
+    VkModel(VkDeviceInstance* vkInstance, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+    // Copied straight from the caller's memory (e.g. a mapped cooked mesh) into staging,
+    // or into host visible device memory on unified memory devices. 'indices' may be null.
+    VkModel(
+        VkDeviceInstance* vkInstance,
+        const Vertex* vertices,
+        uint32_t vertexCount,
+        const uint32_t* indices,
+        uint32_t indexCount);
     ~VkModel();
 
     VkModel(const VkModel&) = delete;
     VkModel& operator=(const VkModel&) = delete;
 
+    // Vertices are uploaded asynchronously, skip the model until it is ready. Never ready
+    // when an upload failed, the buffers would only be partly filled.
+    bool IsReady() const;
+
+    // Index ranges drawn per level, invalid ranges are dropped. Without LODs the whole
+    // index buffer is drawn.
+    void SetLods(const std::vector<ModelLod>& lods);
+    uint32_t GetLodCount() const;
+
     void Bind(VkCommandBuffer cmdBuffer);
-    void Draw(VkCommandBuffer cmdBuffer);
+    // 'lod' is clamped to the coarsest level.
+    void Draw(VkCommandBuffer cmdBuffer, uint32_t lod = 0, uint32_t instanceCount = 1);
 
 private:
 
-    void CreateVertexBuffers(const std::vector<Vertex>& vertices);
+    void CreateVertexBuffers(const Vertex* vertices, uint32_t vertexCount);
+    void CreateIndexBuffer(const uint32_t* indices, uint32_t indexCount);
+
+    // Host visible and written in place on unified memory devices, otherwise device
+    // local and filled on the transfer queue.
+    void CreateGeometryBuffer(
+        const void* data,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        VkAccessFlags dstAccess,
+        VkBuffer& buffer,
+        VkDeviceMemory& bufferMem);
+
+    // Split in MODEL_UPLOAD_BATCH_SIZE uploads so no single staging allocation is the size
+    // of the buffer and pooled blocks get reused. Every block is held until its copy is
+    // acquired, so peak staging memory still matches the buffer size. Keeps the last
+    // ticket, later batches finish later. Sets uploadFailed_ when a batch is rejected.
+    void UploadInBatches(
+        VkBuffer dstBuffer,
+        const void* data,
+        VkDeviceSize size,
+        VkPipelineStageFlags dstStage,
+        VkAccessFlags dstAccess);
 
     VkDeviceInstance* vkInstance_ = VK_NULL_HANDLE;
     VkBuffer vertexBuffer_ = VK_NULL_HANDLE;
     VkDeviceMemory vertexBufferMem_ = VK_NULL_HANDLE;
     uint32_t vertexCount_ = 0;
+    VkBuffer indexBuffer_ = VK_NULL_HANDLE;
+    VkDeviceMemory indexBufferMem_ = VK_NULL_HANDLE;
+    uint32_t indexCount_ = 0;
+    std::vector<ModelLod> lods_;
+    TransferTicket uploadTicket_; // Last submitted batch, waited on before destruction
+    bool uploadFailed_ = false;
 };
 
 } // namespace Graphic
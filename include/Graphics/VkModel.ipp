@@ -3,9 +3,20 @@
 #pragma once
 
 #include <Graphics/VkModel.hpp>
+#include <Graphics/Vulkan/VkTransferQueueImpl.ipp>
 
 namespace Graphic
 {
+
+inline bool VkModel::IsReady() const
+{
+    return !uploadFailed_ && vkInstance_->GetTransferQueue()->IsReady(uploadTicket_);
+}
+
+inline uint32_t VkModel::GetLodCount() const
+{
+    return static_cast<uint32_t>(lods_.size());
+}
     
 } // namespace Graphic
 
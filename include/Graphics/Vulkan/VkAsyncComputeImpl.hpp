@@ -0,0 +1,76 @@
+#ifndef GRAPHICS_VULKAN_VKASYNCCOMPUTEIMPL_HPP
+#define GRAPHICS_VULKAN_VKASYNCCOMPUTEIMPL_HPP
+#pragma once
+
+#include <Graphics/Vulkan/VkTimelineImpl.hpp>
+#include <Global.hpp>
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+// Compute work recorded per frame slot and submitted to the async compute queue when
+// the device has one (graphics queue otherwise). The graphics frame only waits on it
+// at the stages that consume the results, so compute for frame N+1 can run while the
+// graphics queue is still busy with frame N.
+//
+// Resources shared with the graphics queue must be created with
+// VK_SHARING_MODE_CONCURRENT over GetQueueFamilies(), no ownership transfer is done.
+class AsyncCompute
+{
+
+public:
+    AsyncCompute(VkDeviceInstance* deviceInst);
+    ~AsyncCompute();
+
+    AsyncCompute(const AsyncCompute&) = delete;
+    AsyncCompute& operator=(const AsyncCompute&) = delete;
+
+    bool IsAsync() const;
+    QueueTimeline* GetTimeline() const;
+
+    // Graphics and compute families, a single entry when they are the same.
+    const std::vector<uint32_t>& GetQueueFamilies() const;
+
+    // Waits for the slot's previous compute submit and begins its command buffer. Slots
+    // are created on first use, so they follow the Renderer frames in flight.
+    VkCommandBuffer Begin(size_t frameSlot);
+
+    // graphicsWait orders the compute work after a graphics timeline value (e.g. the frame
+    // that last read what this compute pass overwrites), 0 for none. Returns the compute
+    // timeline value to wait on.
+    uint64_t Submit(uint64_t graphicsWait = 0);
+
+    // Wait to add to the graphics submit consuming the latest compute results.
+    // Returns false when nothing was submitted since the last call.
+    bool TakeGraphicsWait(VkPipelineStageFlags2 stageMask, SemaphoreSubmit& wait);
+
+private:
+
+    void CreateSlot();
+
+    VkDeviceInstance* deviceInst_ = nullptr;
+    QueueTimeline* timeline_ = nullptr;
+    bool async_ = false;
+    std::vector<uint32_t> queueFamilies_;
+
+    std::vector<VkCommandPool> commandPools_; // One per frame slot used so far, reset as a whole
+    std::vector<VkCommandBuffer> commandBuffers_;
+    std::vector<uint64_t> slotValue_; // Compute value last submitted from each slot
+
+    size_t recordingSlot_ = SIZE_MAX;
+    uint64_t pendingGraphicsWait_ = 0; // Latest value not yet handed to the graphics queue
+};
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef GRAPHICS_VULKAN_VKASYNCCOMPUTEIMPL_IPP
+#define GRAPHICS_VULKAN_VKASYNCCOMPUTEIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkAsyncComputeImpl.hpp>
+#include <Graphics/Vulkan/VkTimelineImpl.ipp>
+
+namespace Graphic
+{
+
+inline bool AsyncCompute::IsAsync() const
+{
+    return async_;
+}
+
+inline QueueTimeline* AsyncCompute::GetTimeline() const
+{
+    return timeline_;
+}
+
+inline const std::vector<uint32_t>& AsyncCompute::GetQueueFamilies() const
+{
+    return queueFamilies_;
+}
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef GRAPHICS_VULKAN_VKFRAMECAPTUREIMPL_HPP
+#define GRAPHICS_VULKAN_VKFRAMECAPTUREIMPL_HPP
+#pragma once
+
+#include <Core/ImageWriter.hpp>
+#include <Global.hpp>
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+struct FrameCaptureConfig
+{
+    std::string outputDir;      // Empty -> PROJECT_DIRECTORY + FRAME_CAPTURE_DIR
+    Core::ImageFileFormat format = Core::ImageFileFormat::Png;
+    uint32_t frameStride = 1;   // Capture every Nth frame
+    uint32_t maxFrames = 0;     // Stop capturing after this many frames, 0 -> unlimited
+    bool dropWhenBusy = false;  // Drop frames instead of holding the render thread back
+};
+
+//----------------------------------------------------------------------------//
+
+// Copies the final color image of a frame into a host visible buffer owned by the
+// frame slot. Once the slot comes around again its fence has signalled, the pixels
+// are handed to a writer thread that encodes and writes the file.
+class FrameCapture
+{
+
+public:
+    FrameCapture(VkDeviceInstance* deviceInst, const FrameCaptureConfig& config);
+    ~FrameCapture(); // Frames in flight must be complete, see Flush()
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Call after the slot's fence was waited on, before the slot records again.
+    void CollectSlot(uint32_t frameSlot);
+
+    // Records the readback after the last render pass of the frame. The image is
+    // returned to 'layout' afterwards. Returns false when the frame is skipped.
+    bool RecordCopy(
+        VkCommandBuffer commandBuffer,
+        uint32_t frameSlot,
+        VkImage image,
+        VkFormat format,
+        VkExtent2D extent,
+        VkImageLayout layout);
+
+    // Collects every slot and waits for the writer. Frames in flight must be complete.
+    void Flush();
+
+    bool IsFinished() const;
+    uint64_t GetWrittenCount() const;
+    uint64_t GetDroppedCount() const;
+    const std::string& GetOutputDir() const;
+
+private:
+    struct ReadbackSlot
+    {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        void* mapped = nullptr;
+        VkDeviceSize size = 0;
+
+        bool pending = false;
+        uint64_t captureIndex = 0;
+        VkExtent2D extent = {};
+        VkFormat format = VK_FORMAT_UNDEFINED;
+    };
+
+    struct WriteJob
+    {
+        uint64_t captureIndex;
+        VkExtent2D extent;
+        VkFormat format;
+        std::vector<uint8_t> pixels;
+    };
+
+    void EnsureSlotBuffer(ReadbackSlot& slot, VkDeviceSize size);
+    void DestroySlotBuffer(ReadbackSlot& slot);
+    void WriterLoop();
+
+//----------------------------------------------------------------------------//
+
+    VkDeviceInstance* deviceInst_ = nullptr;
+    FrameCaptureConfig config_;
+
+    std::array<ReadbackSlot, MAX_FRAMES_IN_FLIGHT> slots_ = {};
+    uint64_t frameCounter_ = 0;   // Frames seen, for the stride
+    uint64_t captureCounter_ = 0; // Frames recorded for capture
+
+    std::mutex mutex_;
+    std::condition_variable jobCondition_;   // Writer waits for work
+    std::condition_variable spaceCondition_; // Render thread waits for queue space / idle
+    std::deque<WriteJob> jobs_;
+    std::vector<std::vector<uint8_t>> freePixelBuffers_;
+    bool writing_ = false;
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> writtenCount_{0};
+    std::atomic<uint64_t> droppedCount_{0};
+
+    std::thread writerThread_;
+};
+
+} // namespace Graphic
+
+#endif
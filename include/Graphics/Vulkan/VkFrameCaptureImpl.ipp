@@ -0,0 +1,33 @@
+#ifndef GRAPHICS_VULKAN_VKFRAMECAPTUREIMPL_IPP
+#define GRAPHICS_VULKAN_VKFRAMECAPTUREIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkFrameCaptureImpl.hpp>
+#include <Core/ImageWriter.ipp>
+
+namespace Graphic
+{
+
+inline bool FrameCapture::IsFinished() const
+{
+    return (config_.maxFrames != 0) && (captureCounter_ >= config_.maxFrames);
+}
+
+inline uint64_t FrameCapture::GetWrittenCount() const
+{
+    return writtenCount_.load();
+}
+
+inline uint64_t FrameCapture::GetDroppedCount() const
+{
+    return droppedCount_.load();
+}
+
+inline const std::string& FrameCapture::GetOutputDir() const
+{
+    return config_.outputDir;
+}
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef GRAPHICS_VULKAN_VKGLOBALUBOIMPL_HPP
+#define GRAPHICS_VULKAN_VKGLOBALUBOIMPL_HPP
+#pragma once
+
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+// Set 0 binding 0 of every scene pipeline, matches GlobalUbo in the shaders (std140).
+struct GlobalUbo
+{
+    glm::mat4 viewProj{1.0f};
+    glm::vec4 viewport{0.0f}; // width, height, 1 / width, 1 / height
+    glm::vec4 time{0.0f};     // seconds since start, frame delta, unused, unused
+};
+
+// One host visible buffer holding a GlobalUbo per frame slot, reached through a single
+// UNIFORM_BUFFER_DYNAMIC descriptor. Switching slots only changes the dynamic offset.
+class GlobalUniformBuffer
+{
+
+public:
+    GlobalUniformBuffer(VkDeviceInstance* deviceInst, uint32_t frameCount);
+    ~GlobalUniformBuffer();
+
+    GlobalUniformBuffer(const GlobalUniformBuffer&) = delete;
+    GlobalUniformBuffer& operator=(const GlobalUniformBuffer&) = delete;
+
+    VkDescriptorSetLayout GetDescriptorSetLayout() const;
+
+    // Reallocates the buffer for a new number of frame slots, the GPU must be idle.
+    void SetFrameCount(uint32_t frameCount);
+
+    // The slot must not be in use by the GPU, i.e. after Renderer::BeginFrame.
+    void Update(size_t frameSlot, const GlobalUbo& ubo);
+
+    // Binds set 0 at the offset of the slot last updated.
+    void Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout) const;
+
+private:
+
+    void CreateBuffer();
+    void DestroyBuffer();
+    void CreateDescriptors();
+    void WriteDescriptor();
+
+    VkDeviceInstance* deviceInst_ = nullptr;
+
+    VkBuffer buffer_ = VK_NULL_HANDLE;
+    VkDeviceMemory memory_ = VK_NULL_HANDLE;
+    void* mapped_ = nullptr; // Persistently mapped, coherent
+    VkDeviceSize slotStride_ = 0; // sizeof(GlobalUbo) rounded to minUniformBufferOffsetAlignment
+    uint32_t frameCount_ = 0;
+
+    VkDescriptorSetLayout setLayout_ = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool_ = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSet_ = VK_NULL_HANDLE;
+
+    uint32_t currentOffset_ = 0;
+};
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef GRAPHICS_VULKAN_VKGLOBALUBOIMPL_IPP
+#define GRAPHICS_VULKAN_VKGLOBALUBOIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkGlobalUboImpl.hpp>
+
+namespace Graphic
+{
+
+inline VkDescriptorSetLayout GlobalUniformBuffer::GetDescriptorSetLayout() const
+{
+    return setLayout_;
+}
+
+inline void GlobalUniformBuffer::Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout) const
+{
+    vkCmdBindDescriptorSets(
+        commandBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        pipelineLayout,
+        0,
+        1,
+        &descriptorSet_,
+        1,
+        &currentOffset_);
+}
+
+} // namespace Graphic
+
+#endif
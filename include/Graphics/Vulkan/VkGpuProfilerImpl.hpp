@@ -0,0 +1,135 @@
+#ifndef GRAPHICS_VULKAN_VKGPUPROFILERIMPL_HPP
+#define GRAPHICS_VULKAN_VKGPUPROFILERIMPL_HPP
+#pragma once
+
+#include <Global.hpp>
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <array>
+#include <string>
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+struct GpuScopeResult
+{
+    std::string name;
+    uint32_t depth = 0;       // Nesting level, 0 for top level scopes
+    double gpuMs = 0.0;
+
+    // Only filled for scopes that collected pipeline statistics
+    bool hasStatistics = false;
+    uint64_t vertexInvocations = 0;
+    uint64_t fragmentInvocations = 0;
+};
+
+//----------------------------------------------------------------------------//
+
+// Timestamp queries with one query pool per frame in flight. A frame's results are
+// read back when its slot comes around again, after its fence was waited on, so
+// the readback never stalls the CPU. Results lag one frame per frame in flight.
+class GpuProfiler
+{
+
+public:
+    GpuProfiler(VkDeviceInstance* deviceInst);
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    bool IsEnabled() const;
+    bool IsPipelineStatisticsEnabled() const;
+
+    // Reads back the results of the previous use of this slot, then resets its pools.
+    // Must be recorded outside of a render pass, right after vkBeginCommandBuffer.
+    void BeginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+    void EndFrame(VkCommandBuffer commandBuffer);
+
+    // Scopes can nest but must not straddle a render pass begin/end. Pipeline
+    // statistics are collected for a scope only when no other statistics scope is
+    // open, since queries of the same type can't be nested.
+    // Returns the scope index to pass to EndScope, UINT32_MAX when it was dropped.
+    uint32_t BeginScope(VkCommandBuffer commandBuffer, const char* name, bool pipelineStatistics = true);
+    void EndScope(VkCommandBuffer commandBuffer, uint32_t scopeIndex);
+
+    // Latest frame that was read back.
+    const std::vector<GpuScopeResult>& GetLastResults() const;
+    double GetLastFrameGpuMs() const;
+
+private:
+    struct ScopeRecord
+    {
+        const char* name;
+        uint32_t depth;
+        uint32_t beginQuery;
+        uint32_t statisticsQuery; // UINT32_MAX when none
+        bool closed;
+    };
+
+    struct FrameQueries
+    {
+        VkQueryPool timestampPool = VK_NULL_HANDLE;
+        VkQueryPool statisticsPool = VK_NULL_HANDLE;
+        std::vector<ScopeRecord> scopes;
+        uint32_t statisticsCount = 0;
+        bool recorded = false; // Commands were written since the last reset
+    };
+
+    void CreateQueryPools();
+    void ReadBack(FrameQueries& frame);
+    double TicksToMs(uint64_t begin, uint64_t end) const;
+
+//----------------------------------------------------------------------------//
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* allocator_ = nullptr;
+    bool enabled_ = false;
+    bool statisticsEnabled_ = false;
+
+    double timestampPeriodNs_ = 1.0;
+    uint64_t timestampMask_ = ~0ull;
+
+    std::array<FrameQueries, MAX_FRAMES_IN_FLIGHT> frames_ = {};
+    FrameQueries* currentFrame_ = nullptr;
+    uint32_t openDepth_ = 0;
+    bool statisticsActive_ = false;
+
+    std::vector<GpuScopeResult> lastResults_;
+    double lastFrameGpuMs_ = 0.0;
+};
+
+//----------------------------------------------------------------------------//
+
+// RAII marker, a null profiler makes it a no-op.
+class GpuProfileScope
+{
+
+public:
+    GpuProfileScope(
+        GpuProfiler* profiler,
+        VkCommandBuffer commandBuffer,
+        const char* name,
+        bool pipelineStatistics = true);
+    ~GpuProfileScope();
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    GpuProfiler* profiler_;
+    VkCommandBuffer commandBuffer_;
+    uint32_t scopeIndex_ = UINT32_MAX;
+};
+
+} // namespace Graphic
+
+#endif
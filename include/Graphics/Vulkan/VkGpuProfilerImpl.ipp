@@ -0,0 +1,55 @@
+#ifndef GRAPHICS_VULKAN_VKGPUPROFILERIMPL_IPP
+#define GRAPHICS_VULKAN_VKGPUPROFILERIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkGpuProfilerImpl.hpp>
+
+namespace Graphic
+{
+
+inline bool GpuProfiler::IsEnabled() const
+{
+    return enabled_;
+}
+
+inline bool GpuProfiler::IsPipelineStatisticsEnabled() const
+{
+    return statisticsEnabled_;
+}
+
+inline const std::vector<GpuScopeResult>& GpuProfiler::GetLastResults() const
+{
+    return lastResults_;
+}
+
+inline double GpuProfiler::GetLastFrameGpuMs() const
+{
+    return lastFrameGpuMs_;
+}
+
+//----------------------------------------------------------------------------//
+
+inline GpuProfileScope::GpuProfileScope(
+    GpuProfiler* profiler,
+    VkCommandBuffer commandBuffer,
+    const char* name,
+    bool pipelineStatistics)
+    : profiler_(profiler), commandBuffer_(commandBuffer)
+{
+    if (profiler_ != nullptr)
+    {
+        scopeIndex_ = profiler_->BeginScope(commandBuffer_, name, pipelineStatistics);
+    }
+}
+
+inline GpuProfileScope::~GpuProfileScope()
+{
+    if (profiler_ != nullptr)
+    {
+        profiler_->EndScope(commandBuffer_, scopeIndex_);
+    }
+}
+
+} // namespace Graphic
+
+#endif
@@ -2,6 +2,7 @@
 #define GRAPHIC_VULKAN_VKINSTANCEIMPL_HPP
 #pragma once
 
+#include <Graphics/Vulkan/VkMemoryStatsImpl.hpp>
 #include <Graphics/WindowHandler.hpp>
 #include <Global.hpp>
 #include <Settings.hpp>
@@ -15,10 +16,16 @@
 #endif
 
 // STD Lib
+#include <memory>
 #include <vector>
 #include <string>
 
 // Forward Declarations
+namespace Graphic { class PipelineCacheInstance; }
+namespace Graphic { class QueueTimeline; }
+namespace Graphic { class TransferQueue; }
+namespace Graphic { class AsyncCompute; }
+namespace Graphic { struct TransferTicket; }
 namespace Graphic { struct QueueFamilyIndices; }
 namespace Graphic { struct SwapChainCapabilities; }
 
@@ -60,6 +67,13 @@ static std::vector<const char*> requiredDevExt = {
     VK_KHR_SWAPCHAIN_EXTENSION_NAME
 };
 
+// Optional Vulkan Extensions, enabled only when the device supports them.
+static std::vector<const char*> optionalDevExt = {
+    VK_KHR_PRESENT_ID_EXTENSION_NAME,
+    VK_KHR_PRESENT_WAIT_EXTENSION_NAME,
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+};
+
 // Required Validation Layers for debugging.
 static std::vector<const char*> requiredValidationLayers = {
     "VK_LAYER_KHRONOS_validation",
@@ -85,7 +99,10 @@ class VkDeviceInstance
 {
 
 public:
-    VkDeviceInstance(WindowHandler* window);
+    // A null window runs headless, either on a VK_EXT_headless_surface surface or
+    // without any surface at all (offscreen rendering). 'gpuOverride' picks the GPU by
+    // name or UUID, empty -> GPU_SELECT_ENV, then the highest scoring GPU.
+    VkDeviceInstance(WindowHandler* window, const std::string& gpuOverride = {});
     ~VkDeviceInstance();
 
     // Move operators - prevent creating multiple copies
@@ -101,39 +118,95 @@ public:
     VkSurfaceKHR GetSurface() { return surfaceKHR_; }
     VkQueue GetGraphicsQ() { return graphicsQueue_; }
     VkQueue GetPresentQ() { return presentQueue_; }
+    VkQueue GetTransferQ() { return transferQueue_; }
+    uint32_t GetGraphicsFamilyIdx() const { return graphicsFamilyIdx_; }
+    uint32_t GetTransferFamilyIdx() const { return transferFamilyIdx_; }
+    VkQueue GetComputeQ() { return computeQueue_; }
+    uint32_t GetComputeFamilyIdx() const { return computeFamilyIdx_; }
+    bool HasAsyncCompute() const { return computeFamilyIdx_ != graphicsFamilyIdx_; }
+    const VkPhysicalDeviceProperties& GetPhyDeviceProperties() { return phyDevProperties_; }
+    VkPipelineCache GetPipelineCache();
+    VkInstance GetInstance() { return instance_; }
+    bool IsHeadless() const { return window_ == nullptr; }
+
+    // Integrated GPU, device local memory is usually system memory the host can write
+    // directly. Allocations still have to check for a host visible device local type.
+    bool IsUnifiedMemory() const { return phyDevProperties_.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU; }
+
+    bool IsDeviceExtensionEnabled(const char* extensionName) const;
+    bool IsPresentWaitEnabled() const { return presentWaitEnabled_; }
+    bool IsPipelineStatisticsEnabled() const { return pipelineStatsEnabled_; }
+    bool IsSynchronization2Enabled() const { return synchronization2Enabled_; }
+    bool IsDynamicRenderingEnabled() const { return dynamicRenderingEnabled_; }
+
+    // Core features enabled on the logical device (texture compression among them).
+    const VkPhysicalDeviceFeatures& GetEnabledFeatures() const { return enabledCoreFeatures_; }
+
+    // Completion tracking of everything submitted to the graphics queue, frames included.
+    QueueTimeline* GetGraphicsTimeline() { return graphicsTimeline_.get(); }
+
+    // Null when the transfer family is the graphics family.
+    QueueTimeline* GetTransferTimeline() { return transferTimeline_.get(); }
+
+    // Staging uploads, on the dedicated transfer queue when there is one.
+    TransferQueue* GetTransferQueue() { return transferQueueInst_.get(); }
+
+    // Null without async compute. Shared with the transfer timeline when both use the
+    // same queue.
+    QueueTimeline* GetComputeTimeline() { return computeTimeline_; }
+
+    // Compute submissions, on the async compute queue when there is one.
+    AsyncCompute* GetAsyncCompute() { return asyncComputeInst_.get(); }
+
+    // Host allocation callbacks for every vkCreate*/vkDestroy* call, may be null.
+    const VkAllocationCallbacks* GetAllocator() const { return memoryStats_.GetHostCallbacks(); }
+
+    // Heap budgets, device memory by category and driver host memory.
+    MemoryStats* GetMemoryStats() { return &memoryStats_; }
 
     uint32_t FindMemoryType(uint32_t typeFiler, VkMemoryPropertyFlags properties);
 
+    // Same as FindMemoryType but reports a missing type instead of logging it.
+    bool TryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties, uint32_t& typeIndex);
+
     VkFormat FindSupportedFormat(
         const std::vector<VkFormat>& candidate,
         VkImageTiling tiling,
         VkFormatFeatureFlags features);
 
-    void CreateBuffer(
+    // Same fallback as CreateImageWithInfo, returns the properties that were actually used.
+    VkMemoryPropertyFlags CreateBuffer(
         VkDeviceSize devSize,
         VkBufferUsageFlags usage,
         VkMemoryPropertyFlags properties,
         VkBuffer& buffer,
-        VkDeviceMemory& bufferMem);
+        VkDeviceMemory& bufferMem,
+        MemoryCategory category,
+        VkMemoryPropertyFlags fallbackProperties = 0);
+
+    // vkAllocateMemory/vkFreeMemory tracked by the memory stats, for memory that isn't
+    // created through CreateBuffer/CreateImageWithInfo. Every device memory goes
+    // through FreeMemory, null is ignored.
+    VkResult AllocateMemory(const VkMemoryAllocateInfo& allocInfo, MemoryCategory category, VkDeviceMemory& memory);
+    void FreeMemory(VkDeviceMemory memory);
     
     VkCommandBuffer BeginSingleTimeCommands();
     
     void EndSingleTimeCommands(VkCommandBuffer cmdBuffer);
 
-    void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize devSize);
-
-    void CopyBufferToImage(
-        VkBuffer buffer,
-        VkImage image,
-        uint32_t width,
-        uint32_t height,
-        uint32_t layerCount);
+    // Runs on the transfer queue, the destination is usable by any graphics stage once
+    // GetTransferQueue()->IsReady(ticket). Images go through TransferQueue::UploadImage.
+    TransferTicket CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize devSize);
     
-    void CreateImageWithInfo(
+    // When no memory type has 'properties', 'fallbackProperties' are tried instead
+    // (if non zero). Returns the properties that were actually used.
+    VkMemoryPropertyFlags CreateImageWithInfo(
         const VkImageCreateInfo& imageInfo,
         VkMemoryPropertyFlags properties,
         VkImage& image,
-        VkDeviceMemory& imageMem);
+        VkDeviceMemory& imageMem,
+        MemoryCategory category,
+        VkMemoryPropertyFlags fallbackProperties = 0);
 
 private:
     // Main Initializers
@@ -153,7 +226,9 @@ private:
     // Physical Device selections functions.
     void PickPhysicalDevice();
     bool IsDeviceCompatible(VkPhysicalDevice device);
+    uint64_t ScorePhysicalDevice(VkPhysicalDevice device);
     std::vector<const char*> GetSupportedDeviceExtensions(VkPhysicalDevice device);
+    std::vector<const char*> GetSupportedOptionalDeviceExtensions(VkPhysicalDevice device);
     
     // Bind Physical Device into a logical abstract
     void CreateLogicalDeviceAndQueue();
@@ -161,9 +236,22 @@ private:
     // Command Pool creation
     void CreateCommandPool();
 
+    // Upload queue, needs the command pool for the ownership acquire fallback
+    void CreateTransferQueue();
+
+    // Per frame slot compute submission
+    void CreateAsyncCompute();
+
+    // Persistent pipeline cache, loaded from/saved to disk
+    void CreatePipelineCache();
+
 //----------------------------------------------------------------------------//
 
-    WindowHandler* window_ = nullptr; // Window instance SDL or GLFW
+    MemoryStats memoryStats_; // Before the instance, its host callbacks outlive every object
+
+    WindowHandler* window_ = nullptr; // Window instance SDL or GLFW, null when headless
+    std::string gpuOverride_; // GPU name or UUID requested through the config
+    bool headlessSurfaceExt_ = false; // VK_EXT_headless_surface enabled on the instance
 
     VkInstance instance_ = VK_NULL_HANDLE; // Vulkan Instance
     VkSurfaceKHR surfaceKHR_ = VK_NULL_HANDLE; // Surface to draw on
@@ -174,11 +262,32 @@ private:
     VkDevice logicalDevice_ = VK_NULL_HANDLE; // Logical GPU instance
     VkQueue graphicsQueue_ = VK_NULL_HANDLE;
     VkQueue presentQueue_ = VK_NULL_HANDLE;
+    VkQueue transferQueue_ = VK_NULL_HANDLE;
+    uint32_t graphicsFamilyIdx_ = 0;
+    uint32_t transferFamilyIdx_ = 0;
+    VkQueue computeQueue_ = VK_NULL_HANDLE;
+    uint32_t computeFamilyIdx_ = 0;
 
     VkSwapchainKHR swapChainInst_ = VK_NULL_HANDLE;
+
+    std::vector<const char*> enabledDevExt_;
+    bool presentWaitEnabled_ = false;
+    bool memoryBudgetEnabled_ = false;
+    bool pipelineStatsEnabled_ = false;
+    bool synchronization2Enabled_ = false;
+    bool dynamicRenderingEnabled_ = false; // Also needs synchronization2 for the layout transitions
+    VkPhysicalDeviceFeatures enabledCoreFeatures_ = {};
     
     VkCommandPool commandPool_ = VK_NULL_HANDLE;
 
+    std::unique_ptr<PipelineCacheInstance> pipelineCache_;
+    std::unique_ptr<QueueTimeline> graphicsTimeline_;
+    std::unique_ptr<QueueTimeline> transferTimeline_;
+    std::unique_ptr<TransferQueue> transferQueueInst_;
+    std::unique_ptr<QueueTimeline> computeTimelineInst_; // Only when the compute queue is its own
+    QueueTimeline* computeTimeline_ = nullptr;
+    std::unique_ptr<AsyncCompute> asyncComputeInst_;
+
     // Debugging control
     bool debuggingEnabled_ = ENABLE_VULKAN_VALIDATION;
     VkDebugUtilsMessengerEXT debugMessenger_;
@@ -3,10 +3,35 @@
 #pragma once
 
 #include <Graphics/Vulkan/VkInstanceImpl.hpp>
+#include <Graphics/Vulkan/VkPipelineCacheImpl.ipp>
+#include <Graphics/Vulkan/VkTimelineImpl.ipp>
+#include <Graphics/Vulkan/VkTransferQueueImpl.ipp>
+#include <Graphics/Vulkan/VkAsyncComputeImpl.ipp>
+#include <Graphics/Vulkan/VkMemoryStatsImpl.ipp>
+
+// STD Lib
+#include <cstring>
 
 namespace Graphic
 {
 
+inline VkPipelineCache VkDeviceInstance::GetPipelineCache()
+{
+    return (pipelineCache_ != nullptr) ? pipelineCache_->GetPipelineCache() : VK_NULL_HANDLE;
+}
+
+inline bool VkDeviceInstance::IsDeviceExtensionEnabled(const char* extensionName) const
+{
+    for (const char* enabled : enabledDevExt_)
+    {
+        if (strcmp(enabled, extensionName) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace Graphic
 
 
@@ -0,0 +1,141 @@
+#ifndef GRAPHICS_VULKAN_VKMEMORYSTATSIMPL_HPP
+#define GRAPHICS_VULKAN_VKMEMORYSTATSIMPL_HPP
+#pragma once
+
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Graphic
+{
+
+// Subsystem owning a device memory allocation, given to VkDeviceInstance::CreateBuffer,
+// CreateImageWithInfo and AllocateMemory.
+enum class MemoryCategory : uint32_t
+{
+    Unknown = 0,
+    Geometry = 1,     // Vertex / index buffers
+    Uniform = 2,
+    Staging = 3,      // Upload staging buffers
+    Readback = 4,     // Frame capture
+    Texture = 5,
+    RenderTarget = 6, // Offscreen swapchain images and depth buffers
+    Transient = 7,    // Render graph aliased memory
+    Count = 8
+};
+
+const char* GetMemoryCategoryName(MemoryCategory category);
+
+struct MemoryHeapStats
+{
+    VkDeviceSize size = 0;
+    VkDeviceSize budget = 0;    // VK_EXT_memory_budget, the heap size without it
+    VkDeviceSize usage = 0;     // Whole process as seen by the driver, tracked bytes without the extension
+    VkDeviceSize allocated = 0; // Tracked allocations in this heap
+    bool deviceLocal = false;
+};
+
+struct MemoryCategoryStats
+{
+    VkDeviceSize bytes = 0;
+    VkDeviceSize peakBytes = 0;
+    uint32_t allocations = 0; // Live vkAllocateMemory calls
+};
+
+// Driver allocations made through the VkAllocationCallbacks.
+struct HostMemoryStats
+{
+    size_t bytes = 0;
+    size_t peakBytes = 0;
+    size_t internalBytes = 0;   // Reported through pfnInternalAllocation, not ours to free
+    uint64_t allocations = 0;   // Live
+    uint64_t totalAllocations = 0;
+    std::array<size_t, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1> scopeBytes = {};
+};
+
+//----------------------------------------------------------------------------//
+
+// Where device and host memory goes:
+// - heap budgets and process usage from VK_EXT_memory_budget, refreshed each frame
+// - every vkAllocateMemory made through VkDeviceInstance, by category
+// - driver host allocations, counted by the VkAllocationCallbacks it hands out
+// Created before the VkInstance so the callbacks cover every Vulkan object.
+class MemoryStats
+{
+
+public:
+    MemoryStats();
+
+    MemoryStats(const MemoryStats&) = delete;
+    MemoryStats& operator=(const MemoryStats&) = delete;
+
+    // Heap layout of the selected device, 'budgetExt' -> VK_EXT_memory_budget is enabled.
+    void Init(VkPhysicalDevice physicalDevice, bool budgetExt);
+
+    // Pass to every vkCreate*/vkDestroy* call. Null when TRACK_HOST_ALLOCATIONS is 0.
+    const VkAllocationCallbacks* GetHostCallbacks() const;
+
+    void TrackAllocation(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, MemoryCategory category);
+    void TrackFree(VkDeviceMemory memory);
+
+    // Refreshes the budgets, logs every MEMORY_STATS_LOG_INTERVAL calls. Once per frame.
+    void Tick();
+
+    void UpdateBudgets();
+    void LogStats() const;
+
+    std::vector<MemoryHeapStats> GetHeapStats() const;
+    MemoryCategoryStats GetCategoryStats(MemoryCategory category) const;
+    HostMemoryStats GetHostStats() const;
+
+private:
+    struct Allocation
+    {
+        VkDeviceSize size = 0;
+        uint32_t heapIndex = 0;
+        MemoryCategory category = MemoryCategory::Unknown;
+    };
+
+    static VKAPI_ATTR void* VKAPI_CALL HostAllocate(
+        void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope);
+    static VKAPI_ATTR void* VKAPI_CALL HostReallocate(
+        void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+    static VKAPI_ATTR void VKAPI_CALL HostFree(void* userData, void* memory);
+    static VKAPI_ATTR void VKAPI_CALL HostInternalAllocation(
+        void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+    static VKAPI_ATTR void VKAPI_CALL HostInternalFree(
+        void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+
+    VkPhysicalDevice physicalDevice_ = VK_NULL_HANDLE;
+    bool budgetExt_ = false;
+    VkAllocationCallbacks hostCallbacks_ = {};
+
+    // Device allocations, tracked from any thread (pipeline builders, texture streaming)
+    mutable std::mutex mutex_;
+    std::unordered_map<VkDeviceMemory, Allocation> allocations_;
+    std::array<MemoryCategoryStats, static_cast<size_t>(MemoryCategory::Count)> categories_ = {};
+    std::vector<MemoryHeapStats> heaps_;
+    std::vector<uint32_t> typeToHeap_;
+
+    // Host allocations, the callbacks run on any thread without a lock
+    std::atomic<size_t> hostBytes_{0};
+    std::atomic<size_t> hostPeakBytes_{0};
+    std::atomic<size_t> hostInternalBytes_{0};
+    std::atomic<uint64_t> hostAllocations_{0};
+    std::atomic<uint64_t> hostTotalAllocations_{0};
+    std::array<std::atomic<size_t>, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1> hostScopeBytes_ = {};
+
+    uint64_t tickCount_ = 0;
+};
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef GRAPHICS_VULKAN_VKMEMORYSTATSIMPL_IPP
+#define GRAPHICS_VULKAN_VKMEMORYSTATSIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkMemoryStatsImpl.hpp>
+
+namespace Graphic
+{
+
+inline const VkAllocationCallbacks* MemoryStats::GetHostCallbacks() const
+{
+#if TRACK_HOST_ALLOCATIONS
+    return &hostCallbacks_;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef GRAPHICS_VULKAN_VKPIPELINEBUILDERIMPL_HPP
+#define GRAPHICS_VULKAN_VKPIPELINEBUILDERIMPL_HPP
+#pragma once
+
+#include <Graphics/Vulkan/VkPipelineImpl.hpp>
+#include <Core/ThreadPool.hpp>
+#include <Settings.hpp>
+
+// STD Lib
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+using PipelineFuture = std::shared_future<std::shared_ptr<GraphicPipeline>>;
+
+// Handle to a pipeline that may still be compiling on a worker thread.
+class PipelineHandle
+{
+
+public:
+    PipelineHandle() = default;
+    explicit PipelineHandle(PipelineFuture future);
+
+    bool IsValid() const;
+    bool IsReady() const;
+
+    // Returns nullptr while compilation is still in flight or if it failed.
+    GraphicPipeline* Get() const;
+
+    void Wait() const;
+
+private:
+    PipelineFuture future_;
+};
+
+//----------------------------------------------------------------------------//
+
+class AsyncPipelineBuilder
+{
+
+public:
+    AsyncPipelineBuilder(VkDeviceInstance* deviceInst, uint32_t threadCount = PIPELINE_BUILDER_THREADS);
+    ~AsyncPipelineBuilder();
+
+    AsyncPipelineBuilder(const AsyncPipelineBuilder&) = delete;
+    AsyncPipelineBuilder& operator=(const AsyncPipelineBuilder&) = delete;
+
+    // Queue a pipeline for compilation. Requests that are pending at the time a
+    // worker picks them up are created together in one vkCreateGraphicsPipelines call.
+    PipelineHandle Submit(const GraphicPipelineDesc& desc);
+
+    PipelineHandle Submit(
+        const std::string& vertFilePath,
+        const std::string& fragFilePath,
+        const PipelineConfigInfo& configInfo);
+
+    // Block until all queued pipelines are compiled.
+    void WaitIdle();
+
+private:
+    struct PendingRequest
+    {
+        GraphicPipelineDesc desc;
+        std::promise<std::shared_ptr<GraphicPipeline>> promise;
+    };
+
+    void CompilePendingBatch();
+
+//----------------------------------------------------------------------------//
+
+    VkDeviceInstance* deviceInst_ = nullptr;
+
+    std::mutex pendingMutex_;
+    std::vector<PendingRequest> pending_;
+
+    // Declared last so workers are joined before the queue above is destroyed.
+    Core::ThreadPool threadPool_;
+};
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef GRAPHICS_VULKAN_VKPIPELINEBUILDERIMPL_IPP
+#define GRAPHICS_VULKAN_VKPIPELINEBUILDERIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkPipelineBuilderImpl.hpp>
+
+// STD Lib
+#include <chrono>
+
+namespace Graphic
+{
+
+inline PipelineHandle::PipelineHandle(PipelineFuture future) : future_(std::move(future))
+{
+}
+
+inline bool PipelineHandle::IsValid() const
+{
+    return future_.valid();
+}
+
+inline bool PipelineHandle::IsReady() const
+{
+    return future_.valid() &&
+           (future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+}
+
+inline GraphicPipeline* PipelineHandle::Get() const
+{
+    return IsReady() ? future_.get().get() : nullptr;
+}
+
+inline void PipelineHandle::Wait() const
+{
+    if (future_.valid())
+    {
+        future_.wait();
+    }
+}
+
+} // namespace Graphic
+
+#endif
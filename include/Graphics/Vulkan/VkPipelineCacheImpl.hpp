@@ -0,0 +1,75 @@
+#ifndef GRAPHICS_VULKAN_VKPIPELINECACHEIMPL_HPP
+#define GRAPHICS_VULKAN_VKPIPELINECACHEIMPL_HPP
+#pragma once
+
+#include <Global.hpp>
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <string>
+#include <vector>
+
+namespace Graphic
+{
+
+// Header written in front of the driver blob, used to reject stale or corrupt files.
+struct PipelineCacheFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+    uint64_t dataHash;
+};
+
+constexpr uint32_t PIPELINE_CACHE_FILE_MAGIC = 0x48435047; // "GPCH"
+constexpr uint32_t PIPELINE_CACHE_FILE_VERSION = 1;
+
+//----------------------------------------------------------------------------//
+
+class PipelineCacheInstance
+{
+
+public:
+    PipelineCacheInstance(
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        const VkPhysicalDeviceProperties& properties);
+    ~PipelineCacheInstance();
+
+    PipelineCacheInstance(const PipelineCacheInstance&) = delete;
+    PipelineCacheInstance& operator=(const PipelineCacheInstance&) = delete;
+
+    VkPipelineCache GetPipelineCache() const;
+    const std::string& GetCacheFilePath() const;
+
+    // Write the current cache content to disk, skipped when nothing changed.
+    bool Save();
+
+private:
+    std::string BuildCacheFilePath() const;
+
+    std::vector<char> LoadCacheFile() const;
+    bool IsCacheDataValid(const std::vector<char>& fileData) const;
+    bool WriteCacheFile(const std::vector<char>& cacheData) const;
+
+//----------------------------------------------------------------------------//
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* allocator_ = nullptr;
+    VkPhysicalDeviceProperties properties_ = {};
+    VkPipelineCache pipelineCache_ = VK_NULL_HANDLE;
+
+    std::string cacheFilePath_;
+    uint64_t loadedDataHash_ = 0;
+};
+
+} // namespace Graphic
+
+#endif
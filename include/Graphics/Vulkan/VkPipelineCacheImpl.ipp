@@ -0,0 +1,22 @@
+#ifndef GRAPHICS_VULKAN_VKPIPELINECACHEIMPL_IPP
+#define GRAPHICS_VULKAN_VKPIPELINECACHEIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkPipelineCacheImpl.hpp>
+
+namespace Graphic
+{
+
+inline VkPipelineCache PipelineCacheInstance::GetPipelineCache() const
+{
+    return pipelineCache_;
+}
+
+inline const std::string& PipelineCacheInstance::GetCacheFilePath() const
+{
+    return cacheFilePath_;
+}
+
+} // namespace Graphic
+
+#endif
@@ -4,12 +4,21 @@
 
 #include <Graphics/Vulkan/VkInstanceImpl.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace Graphic
 {
 
+// What a pipeline renders into. With a render pass the formats are implied by it,
+// without one (dynamic rendering) the formats are given through VkPipelineRenderingCreateInfo.
+struct RenderTargetInfo
+{
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED; // VK_FORMAT_UNDEFINED when there is no depth
+};
 
 struct PipelineConfigInfo
 {
@@ -23,8 +32,20 @@ struct PipelineConfigInfo
     std::vector<VkDynamicState> dynamicStateEnable;
     VkPipelineDynamicStateCreateInfo dynamicStateInfo;
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
-    VkRenderPass renderPass = VK_NULL_HANDLE;
+    RenderTargetInfo renderTarget;
     uint32_t subpass = 0;
+
+    // Specialization constants, shared by the vertex and fragment stage.
+    std::vector<VkSpecializationMapEntry> specializationEntries;
+    std::vector<uint8_t> specializationData;
+};
+
+// Everything needed to build one pipeline, used for batched/async creation.
+struct GraphicPipelineDesc
+{
+    std::string vertFilePath; // Asset paths, e.g. VERT_SHADER_PATH
+    std::string fragFilePath;
+    PipelineConfigInfo configInfo;
 };
 
 class GraphicPipeline
@@ -43,25 +64,70 @@ public:
 
     static void DefaultPipelineConfigInfo(PipelineConfigInfo& configInfo);
 
+    // Build several independent pipelines with a single vkCreateGraphicsPipelines call.
+    // Entries whose shaders are missing or failed to compile are returned as nullptr,
+    // the others are still created.
+    static std::vector<std::unique_ptr<GraphicPipeline>> CreateBatch(
+        VkDeviceInstance* instance,
+        const std::vector<GraphicPipelineDesc>& descs);
+
+    // False when the shaders are missing or the pipeline failed to compile.
+    bool IsValid() const;
     void BindPipeline(VkCommandBuffer commandBuffer);
 
 private:
-    std::vector<char> ReadFile(const std::string& filePath);
+    friend class ComputePipeline;
+
+    // Adopts an already created pipeline, used by CreateBatch()
+    GraphicPipeline(VkDevice device, const VkAllocationCallbacks* allocator, VkPipeline pipeline);
+
+    // Asset path, served by the mounted archives or the loose files (Core::VirtualFileSystem).
+    static std::vector<char> ReadFile(const std::string& filePath);
 
     void CreateGraphicsPipeline(
         const std::string& vertFilePath,
         const std::string& fragFilePath,
         const PipelineConfigInfo& configInfo);
 
-    void CreateShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule);
+    // False for empty / truncated SPIR-V or when the driver rejects it.
+    static bool CreateShaderModule(
+        VkDevice device,
+        const VkAllocationCallbacks* allocator,
+        const std::vector<char>& code,
+        VkShaderModule* shaderModule);
 
 //----------------------------------------------------------------------------//
 
     VkDevice device_ = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* allocator_ = nullptr;
+    VkPipelineCache pipelineCache_ = VK_NULL_HANDLE;
     VkPipeline renderPipeline_ = VK_NULL_HANDLE;
     VkShaderModule vertShaderModule_ = VK_NULL_HANDLE;
     VkShaderModule fragShaderModule_ = VK_NULL_HANDLE;
 };
+
+//----------------------------------------------------------------------------//
+
+// Single compute shader against a caller owned layout. IsValid() is false when the
+// shader is missing or failed to compile.
+class ComputePipeline
+{
+
+public:
+    ComputePipeline(VkDeviceInstance* instance, const std::string& compFilePath, VkPipelineLayout pipelineLayout);
+    ~ComputePipeline();
+
+    ComputePipeline(const ComputePipeline&) = delete;
+    ComputePipeline& operator=(const ComputePipeline&) = delete;
+
+    bool IsValid() const;
+    void BindPipeline(VkCommandBuffer commandBuffer);
+
+private:
+    VkDevice device_ = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* allocator_ = nullptr;
+    VkPipeline pipeline_ = VK_NULL_HANDLE;
+};
     
 } // namespace Graphic
 
@@ -6,7 +6,17 @@
 
 namespace Graphic
 {
-    
+
+inline bool GraphicPipeline::IsValid() const
+{
+    return renderPipeline_ != VK_NULL_HANDLE;
+}
+
+inline bool ComputePipeline::IsValid() const
+{
+    return pipeline_ != VK_NULL_HANDLE;
+}
+
 } // namespace Graphic
 
 #endif
\ No newline at end of file
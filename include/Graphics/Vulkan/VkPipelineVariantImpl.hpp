@@ -0,0 +1,91 @@
+#ifndef GRAPHICS_VULKAN_VKPIPELINEVARIANTIMPL_HPP
+#define GRAPHICS_VULKAN_VKPIPELINEVARIANTIMPL_HPP
+#pragma once
+
+#include <Graphics/Vulkan/VkPipelineImpl.hpp>
+#include <Graphics/Vulkan/VkPipelineBuilderImpl.hpp>
+
+// STD Lib
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+// Must match the constant_id declared in the shaders.
+enum ShaderConstantId : uint32_t
+{
+    SHADER_CONST_COLOR_SOURCE = 0,
+    SHADER_CONST_SHAPE_MODE = 1,
+};
+
+enum class ColorSource : uint32_t
+{
+    PushConstant = 0,
+    Vertex = 1,
+};
+
+enum class ShapeMode : uint32_t
+{
+    Mesh = 0,
+    SdfCircle = 1, // Unit circle evaluated per fragment, drawn on a quad
+};
+
+// One combination of specialization constants. Each permutation maps to its own
+// pipeline, built from the same SPIR-V with dead branches removed by the driver.
+struct ShaderPermutation
+{
+    ColorSource colorSource = ColorSource::PushConstant;
+    ShapeMode shapeMode = ShapeMode::Mesh;
+
+    uint64_t GetKey() const;
+
+    // Writes the specialization map/data into the pipeline config.
+    void Apply(PipelineConfigInfo& configInfo) const;
+};
+
+//----------------------------------------------------------------------------//
+
+// Lazily creates and reuses one pipeline per shader permutation.
+class PipelineVariantCache
+{
+
+public:
+    PipelineVariantCache(
+        VkDeviceInstance* deviceInst,
+        const std::string& vertFilePath,
+        const std::string& fragFilePath,
+        const PipelineConfigInfo& baseConfig,
+        AsyncPipelineBuilder* pipelineBuilder = nullptr);
+    ~PipelineVariantCache();
+
+    PipelineVariantCache(const PipelineVariantCache&) = delete;
+    PipelineVariantCache& operator=(const PipelineVariantCache&) = delete;
+
+    // Returns the cached variant or starts compiling it.
+    PipelineHandle GetOrCreate(const ShaderPermutation& permutation);
+
+    size_t GetVariantCount();
+
+    // Wait for every variant still being compiled.
+    void WaitIdle();
+
+private:
+    VkDeviceInstance* deviceInst_ = nullptr;
+    AsyncPipelineBuilder* pipelineBuilder_ = nullptr;
+
+    std::string vertFilePath_;
+    std::string fragFilePath_;
+    PipelineConfigInfo baseConfig_;
+
+    std::mutex variantMutex_;
+    std::unordered_map<uint64_t, PipelineHandle> variants_;
+};
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef GRAPHICS_VULKAN_VKPIPELINEVARIANTIMPL_IPP
+#define GRAPHICS_VULKAN_VKPIPELINEVARIANTIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkPipelineVariantImpl.hpp>
+#include <Graphics/Vulkan/VkPipelineBuilderImpl.ipp>
+
+namespace Graphic
+{
+
+inline uint64_t ShaderPermutation::GetKey() const
+{
+    return (static_cast<uint64_t>(colorSource) << 0) |
+           (static_cast<uint64_t>(shapeMode) << 8);
+}
+
+inline size_t PipelineVariantCache::GetVariantCount()
+{
+    std::lock_guard<std::mutex> lock(variantMutex_);
+    return variants_.size();
+}
+
+} // namespace Graphic
+
+#endif
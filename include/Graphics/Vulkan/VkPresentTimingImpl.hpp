@@ -0,0 +1,130 @@
+#ifndef GRAPHICS_VULKAN_VKPRESENTTIMINGIMPL_HPP
+#define GRAPHICS_VULKAN_VKPRESENTTIMINGIMPL_HPP
+#pragma once
+
+#include <Global.hpp>
+#include <Settings.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+using PresentClock = std::chrono::steady_clock;
+
+// Timings of one presented frame, all in milliseconds.
+struct FrameTiming
+{
+    uint64_t presentId = 0;
+    double submitToPresentMs = 0.0;  // vkQueueSubmit -> vkQueuePresentKHR returned
+    double presentToDisplayMs = 0.0; // vkQueuePresentKHR -> image visible (present wait)
+    double submitToDisplayMs = 0.0;
+    bool displayed = false;          // False when present wait is unavailable or dropped
+
+    PresentClock::time_point submitTime;
+    PresentClock::time_point presentTime;
+    PresentClock::time_point displayTime;
+};
+
+struct PresentStats
+{
+    uint32_t frameCount = 0;     // Frames in the history
+    uint32_t displayedCount = 0; // Frames with a display timestamp
+    double avgSubmitToPresentMs = 0.0;
+    double avgPresentToDisplayMs = 0.0;
+    double avgSubmitToDisplayMs = 0.0;
+    double maxSubmitToDisplayMs = 0.0;
+    bool presentWaitSupported = false;
+};
+
+//----------------------------------------------------------------------------//
+
+// Tags every present with a present ID and waits on it from a helper thread to
+// find out when the image actually reached the display.
+class PresentTimingTracker
+{
+
+public:
+    PresentTimingTracker(VkDeviceInstance* deviceInst);
+    ~PresentTimingTracker();
+
+    PresentTimingTracker(const PresentTimingTracker&) = delete;
+    PresentTimingTracker& operator=(const PresentTimingTracker&) = delete;
+
+    bool IsPresentWaitSupported() const;
+
+    // Present ID for the next vkQueuePresentKHR. Only chained into the present when
+    // IsPresentWaitSupported(), otherwise it just indexes the history.
+    uint64_t AcquirePresentId();
+
+    // Record a present that was just issued, the helper thread takes it from here.
+    void OnPresented(
+        VkSwapchainKHR swapChain,
+        uint64_t presentId,
+        PresentClock::time_point submitTime,
+        PresentClock::time_point presentTime);
+
+    // Presenting and waiting both access the swapchain, which must be externally
+    // synchronized. Hold this lock around vkQueuePresentKHR and swapchain destruction
+    // (or its use as oldSwapchain). The helper thread holds it for one short wait at a
+    // time and doesn't start another while the render thread is queued for it.
+    std::unique_lock<std::mutex> LockSwapChain();
+
+    // Drops every pending wait on a swapchain that is about to be destroyed.
+    // Must be called while holding LockSwapChain().
+    void ForgetSwapChain(VkSwapchainKHR swapChain);
+
+    // Snapshot of the most recent frames, oldest first.
+    std::vector<FrameTiming> GetRecentTimings() const;
+    PresentStats GetStats() const;
+
+private:
+    struct PendingPresent
+    {
+        VkSwapchainKHR swapChain;
+        uint64_t presentId;
+    };
+
+    void WaitLoop();
+    void RecordDisplay(uint64_t presentId, PresentClock::time_point displayTime);
+
+//----------------------------------------------------------------------------//
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    PFN_vkWaitForPresentKHR waitForPresent_ = nullptr;
+    bool presentWaitSupported_ = false;
+
+    uint64_t nextPresentId_ = 1;
+
+    // Ring buffer of frame timings, indexed by presentId % PRESENT_TIMING_HISTORY
+    mutable std::mutex historyMutex_;
+    std::array<FrameTiming, PRESENT_TIMING_HISTORY> history_ = {};
+    uint64_t latestPresentId_ = 0;
+
+    // Pending waits consumed by the helper thread
+    std::mutex swapChainMutex_;
+    std::mutex pendingMutex_;
+    std::condition_variable pendingCondition_;
+    std::deque<PendingPresent> pending_;
+    uint32_t swapChainRequests_ = 0; // Render thread calls queued on swapChainMutex_, guarded by pendingMutex_
+    std::atomic<bool> stopping_{false};
+    std::thread waitThread_;
+};
+
+} // namespace Graphic
+
+#endif
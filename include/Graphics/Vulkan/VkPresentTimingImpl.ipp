@@ -0,0 +1,17 @@
+#ifndef GRAPHICS_VULKAN_VKPRESENTTIMINGIMPL_IPP
+#define GRAPHICS_VULKAN_VKPRESENTTIMINGIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkPresentTimingImpl.hpp>
+
+namespace Graphic
+{
+
+inline bool PresentTimingTracker::IsPresentWaitSupported() const
+{
+    return presentWaitSupported_;
+}
+
+} // namespace Graphic
+
+#endif
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <Graphics/Vulkan/VkInstanceImpl.hpp>
+#include <Graphics/Vulkan/VkTimelineImpl.hpp>
 
 // External Libs
 #include <vulkan/vulkan.h>
@@ -14,15 +15,52 @@
 
 // Forward declarations
 class VkDeviceInstance;
+namespace Graphic { class PresentTimingTracker; }
 
 namespace Graphic
 {
 
+enum class PresentMode : uint32_t
+{
+    Fifo = 0,        // V-Sync, never tears
+    FifoRelaxed = 1, // V-Sync, tears when a frame misses the vblank
+    Mailbox = 2,     // Low latency, never tears, newest frame replaces the queued one
+    Immediate = 3,   // Uncapped, may tear
+};
+
+const char* PresentModeToString(PresentMode mode);
+
+enum class DepthMode : uint32_t
+{
+    Dedicated = 0, // Device local depth image
+    Transient = 1, // Transient attachment, lazily allocated memory when available
+    None = 2,      // No depth attachment at all
+};
+
+struct SwapChainConfig
+{
+    PresentMode presentMode = static_cast<PresentMode>(DEFAULT_PRESENT_MODE);
+    DepthMode depthMode = static_cast<DepthMode>(DEFAULT_DEPTH_MODE); // Changes the render pass
+    PresentTimingTracker* presentTracker = nullptr; // Optional, not owned
+    uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT; // Clamped to [1, MAX_FRAMES_IN_FLIGHT]
+    uint32_t imageCount = DEFAULT_SWAPCHAIN_IMAGE_COUNT; // 0 -> minImageCount + 1
+};
+
+//----------------------------------------------------------------------------//
+
 class SwapChainInstance
 {
 
 public:
-    SwapChainInstance(VkDeviceInstance* instance, VkExtent2D windowExtent);
+    // When a previous swapchain is given it is passed as oldSwapchain, and its
+    // render pass and sync objects are taken over instead of being recreated.
+    // Without a surface it becomes a ring of one offscreen image per frame in flight
+    // that are left in TRANSFER_SRC_OPTIMAL at the end of the render pass.
+    SwapChainInstance(
+        VkDeviceInstance* instance,
+        VkExtent2D windowExtent,
+        const SwapChainConfig& config = {},
+        SwapChainInstance* previous = nullptr);
     ~SwapChainInstance();
 
     SwapChainInstance(const SwapChainInstance&) = delete;
@@ -36,9 +74,45 @@ public:
     VkFormat GetSwapChainDepthFormat() { return swapChainDepthFormat_; }
     size_t GetImageCount() { return swapChainImages_.size(); }
 
+    VkImage GetImage(int32_t index) { return swapChainImages_[index]; }
     VkImageView GetImageView(int32_t index) {return swapChainImgViews_[index]; }
-    VkFramebuffer GetFrameBuffer(int32_t index) { return frameBuffer_[index]; }
+    bool IsOffscreen() const { return offscreen_; }
+
+    // Layout of the color images after the render pass, and whether they can be copied from.
+    VkImageLayout GetFinalColorLayout() const;
+    bool SupportsReadback() const { return readbackSupported_; }
+    // Depth images are per frame in flight, so framebuffers are per (frame slot, image).
+    VkFramebuffer GetFrameBuffer(size_t frameSlot, uint32_t imageIndex) const;
+    bool HasDepth() const { return config_.depthMode != DepthMode::None; }
+    VkImage GetDepthImage(size_t frameSlot) const { return depthImages_[frameSlot]; }
+    VkImageView GetDepthImageView(size_t frameSlot) const { return depthImgViews_[frameSlot]; }
+
+    // With dynamic rendering there is no render pass nor framebuffers, GetRenderPass()
+    // returns VK_NULL_HANDLE and the attachments are begun with vkCmdBeginRendering.
+    bool UsesDynamicRendering() const { return dynamicRendering_; }
     VkRenderPass GetRenderPass() const { return renderPass_; }
+    size_t GetCurrentFrameIndex() const { return currentFrame_; }
+    uint32_t GetFramesInFlight() const { return framesInFlight_; }
+
+    // Frame number last submitted from a frame slot, 0 if none.
+    uint64_t GetFrameSlotValue(size_t frameSlot) const { return frameSlotValue_[frameSlot]; }
+
+    // Timeline value of the frame submitted 'framesBack' frames ago (1 -> the last one),
+    // 0 if none. framesBack must be within [1, frames in flight].
+    uint64_t GetRecentFrameValue(uint32_t framesBack) const;
+
+    // Frame numbers are graphics timeline values, 0 means nothing submitted yet. They
+    // only ever increase but may skip values taken by other graphics queue submits
+    // (uploads, single time commands, compute), so they don't count frames.
+    uint64_t GetLastSubmittedValue() const;
+    uint64_t GetCompletedFrameCount();
+    bool IsFrameComplete(uint64_t frameNumber);
+
+    // Present mode actually in use, may differ from the requested one.
+    PresentMode GetPresentMode() const { return presentMode_; }
+
+    // Block until the given frame number has finished on the GPU.
+    void WaitForFrame(uint64_t frameNumber);
 
     float ExtendAspectRatio() { 
         return (static_cast<float>(swapChainExtent_.width)/static_cast<float>(swapChainExtent_.height));
@@ -49,15 +123,23 @@ public:
 
     VkFormat FindDepthFormat();
     VkResult AcquireNextImage(uint32_t* imageIndex);
-    VkResult SubmitCommandBuffers(const VkCommandBuffer* buffers, uint32_t* imageIndex);
+    // extraWaits are added to the frame submit, e.g. transfers acquired in this frame.
+    VkResult SubmitCommandBuffers(
+        const VkCommandBuffer* buffers,
+        uint32_t* imageIndex,
+        const std::vector<SemaphoreSubmit>& extraWaits = {});
 
 private:
-    void CreateSwapChain();
+    void CreateSwapChain(VkSwapchainKHR oldSwapChain);
+    void CreateOffscreenImages();
+    void AdoptRenderPass(SwapChainInstance* previous);
+    void AdoptSyncObjects(SwapChainInstance* previous);
     void CreateImageView();
     void CreateDepthResources();
     void CreateRenderPass();
     void CreateFrameBuffers();
     void CreateSyncObjects();
+    void CreateRenderCompleteSemaphores();
 
     VkSurfaceFormatKHR ChooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availFormats);
     VkPresentModeKHR ChooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availPresentMode);
@@ -67,6 +149,12 @@ private:
 
 VkDeviceInstance* instance_; // Vulkan instance
 VkExtent2D windowExtent_; // X * Y -> window measurements
+SwapChainConfig config_;
+bool offscreen_ = false; // No surface, images are owned by us
+bool readbackSupported_ = false; // Color images have TRANSFER_SRC usage
+bool dynamicRendering_ = false; // No render pass / framebuffers
+PresentMode presentMode_ = PresentMode::Fifo;
+uint32_t framesInFlight_ = DEFAULT_FRAMES_IN_FLIGHT; // Frame slots, from the config
 
 VkExtent2D swapChainExtent_;
 VkFormat swapChainImageFormat_;
@@ -80,15 +168,16 @@ std::vector<VkDeviceMemory> depthImgMem_;
 std::vector<VkImageView> depthImgViews_;
 std::vector<VkImageView> swapChainImgViews_;
 std::vector<VkImage> swapChainImages_;
+std::vector<VkDeviceMemory> offscreenImgMem_;
 
 // SwapChain instance
 VkSwapchainKHR swapChainInst_ = VK_NULL_HANDLE;
 
 // Thread safety controls
-std::vector<VkSemaphore> imgAvailSemaphores_;
-std::vector<VkSemaphore> renderCompSemaphores_;
-std::vector<VkFence> inFlightFences_;
-std::vector<VkFence> imgInFlight_;
+QueueTimeline* timeline_ = nullptr; // Graphics queue timeline, owned by the device
+std::vector<VkSemaphore> imgAvailSemaphores_; // Per frame slot, handed over on recreation
+std::vector<VkSemaphore> renderCompSemaphores_; // Per image, reusable once the image is acquired again
+std::vector<uint64_t> frameSlotValue_; // Timeline value of the last frame submitted from each slot
 size_t currentFrame_ = 0;
 
 };
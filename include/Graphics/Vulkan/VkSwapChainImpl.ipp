@@ -3,6 +3,10 @@
 #pragma once
 
 #include <Graphics/Vulkan/VkSwapChainImpl.hpp>
+#include <Graphics/Vulkan/VkTimelineImpl.ipp>
+
+// STD Lib
+#include <cassert>
 
 namespace Graphic
 {
@@ -13,6 +17,42 @@ inline bool SwapChainInstance::CompareSwapFormats(VkFormat imageFormat, VkFormat
            (depthFormat == swapChainDepthFormat_));
 }
 
+inline uint64_t SwapChainInstance::GetLastSubmittedValue() const
+{
+    return timeline_->GetSubmittedValue();
+}
+
+inline uint64_t SwapChainInstance::GetRecentFrameValue(uint32_t framesBack) const
+{
+    assert((framesBack >= 1) && (framesBack <= framesInFlight_) && "Only the frames in flight are tracked");
+
+    // Slots are used round robin, currentFrame_ is the slot of the next frame.
+    size_t slot = (currentFrame_ + framesInFlight_ - framesBack) % framesInFlight_;
+    return frameSlotValue_[slot];
+}
+
+inline uint64_t SwapChainInstance::GetCompletedFrameCount()
+{
+    return timeline_->GetCompletedValue();
+}
+
+inline bool SwapChainInstance::IsFrameComplete(uint64_t frameNumber)
+{
+    return timeline_->IsComplete(frameNumber);
+}
+
+inline VkFramebuffer SwapChainInstance::GetFrameBuffer(size_t frameSlot, uint32_t imageIndex) const
+{
+    // Without depth a single set of framebuffers serves every frame slot.
+    size_t slotCount = HasDepth() ? framesInFlight_ : 1;
+    return frameBuffer_[((frameSlot % slotCount) * swapChainImages_.size()) + imageIndex];
+}
+
+inline VkImageLayout SwapChainInstance::GetFinalColorLayout() const
+{
+    return offscreen_ ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+}
+
 } // namespace Graphic
 
 #endif
\ No newline at end of file
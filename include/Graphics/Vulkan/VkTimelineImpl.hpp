@@ -0,0 +1,87 @@
+#ifndef GRAPHICS_VULKAN_VKTIMELINEIMPL_HPP
+#define GRAPHICS_VULKAN_VKTIMELINEIMPL_HPP
+#pragma once
+
+#include <Global.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace Graphic
+{
+
+// Semaphore to wait on or signal as part of a submit. Value is ignored for binary semaphores.
+struct SemaphoreSubmit
+{
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    uint64_t value = 0;
+    VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+};
+
+//----------------------------------------------------------------------------//
+
+// One timeline semaphore per queue. Every Submit() signals the next value, so a value
+// identifies a submission and "is N complete" is a comparison against the counter.
+class QueueTimeline
+{
+
+public:
+    // synchronization2 selects vkQueueSubmit2, otherwise vkQueueSubmit is used.
+    QueueTimeline(VkDevice device, const VkAllocationCallbacks* allocator, VkQueue queue, bool synchronization2);
+    ~QueueTimeline();
+
+    QueueTimeline(const QueueTimeline&) = delete;
+    QueueTimeline& operator=(const QueueTimeline&) = delete;
+
+    VkSemaphore GetSemaphore() const;
+    VkQueue GetQueue() const;
+
+    // Value signaled by the most recent Submit(), 0 before the first one.
+    uint64_t GetSubmittedValue() const;
+
+    // Queries the semaphore counter.
+    uint64_t GetCompletedValue();
+
+    // Served from the last queried counter when possible, queries at most once otherwise.
+    bool IsComplete(uint64_t value);
+
+    // Returns false on timeout.
+    bool Wait(uint64_t value, uint64_t timeoutNs = UINT64_MAX);
+
+    // Submits the command buffers and signals the timeline with the returned value, plus
+    // any extra signals. Submissions on the queue are serialized by an internal lock.
+    uint64_t Submit(
+        const VkCommandBuffer* commandBuffers,
+        uint32_t commandBufferCount,
+        const std::vector<SemaphoreSubmit>& waits = {},
+        const std::vector<SemaphoreSubmit>& signals = {},
+        VkResult* result = nullptr);
+
+private:
+    VkResult SubmitLegacy(
+        const VkCommandBuffer* commandBuffers,
+        uint32_t commandBufferCount,
+        const std::vector<SemaphoreSubmit>& waits,
+        const std::vector<SemaphoreSubmit>& signals);
+
+//----------------------------------------------------------------------------//
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* allocator_ = nullptr;
+    VkQueue queue_ = VK_NULL_HANDLE;
+    VkSemaphore semaphore_ = VK_NULL_HANDLE;
+    bool synchronization2_ = false;
+
+    std::mutex submitMutex_; // Queue access and value ordering
+    std::atomic<uint64_t> submittedValue_{0};
+    std::atomic<uint64_t> completedValue_{0}; // Cached counter
+};
+
+} // namespace Graphic
+
+#endif
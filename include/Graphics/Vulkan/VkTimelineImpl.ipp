@@ -0,0 +1,33 @@
+#ifndef GRAPHICS_VULKAN_VKTIMELINEIMPL_IPP
+#define GRAPHICS_VULKAN_VKTIMELINEIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkTimelineImpl.hpp>
+
+namespace Graphic
+{
+
+inline VkSemaphore QueueTimeline::GetSemaphore() const
+{
+    return semaphore_;
+}
+
+inline VkQueue QueueTimeline::GetQueue() const
+{
+    return queue_;
+}
+
+inline uint64_t QueueTimeline::GetSubmittedValue() const
+{
+    return submittedValue_.load(std::memory_order_acquire);
+}
+
+inline bool QueueTimeline::IsComplete(uint64_t value)
+{
+    if (value <= completedValue_.load(std::memory_order_acquire)) { return true; }
+    return (value <= GetCompletedValue());
+}
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef GRAPHICS_VULKAN_VKTRANSFERQUEUEIMPL_HPP
+#define GRAPHICS_VULKAN_VKTRANSFERQUEUEIMPL_HPP
+#pragma once
+
+#include <Graphics/Vulkan/VkTimelineImpl.hpp>
+#include <Global.hpp>
+
+// External Lib
+#include <vulkan/vulkan.h>
+
+// STD Lib
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Forward declarations
+namespace Graphic { class VkDeviceInstance; }
+
+namespace Graphic
+{
+
+// Handle of one upload. Value 0 is an empty ticket, always ready.
+struct TransferTicket
+{
+    uint64_t value = 0; // Value signaled on the transfer timeline
+};
+
+// One mip level of UploadImageLevels, tightly packed.
+struct ImageLevelData
+{
+    const void* data = nullptr;
+    VkDeviceSize size = 0;
+    VkExtent3D extent = {0, 0, 0};
+};
+
+//----------------------------------------------------------------------------//
+
+// Uploads through staging buffers on a transfer-only queue family when the device has
+// one, so copies overlap with rendering. Ownership of the destination is released on
+// the transfer queue and acquired on the graphics queue by RecordAcquires() once the
+// copy has finished. Without a dedicated family the graphics queue is used directly.
+// Staging buffers stay mapped and are recycled once their copy is done, up to
+// TRANSFER_STAGING_POOL_SIZE bytes.
+class TransferQueue
+{
+
+public:
+    TransferQueue(VkDeviceInstance* deviceInst);
+    ~TransferQueue();
+
+    TransferQueue(const TransferQueue&) = delete;
+    TransferQueue& operator=(const TransferQueue&) = delete;
+
+    bool IsDedicated() const;
+    QueueTimeline* GetTimeline() const;
+
+    // dstStage/dstAccess describe the first use of the destination on the graphics queue.
+    // Large buffers can be filled in several uploads at increasing dstOffset.
+    TransferTicket UploadBuffer(
+        VkBuffer dstBuffer,
+        const void* data,
+        VkDeviceSize size,
+        VkPipelineStageFlags dstStage,
+        VkAccessFlags dstAccess,
+        VkDeviceSize dstOffset = 0);
+
+    TransferTicket CopyBuffer(
+        VkBuffer srcBuffer,
+        VkBuffer dstBuffer,
+        VkDeviceSize size,
+        VkPipelineStageFlags dstStage,
+        VkAccessFlags dstAccess);
+
+    // Whole image (mip 0), left in finalLayout. The previous contents are discarded,
+    // other mips are left untouched.
+    TransferTicket UploadImage(
+        VkImage dstImage,
+        const void* data,
+        VkDeviceSize size,
+        VkExtent3D extent,
+        uint32_t layerCount,
+        VkImageLayout finalLayout,
+        VkPipelineStageFlags dstStage,
+        VkAccessFlags dstAccess);
+
+    // Levels 0.. of a single layer image from one staging block, left in finalLayout.
+    // Block compressed data is copied as is, straight from the source pointers.
+    TransferTicket UploadImageLevels(
+        VkImage dstImage,
+        const std::vector<ImageLevelData>& levels,
+        VkImageLayout finalLayout,
+        VkPipelineStageFlags dstStage,
+        VkAccessFlags dstAccess);
+
+    // Copy has finished on the transfer queue.
+    bool IsComplete(TransferTicket ticket);
+
+    // Destination can be used by graphics commands recorded from now on.
+    bool IsReady(TransferTicket ticket);
+
+    // Blocks until IsReady(), acquiring ownership with a one off submit if needed.
+    void WaitReady(TransferTicket ticket);
+
+    // Records the acquire barriers of every finished upload into a graphics command
+    // buffer and adds the matching timeline wait for its submit. Also frees staging
+    // memory of completed uploads.
+    void RecordAcquires(VkCommandBuffer commandBuffer, std::vector<SemaphoreSubmit>& waits);
+
+    // Bytes of idle staging buffers kept for reuse.
+    VkDeviceSize GetPooledStagingSize();
+
+private:
+    struct StagingBlock
+    {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        void* mapped = nullptr;
+    };
+
+    struct PendingUpload
+    {
+        uint64_t value = 0;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        StagingBlock staging;
+
+        // Acquire half of the ownership transfer, empty when not dedicated
+        std::vector<VkBufferMemoryBarrier> bufferAcquires;
+        std::vector<VkImageMemoryBarrier> imageAcquires;
+        VkPipelineStageFlags dstStage = 0;
+        bool acquired = false;
+    };
+
+    bool CreateStaging(const void* data, VkDeviceSize size, PendingUpload& upload);
+
+    // Must hold mutex_.
+    bool AcquireStaging(VkDeviceSize size, StagingBlock& block);
+    void RecycleStaging(StagingBlock& block);
+    void DestroyStaging(StagingBlock& block);
+
+    // Must hold mutex_, it also guards the command pool while recording.
+    VkCommandBuffer BeginUpload();
+    TransferTicket EndUpload(PendingUpload&& upload);
+    TransferTicket RecordBufferCopy(
+        PendingUpload&& upload,
+        VkBuffer srcBuffer,
+        VkBuffer dstBuffer,
+        VkDeviceSize dstOffset,
+        VkDeviceSize size,
+        VkPipelineStageFlags dstStage,
+        VkAccessFlags dstAccess);
+    TransferTicket RecordImageCopy(
+        PendingUpload&& upload,
+        VkImage dstImage,
+        const std::vector<VkBufferImageCopy>& regions,
+        uint32_t levelCount,
+        uint32_t layerCount,
+        VkImageLayout finalLayout,
+        VkPipelineStageFlags dstStage,
+        VkAccessFlags dstAccess);
+    void RecordAcquireBarriers(VkCommandBuffer commandBuffer, const PendingUpload& upload);
+    void ReleaseFinished();
+
+//----------------------------------------------------------------------------//
+
+    VkDeviceInstance* deviceInst_ = nullptr;
+    QueueTimeline* timeline_ = nullptr;
+    bool dedicated_ = false;
+    uint32_t transferFamily_ = 0;
+    uint32_t graphicsFamily_ = 0;
+
+    VkCommandPool commandPool_ = VK_NULL_HANDLE;
+
+    std::mutex mutex_; // Pool, pending list and acquire bookkeeping
+    std::deque<PendingUpload> pending_;
+    std::vector<StagingBlock> stagingPool_; // Idle, mapped
+    VkDeviceSize pooledStagingSize_ = 0;
+    uint64_t acquiredValue_ = 0; // Every upload up to this value is acquired
+};
+
+} // namespace Graphic
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef GRAPHICS_VULKAN_VKTRANSFERQUEUEIMPL_IPP
+#define GRAPHICS_VULKAN_VKTRANSFERQUEUEIMPL_IPP
+#pragma once
+
+#include <Graphics/Vulkan/VkTransferQueueImpl.hpp>
+#include <Graphics/Vulkan/VkTimelineImpl.ipp>
+
+namespace Graphic
+{
+
+inline bool TransferQueue::IsDedicated() const
+{
+    return dedicated_;
+}
+
+inline QueueTimeline* TransferQueue::GetTimeline() const
+{
+    return timeline_;
+}
+
+inline bool TransferQueue::IsComplete(TransferTicket ticket)
+{
+    return timeline_->IsComplete(ticket.value);
+}
+
+} // namespace Graphic
+
+#endif
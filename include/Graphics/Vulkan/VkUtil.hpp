@@ -51,6 +51,42 @@ QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surfa
 
 SwapChainCapabilities GetSwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface);
 
+// Transfer-only family (DMA engine) if any, then a transfer family without graphics,
+// otherwise fallbackFamily.
+uint32_t FindTransferQueueFamily(VkPhysicalDevice device, uint32_t fallbackFamily);
+
+// Compute family without graphics (async compute) if any, otherwise fallbackFamily.
+uint32_t FindComputeQueueFamily(VkPhysicalDevice device, uint32_t fallbackFamily);
+
+// Number of queues exposed by a family.
+uint32_t GetQueueFamilyQueueCount(VkPhysicalDevice device, uint32_t family);
+
+// Readable VkPhysicalDeviceType, for the logs.
+const char* GetDeviceTypeName(VkPhysicalDeviceType type);
+
+// Largest DEVICE_LOCAL heap, the VRAM size on discrete GPUs. Integrated GPUs report
+// (part of) the system memory.
+VkDeviceSize GetDeviceLocalHeapSize(VkPhysicalDevice device);
+
+// VkPhysicalDeviceIDProperties::deviceUUID as 32 lowercase hex digits, stable across
+// runs and driver restarts unlike the enumeration order.
+std::string GetDeviceUUIDString(VkPhysicalDevice device);
+
+// Depth, plus stencil for the combined formats.
+VkImageAspectFlags GetDepthAspectMask(VkFormat depthFormat);
+
+// Single image layout transition through vkCmdPipelineBarrier2 (synchronization2).
+void ImageBarrier2(
+    VkCommandBuffer cmdBuffer,
+    VkImage image,
+    VkImageAspectFlags aspectMask,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    VkPipelineStageFlags2 srcStage,
+    VkAccessFlags2 srcAccess,
+    VkPipelineStageFlags2 dstStage,
+    VkAccessFlags2 dstAccess);
+
 } // namespace Graphic
 
 
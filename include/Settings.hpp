@@ -5,13 +5,127 @@
 // Enables the Vulkan Validation Layer, will cause some performance drop.
 #define ENABLE_VULKAN_VALIDATION 1
 
+// Environment variable forcing the GPU, by device name (case insensitive substring) or
+// by UUID as printed in the selection log. --gpu takes precedence, unset -> best score.
+#define GPU_SELECT_ENV "GFX_GPU"
+
 // Temp settings for windows control
 #define DISPLAY_WIDTH 800
 #define DISPLAY_HEIGHT 600
-#define MAX_FRAMES_IN_FLIGHT 2
+
+// Frames the CPU may record ahead of the GPU, changeable at runtime through
+// Renderer::SetFramesInFlight up to MAX_FRAMES_IN_FLIGHT (sizes the fixed per frame arrays).
+#define DEFAULT_FRAMES_IN_FLIGHT 2
+#define MAX_FRAMES_IN_FLIGHT 4
+
+// Swapchain images requested, 0 -> minImageCount + 1. Clamped to the surface limits,
+// changeable at runtime through Renderer::SetSwapChainImageCount.
+#define DEFAULT_SWAPCHAIN_IMAGE_COUNT 0
+
+// Headless mode (--headless) : use VK_EXT_headless_surface when available, otherwise
+// render into an offscreen image ring. Frames rendered when --frames is not given.
+#define HEADLESS_SURFACE_EXT 1
+#define HEADLESS_DEFAULT_FRAMES 600
+
+// Render with vkCmdBeginRendering (Vulkan 1.3 dynamic rendering + synchronization2)
+// when the device supports it, otherwise with the legacy render pass and framebuffers.
+#define USE_DYNAMIC_RENDERING 1
+
+// Upload on a transfer-only queue family when the device has one, with queue family
+// ownership transfers to the graphics queue. 0 keeps every upload on the graphics queue.
+#define USE_TRANSFER_QUEUE 1
+
+// Idle staging buffers kept mapped for the next uploads, in bytes. Staging buffers are
+// rounded up to a power of two, at least TRANSFER_STAGING_MIN_SIZE.
+#define TRANSFER_STAGING_POOL_SIZE (64ull * 1024 * 1024)
+#define TRANSFER_STAGING_MIN_SIZE (64ull * 1024)
+
+// Submit compute work (AsyncCompute) on a compute family without graphics when the
+// device has one, so it overlaps the graphics queue. 0 keeps it on the graphics queue.
+#define USE_ASYNC_COMPUTE 1
+
+// Depth buffer : 0 -> device local, 1 -> transient (lazily allocated where supported),
+// 2 -> none, for pure 2D pipelines. One depth image per frame in flight.
+#define DEFAULT_DEPTH_MODE 1
+
+// Present mode : 0 -> FIFO (V-Sync), 1 -> FIFO_RELAXED, 2 -> MAILBOX, 3 -> IMMEDIATE
+#define DEFAULT_PRESENT_MODE 0
+
+// Max frames queued on the GPU before the CPU waits, 0 -> only the frames in flight apply
+#define FRAME_LATENCY_LIMIT 0
+
+// Present timing (VK_KHR_present_id / VK_KHR_present_wait), frames kept in history
+#define ENABLE_PRESENT_TIMING 1
+#define PRESENT_TIMING_HISTORY 256
+
+// GPU timestamp profiler, scopes recorded per frame and optional pipeline statistics
+#define ENABLE_GPU_PROFILER 1
+#define GPU_PROFILER_MAX_SCOPES 64
+#define GPU_PROFILER_PIPELINE_STATS 1
+
+// GPU memory stats : VK_EXT_memory_budget heaps, allocations by category and driver host
+// allocations through VkAllocationCallbacks. Logged every N frames, 0 -> never.
+#define TRACK_HOST_ALLOCATIONS 1
+#define MEMORY_STATS_LOG_INTERVAL 600
+
+// CPU scope profiler, compiled out when disabled. Events per thread ring, events kept
+// for the Chrome trace dump (F12) and its location relative to the project directory
+#define ENABLE_CPU_PROFILER 1
+#define CPU_PROFILER_RING_SIZE 8192
+#define CPU_PROFILER_HISTORY 262144
+#define CPU_PROFILER_TRACE_PATH "/Cache/cpu_trace.json"
+
+// Frame capture : output location relative to the project directory, and the number of
+// frames waiting for the writer thread before the render thread is held back
+#define FRAME_CAPTURE_DIR "/Captures/"
+#define FRAME_CAPTURE_QUEUE_DEPTH 8
+
+// Asset archive built by the PackAssets target, looked up next to the executable (or
+// --assets PATH). Without it assets are read as loose files from the project directory.
+#define ASSET_ARCHIVE_NAME "Assets.pak"
 
 // Temp shader location <-- might use json for future proofing
 #define VERT_SHADER_PATH "/Assets/Compiled_Shaders/simple_shader.vert.spv"
 #define FRAG_SHADER_PATH "/Assets/Compiled_Shaders/simple_shader.frag.spv"
 
+// Textured, alpha blended sprites (SpriteRenderPipeline)
+#define SPRITE_VERT_SHADER_PATH "/Assets/Compiled_Shaders/sprite_shader.vert.spv"
+#define SPRITE_FRAG_SHADER_PATH "/Assets/Compiled_Shaders/sprite_shader.frag.spv"
+
+// Vector field evaluated by a compute shader (async compute queue) and drawn instanced,
+// bodies taken into account must match MAX_BODIES in vector_field.comp
+#define VECTOR_FIELD_COMP_SHADER_PATH "/Assets/Compiled_Shaders/vector_field.comp.spv"
+#define VECTOR_FIELD_VERT_SHADER_PATH "/Assets/Compiled_Shaders/vector_field.vert.spv"
+#define VECTOR_FIELD_FRAG_SHADER_PATH "/Assets/Compiled_Shaders/vector_field.frag.spv"
+#define VECTOR_FIELD_MAX_BODIES 4
+
+// Asynchronous pipeline compilation
+#define PIPELINE_BUILDER_THREADS 2
+#define PIPELINE_BATCH_SIZE 16
+
+// Pipeline cache location, relative to the project directory
+#define PIPELINE_CACHE_DIR "/Cache/"
+
+// Texture streaming : decode threads, GPU memory budget of resident mips, largest side
+// of the first level streamed in, stream steps started per frame and the frames a
+// texture stays unused before its high mips may be evicted
+#define TEXTURE_LOADER_THREADS 2
+#define TEXTURE_RESIDENCY_BUDGET (256ull * 1024 * 1024)
+#define TEXTURE_TAIL_SIZE 64
+#define TEXTURE_UPLOADS_PER_FRAME 4
+#define TEXTURE_EVICT_AFTER_FRAMES 120
+#define TEXTURE_MAX_DESCRIPTOR_SETS 1024
+
+// Mesh import : worker threads (0 -> one per hardware thread), vertices or indices converted per
+// task, OBJ bytes parsed per task, and the size of the staging uploads a model's
+// buffers are split into
+#define MESH_IMPORT_THREADS 0
+#define MESH_IMPORT_CHUNK_SIZE 65536
+#define MESH_IMPORT_OBJ_CHUNK_BYTES (4ull * 1024 * 1024)
+#define MODEL_UPLOAD_BATCH_SIZE (16ull * 1024 * 1024)
+
+// Largest vertex + index output of one imported glTF file, instancing can make a small
+// file expand far past its own size
+#define MESH_IMPORT_MAX_BYTES (2ull * 1024 * 1024 * 1024)
+
 #endif
\ No newline at end of file
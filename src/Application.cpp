@@ -1,8 +1,16 @@
 #include <Application.hpp>
 #include <Input/InputHandler.ipp>
 #include <Graphics/Vulkan/VkUtil.ipp>
+#include <Graphics/Vulkan/VkTransferQueueImpl.ipp>
 
 #include <Graphics/Pipeline/SimpleRenderPipeline.ipp>
+#include <Graphics/Pipeline/VectorFieldPipeline.ipp>
+#include <Graphics/Pipeline/SpriteRenderPipeline.ipp>
+#include <Graphics/RenderGraph.ipp>
+#include <Graphics/TextureManager.ipp>
+#include <Graphics/MeshImporter.ipp>
+#include <Core/VirtualFileSystem.ipp>
+#include <Core/Profiler.ipp>
 
 // External Lib
 #define GLM_FORCE_RADIANS
@@ -11,6 +19,10 @@
 #include <glm/gtc/constants.hpp>
 
 // STD Lib
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <memory>
 
 namespace Graphic
@@ -26,6 +38,7 @@ const float strengthGravity;
 // substeps is how many intervals to divide the forward time step in. More substeps result in a
 // more stable simulation, but takes longer to compute
 void update(std::vector<GameObject>& objs, float dt, unsigned int substeps = 1) {
+    PROFILE_SCOPE("GravityPhysicsSystem::update");
     const float stepDelta = dt / substeps;
     for (int i = 0; i < substeps; i++) {
     stepSimulation(objs, stepDelta);
@@ -75,6 +88,7 @@ void update(
     const GravityPhysicsSystem& physicsSystem,
     std::vector<GameObject>& physicsObjs,
     std::vector<GameObject>& vectorField) {
+    PROFILE_SCOPE("Vec2FieldSystem::update");
     // For each field line we caluclate the net graviation force for that point in space
     for (auto& vf : vectorField) {
     glm::vec2 direction{};
@@ -128,8 +142,158 @@ std::unique_ptr<VkModel> createCircleModel(VkDeviceInstance* device, uint32_t nu
 }
 
 
-Application::Application() 
+ApplicationConfig ParseApplicationConfig(int argc, const char* argv[])
 {
+    ApplicationConfig config = {};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1) < argc;
+
+        if (strcmp(arg, "--headless") == 0)
+        {
+            config.headless = true;
+        }
+        else if (strcmp(arg, "--warm-pipeline-cache") == 0)
+        {
+            config.warmPipelineCache = true;
+        }
+        else if ((strcmp(arg, "--frames") == 0) && hasValue)
+        {
+            config.frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((strcmp(arg, "--capture") == 0) && hasValue)
+        {
+            config.capture = true;
+            config.captureDir = argv[++i];
+        }
+        else if ((strcmp(arg, "--capture-format") == 0) && hasValue)
+        {
+            if (!Core::ParseImageFileFormat(argv[++i], config.captureFormat))
+            {
+                LOG_WARN("Application: Unknown capture format {}, using png", argv[i]);
+                config.captureFormat = Core::ImageFileFormat::Png;
+            }
+        }
+        else if ((strcmp(arg, "--batch") == 0) && hasValue)
+        {
+            config.batch = true;
+            config.headless = true;
+            config.capture = true;
+            config.frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((strcmp(arg, "--width") == 0) && hasValue)
+        {
+            config.width = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((strcmp(arg, "--height") == 0) && hasValue)
+        {
+            config.height = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((strcmp(arg, "--frames-in-flight") == 0) && hasValue)
+        {
+            config.framesInFlight = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((strcmp(arg, "--swapchain-images") == 0) && hasValue)
+        {
+            config.swapChainImages = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((strcmp(arg, "--gpu") == 0) && hasValue)
+        {
+            config.gpu = argv[++i];
+        }
+        else if ((strcmp(arg, "--mesh") == 0) && hasValue)
+        {
+            config.meshPath = argv[++i];
+        }
+        else if ((strcmp(arg, "--texture") == 0) && hasValue)
+        {
+            config.texturePath = argv[++i];
+        }
+        else if ((strcmp(arg, "--assets") == 0) && hasValue)
+        {
+            config.assetArchive = argv[++i];
+        }
+        else
+        {
+            LOG_WARN("Application: Ignoring unknown argument {}", arg);
+        }
+    }
+
+    if ((config.width == 0) || (config.height == 0))
+    {
+        LOG_WARN("Application: Invalid size, using {}x{}", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+        config.width = DISPLAY_WIDTH;
+        config.height = DISPLAY_HEIGHT;
+    }
+
+    if (config.headless && (config.frameCount == 0))
+    {
+        config.frameCount = HEADLESS_DEFAULT_FRAMES;
+    }
+
+    // Next to the executable, so installs don't depend on the working directory.
+    // argv[0] is only a fallback, it has no directory when started through PATH.
+    if (config.assetArchive.empty())
+    {
+        std::filesystem::path directory = Core::GetExecutableDirectory();
+        if (directory.empty() && (argc > 0))
+        {
+            directory = std::filesystem::path(argv[0]).parent_path();
+        }
+        config.assetArchive = (directory / ASSET_ARCHIVE_NAME).string();
+    }
+
+    return config;
+}
+
+//----------------------------------------------------------------------------//
+
+static std::unique_ptr<WindowHandler> CreateWindowHandler(const ApplicationConfig& config)
+{
+    if (config.headless) { return nullptr; }
+
+    return std::make_unique<WindowHandler>(
+        static_cast<int32_t>(config.width),
+        static_cast<int32_t>(config.height));
+}
+
+// Arrow keys pan, Q/E zoom out/in. Speeds are relative to the visible area.
+static void UpdateCamera2DInput(GLFWwindow* window, float dt, glm::vec2& center, float& zoom)
+{
+    glm::vec2 move{0.0f};
+    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) { move.x -= 1.0f; }
+    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) { move.x += 1.0f; }
+    if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) { move.y -= 1.0f; }
+    if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) { move.y += 1.0f; }
+    center += move * (dt / zoom);
+
+    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) { zoom /= (1.0f + dt); }
+    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) { zoom *= (1.0f + dt); }
+    zoom = glm::clamp(zoom, 0.05f, 50.0f);
+}
+
+Application::Application(const ApplicationConfig& config)
+    : config_(config),
+      window_(CreateWindowHandler(config)),
+      deviceInst_(window_.get(), config.gpu),
+      pipelineBuilder_(&deviceInst_),
+      renderer_(window_.get(), &deviceInst_, VkExtent2D{config.width, config.height})
+{
+    // Loose files under the project directory serve whatever the archive doesn't have.
+    // Note : PROJECT_DIRECTORY macro is added by CMakeList.txt
+    Core::VirtualFileSystem::Get().SetLooseRoot(PROJECT_DIRECTORY);
+    std::error_code errCode;
+    if (!config.assetArchive.empty() && std::filesystem::exists(config.assetArchive, errCode))
+    {
+        Core::VirtualFileSystem::Get().Mount(config.assetArchive);
+    }
+
+    // Applied by the first BeginFrame
+    renderer_.SetFramesInFlight(config.framesInFlight);
+    renderer_.SetSwapChainImageCount(config.swapChainImages);
+
     LoadGameObjects();
 }
 
@@ -180,35 +344,193 @@ void Application::RenderLoop()
     
     GravityPhysicsSystem gravitySystem{0.81f};
     Vec2FieldSystem vecFieldSystem{};
-    SimpleRenderPipeline simpleRender(&deviceInst_, renderer_.GetRenderPass());
+    // Compiled off the frame path, frames render without it until it is ready.
+    // Headless runs compile up front so that every rendered frame is complete.
+    AsyncPipelineBuilder* pipelineBuilder = config_.headless ? nullptr : &pipelineBuilder_;
+    SimpleRenderPipeline simpleRender(
+        &deviceInst_, renderer_.GetGlobalUniforms(), renderer_.GetRenderTarget(), pipelineBuilder);
+    simpleRender.SetProfiler(renderer_.GetGpuProfiler());
+    // Evaluates vectorField on the GPU, Vec2FieldSystem stays as the fallback.
+    VectorFieldPipeline vectorFieldPipeline(
+        &deviceInst_, renderer_.GetGlobalUniforms(), renderer_.GetRenderTarget(), static_cast<uint32_t>(gridCount));
+    vectorFieldPipeline.SetProfiler(renderer_.GetGpuProfiler());
+    RenderGraph renderGraph(&deviceInst_, &renderer_);
+    TextureManager textureManager(&deviceInst_, &renderer_);
+    SpriteRenderPipeline spriteRender(
+        &deviceInst_, renderer_.GetGlobalUniforms(), &textureManager, renderer_.GetRenderTarget());
+    spriteRender.SetProfiler(renderer_.GetGpuProfiler());
+
+    // Streams in while the scene keeps rendering, drawn white until its first mip lands.
+    std::vector<GameObject> sprites{};
+    TextureHandle spriteTexture{};
+    if (!config_.texturePath.empty())
+    {
+        auto quadVert = createSquareModel({.0f, .0f});
+        auto sprite = GameObject::CreateGameObject();
+        sprite.model = std::make_shared<VkModel>(&deviceInst_, quadVert);
+        sprite.color = glm::vec3(1.0f);
+        sprite.transform2d.scale = glm::vec2(.5f);
+        sprites.push_back(std::move(sprite));
+        spriteTexture = textureManager.Load(config_.texturePath);
+    }
+
+    // Same for the model uploads, otherwise they show up a frame or two late.
+    if (config_.headless)
+    {
+        TransferQueue* transferQueue = deviceInst_.GetTransferQueue();
+        transferQueue->WaitReady({transferQueue->GetTimeline()->GetSubmittedValue()});
+    }
 
-    glfwSetKeyCallback(window_.GetWindowHandlerPointer(), Input::KeyCallBack);
+    if (window_ != nullptr)
+    {
+        glfwSetKeyCallback(window_->GetWindowHandlerPointer(), Input::KeyCallBack);
+    }
+    PROFILE_THREAD_NAME("Main");
 
-    while (!window_.ShouldCloseWindow())
+    if (config_.batch)
     {
-        glfwPollEvents();
+        // Nothing waits on a display, let the queue fill up.
+        renderer_.SetPresentMode(PresentMode::Immediate);
+        renderer_.SetFrameLatencyLimit(0);
+    }
 
-        if (auto commandBuffer = renderer_.BeginFrame())
+    if (config_.capture)
+    {
+        FrameCaptureConfig captureConfig = {};
+        captureConfig.outputDir = config_.captureDir;
+        captureConfig.format = config_.captureFormat;
+        renderer_.StartCapture(captureConfig);
+    }
+
+    // The scene lives in [-1, 1], one orthographic camera moves over it.
+    Camera camera{};
+    glm::vec2 cameraCenter{0.0f};
+    float cameraZoom = 1.0f;
+
+    uint64_t renderedFrames = 0;
+    auto loopStart = std::chrono::steady_clock::now();
+    auto lastFrameTime = loopStart;
+
+    while (((window_ == nullptr) || !window_->ShouldCloseWindow()) &&
+           ((config_.frameCount == 0) || (renderedFrames < config_.frameCount)))
+    {
+        PROFILE_COLLECT();
+
+        // Wait for the GPU queue before sampling input to keep latency low.
+        renderer_.ThrottleFrameLatency();
+        if (window_ != nullptr)
+        {
+            glfwPollEvents();
+        }
+
+        auto frameTime = std::chrono::steady_clock::now();
+        float deltaTime = std::chrono::duration<float>(frameTime - lastFrameTime).count();
+        lastFrameTime = frameTime;
+
+        if (window_ != nullptr)
         {
-            // More future pipelines to be added shadow pass etc
+            UpdateCamera2DInput(window_->GetWindowHandlerPointer(), deltaTime, cameraCenter, cameraZoom);
+        }
+        camera.Set2DView(cameraCenter, cameraZoom, renderer_.GetAspectRatio());
 
-            // Update physics
-            gravitySystem.update(physicsObjects, 1.0f / 60, 5);
-            vecFieldSystem.update(gravitySystem, physicsObjects, vectorField);
+        // Update physics
+        gravitySystem.update(physicsObjects, 1.0f / 60, 5);
 
-            renderer_.BeginSwapChainRenderPass(commandBuffer);
+        // Recorded before the frame, so the field overlaps whatever the graphics queue
+        // is still busy with. The frame waits for it before its vertex shaders.
+        bool gpuVectorField = vectorFieldPipeline.IsReady();
+        if (gpuVectorField)
+        {
+            VkCommandBuffer computeBuffer = renderer_.BeginCompute();
+            vectorFieldPipeline.Dispatch(
+                computeBuffer, renderer_.GetCurrentFrameIndex(), physicsObjects, gravitySystem.strengthGravity);
+            renderer_.SubmitCompute(VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT);
+        }
+        else
+        {
+            vecFieldSystem.update(gravitySystem, physicsObjects, vectorField);
+        }
 
-            // simpleRender.RenderGameObjects(commandBuffer, gameObjects_);
-            simpleRender.RenderGameObjects(commandBuffer, physicsObjects);
-            simpleRender.RenderGameObjects(commandBuffer, vectorField);
+        if (auto commandBuffer = renderer_.BeginFrame())
+        {
+            renderer_.UpdateGlobalUniforms(
+                camera, std::chrono::duration<float>(frameTime - loopStart).count(), deltaTime);
+
+            // Finished texture uploads get their mips before any pass samples them.
+            textureManager.Update(commandBuffer);
+
+            // Keep the sprite at the texture's aspect ratio once its size is known.
+            VkExtent2D spriteExtent = textureManager.GetExtent(spriteTexture);
+            if (!sprites.empty() && (spriteExtent.width > 0))
+            {
+                sprites[0].transform2d.scale.y =
+                    sprites[0].transform2d.scale.x * spriteExtent.height / static_cast<float>(spriteExtent.width);
+            }
+
+            // Further passes (shadow, post processing) go in the graph as well, barriers
+            // and transient images are handled there.
+            renderGraph.Reset();
+            renderGraph.AddPass("MainPass", RGPassType::Raster,
+                [&](VkCommandBuffer passCmd, const RenderGraph&) {
+                    // simpleRender.RenderGameObjects(passCmd, gameObjects_);
+                    simpleRender.RenderGameObjects(passCmd, physicsObjects, {}, "PhysicsObjects");
+                    if (gpuVectorField)
+                    {
+                        vectorFieldPipeline.Render(passCmd, *squareModel, glm::vec3(1.0f));
+                    }
+                    else
+                    {
+                        simpleRender.RenderGameObjects(passCmd, vectorField, {}, "VectorField");
+                    }
+                    simpleRender.RenderGameObjects(
+                        passCmd, importedObjects_, ShaderPermutation{ColorSource::Vertex, ShapeMode::Mesh}, "ImportedMeshes");
+                    spriteRender.RenderSprites(passCmd, sprites, spriteTexture);
+                })
+                .Write(renderGraph.GetBackbuffer(), RGAccess::ColorAttachment);
+            renderGraph.Execute(commandBuffer);
 
-            renderer_.EndSwapChainRenderPass(commandBuffer);
             renderer_.EndFrame();
+            renderedFrames++;
         }
     }
 
     vkDeviceWaitIdle(deviceInst_.GetLogicalDevice());
+    renderer_.StopCapture();
+
+    double loopSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loopStart).count();
+    LOG_INFO("Application: Rendered {} frames in {:.2f} s ({:.1f} fps)",
+             renderedFrames, loopSeconds, (loopSeconds > 0.0) ? (renderedFrames / loopSeconds) : 0.0);
+
+    PresentStats presentStats = renderer_.GetPresentStats();
+    LOG_INFO("Application: Present latency over {} frames, submit->present {:.2f} ms, "
+             "submit->display {:.2f} ms (max {:.2f} ms, {} displayed)",
+             presentStats.frameCount, presentStats.avgSubmitToPresentMs,
+             presentStats.avgSubmitToDisplayMs, presentStats.maxSubmitToDisplayMs,
+             presentStats.displayedCount);
+
+    GpuProfiler* gpuProfiler = renderer_.GetGpuProfiler();
+    LOG_INFO("Application: GPU frame {:.3f} ms", gpuProfiler->GetLastFrameGpuMs());
+    for (const GpuScopeResult& scope : gpuProfiler->GetLastResults())
+    {
+        LOG_INFO("Application:   {:>{}}{} {:.3f} ms, {} vertex / {} fragment invocations",
+                 "", scope.depth * 2, scope.name, scope.gpuMs,
+                 scope.vertexInvocations, scope.fragmentInvocations);
+    }
+}
+
+void Application::WarmPipelineCache()
+{
+    {
+        SimpleRenderPipeline simpleRender(&deviceInst_, renderer_.GetGlobalUniforms(), renderer_.GetRenderTarget());
+
+        // Variants used at runtime, compiled synchronously here.
+        simpleRender.GetPipeline(ShaderPermutation{ColorSource::PushConstant, ShapeMode::Mesh});
+        simpleRender.GetPipeline(ShaderPermutation{ColorSource::Vertex, ShapeMode::Mesh});
+        simpleRender.GetPipeline(ShaderPermutation{ColorSource::PushConstant, ShapeMode::SdfCircle});
+    }
 
+    vkDeviceWaitIdle(deviceInst_.GetLogicalDevice());
+    LOG_INFO("Application: Pipeline cache warmed");
 }
 
 void Application::LoadGameObjects()
@@ -228,6 +550,17 @@ void Application::LoadGameObjects()
     triangle.transform2d.rotation = .25f * glm::two_pi<float>();
 
     gameObjects_.push_back(std::move(triangle));
+
+    if (!config_.meshPath.empty())
+    {
+        MeshImporter importer;
+        auto mesh = GameObject::CreateGameObject();
+        mesh.model = importer.LoadModel(&deviceInst_, config_.meshPath);
+        if (mesh.model)
+        {
+            importedObjects_.push_back(std::move(mesh));
+        }
+    }
 }
 
 } // namespace Graphic
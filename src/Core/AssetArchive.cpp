@@ -0,0 +1,275 @@
+#include <Core/AssetArchive.ipp>
+#include <Core/Lz4.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Core
+{
+
+static uint64_t AlignArchiveOffset(uint64_t offset)
+{
+    return (offset + ASSET_ARCHIVE_ALIGNMENT - 1) & ~(ASSET_ARCHIVE_ALIGNMENT - 1);
+}
+
+std::string NormalizeAssetPath(std::string_view path)
+{
+    std::string normalized(path);
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+
+    size_t start = 0;
+    while (start < normalized.size())
+    {
+        if (normalized[start] == '/') { start++; }
+        else if (normalized.compare(start, 2, "./") == 0) { start += 2; }
+        else { break; }
+    }
+    return normalized.substr(start);
+}
+
+uint64_t HashAssetPath(std::string_view normalizedPath)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : normalizedPath)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+//----------------------------------------------------------------------------//
+
+bool AssetArchive::Open(const std::string& filePath)
+{
+    if (!file_.Open(filePath)) { return false; }
+    filePath_ = filePath;
+
+    const uint8_t* data = file_.GetData();
+    size_t size = file_.GetSize();
+
+    AssetArchiveHeader header;
+    bool valid = size >= sizeof(header);
+    if (valid)
+    {
+        std::memcpy(&header, data, sizeof(header));
+        valid = (header.magic == ASSET_ARCHIVE_MAGIC) && (header.version == ASSET_ARCHIVE_VERSION);
+    }
+
+    uint64_t indexBytes = static_cast<uint64_t>(header.entryCount) * sizeof(AssetArchiveEntry);
+    valid = valid && ((header.indexOffset % alignof(AssetArchiveEntry)) == 0) &&
+            (header.indexOffset <= size) && (indexBytes <= (size - header.indexOffset)) &&
+            (header.pathOffset <= size);
+
+    if (!valid)
+    {
+        LOG_ERROR("Asset Archive: {} is not a version {} archive or is truncated", filePath, ASSET_ARCHIVE_VERSION);
+        file_.Close();
+        return false;
+    }
+
+    entries_ = reinterpret_cast<const AssetArchiveEntry*>(data + header.indexOffset);
+    entryCount_ = header.entryCount;
+    paths_ = reinterpret_cast<const char*>(data + header.pathOffset);
+    uint64_t pathBytes = size - header.pathOffset;
+
+    // Checked once here so lookups and reads can trust the index.
+    for (uint32_t i = 0; i < entryCount_; ++i)
+    {
+        const AssetArchiveEntry& entry = entries_[i];
+        bool entryValid =
+            (entry.offset <= size) && (entry.storedSize <= (size - entry.offset)) &&
+            ((static_cast<uint64_t>(entry.pathOffset) + entry.pathLength) <= pathBytes) &&
+            ((i == 0) || (entries_[i - 1].pathHash <= entry.pathHash));
+
+        if (entry.compression == static_cast<uint8_t>(AssetCompression::None))
+        {
+            entryValid = entryValid && (entry.storedSize == entry.size);
+        }
+        else if (entry.compression == static_cast<uint8_t>(AssetCompression::Lz4))
+        {
+            // Read allocates 'size' up front, it can't be larger than LZ4 can produce.
+            entryValid = entryValid && (entry.size <= (entry.storedSize * LZ4_MAX_EXPANSION));
+        }
+        else
+        {
+            entryValid = false;
+        }
+
+        if (!entryValid)
+        {
+            LOG_ERROR("Asset Archive: Entry {} of {} is corrupted", i, filePath);
+            entries_ = nullptr;
+            entryCount_ = 0;
+            file_.Close();
+            return false;
+        }
+    }
+
+    LOG_INFO("Asset Archive: Mounted {} ({} entries)", filePath, entryCount_);
+    return true;
+}
+
+const AssetArchiveEntry* AssetArchive::Find(std::string_view path) const
+{
+    std::string normalized = NormalizeAssetPath(path);
+    uint64_t hash = HashAssetPath(normalized);
+
+    const AssetArchiveEntry* end = entries_ + entryCount_;
+    const AssetArchiveEntry* entry = std::lower_bound(entries_, end, hash,
+        [](const AssetArchiveEntry& lhs, uint64_t value) { return lhs.pathHash < value; });
+
+    // Colliding hashes are next to each other, the stored path settles it.
+    for (; (entry != end) && (entry->pathHash == hash); ++entry)
+    {
+        if (GetPath(*entry) == normalized)
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+bool AssetArchive::Read(const AssetArchiveEntry& entry, std::vector<char>& data) const
+{
+    data.resize(static_cast<size_t>(entry.size));
+    const uint8_t* stored = GetStoredData(entry);
+
+    if (entry.compression == static_cast<uint8_t>(AssetCompression::None))
+    {
+        if (!data.empty())
+        {
+            std::memcpy(data.data(), stored, data.size());
+        }
+        return true;
+    }
+
+    if (!Lz4Decompress(stored, static_cast<size_t>(entry.storedSize), reinterpret_cast<uint8_t*>(data.data()), data.size()))
+    {
+        LOG_ERROR("Asset Archive: Corrupted data for {} in {}", GetPath(entry), filePath_);
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------//
+
+bool WriteAssetArchive(const std::string& filePath, const std::vector<AssetArchiveInput>& inputs, float minSavings)
+{
+    struct PackedEntry
+    {
+        std::string path;
+        const AssetArchiveInput* input = nullptr;
+        std::vector<uint8_t> compressed; // Empty -> stored as is
+        AssetArchiveEntry entry;
+    };
+
+    std::vector<PackedEntry> packed(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        PackedEntry& item = packed[i];
+        item.path = NormalizeAssetPath(inputs[i].path);
+        item.input = &inputs[i];
+        item.entry.pathHash = HashAssetPath(item.path);
+        item.entry.size = inputs[i].data.size();
+
+        if (item.path.size() > UINT16_MAX)
+        {
+            LOG_ERROR("Asset Archive: Path too long {}", item.path);
+            return false;
+        }
+
+        size_t inputSize = inputs[i].data.size();
+        item.compressed.resize(Lz4CompressBound(inputSize));
+        size_t compressedSize = Lz4Compress(inputs[i].data.data(), inputSize, item.compressed.data(), item.compressed.size());
+        if ((compressedSize == 0) || (static_cast<float>(compressedSize) > (static_cast<float>(inputSize) * (1.0f - minSavings))))
+        {
+            compressedSize = 0;
+        }
+        item.compressed.resize(compressedSize);
+    }
+
+    std::sort(packed.begin(), packed.end(), [](const PackedEntry& lhs, const PackedEntry& rhs) {
+        return (lhs.entry.pathHash != rhs.entry.pathHash) ? (lhs.entry.pathHash < rhs.entry.pathHash) : (lhs.path < rhs.path);
+    });
+
+    for (size_t i = 1; i < packed.size(); ++i)
+    {
+        if (packed[i].path == packed[i - 1].path)
+        {
+            LOG_ERROR("Asset Archive: {} was added twice", packed[i].path);
+            return false;
+        }
+    }
+
+    // Data, then the index and the path table.
+    AssetArchiveHeader header;
+    header.entryCount = static_cast<uint32_t>(packed.size());
+
+    uint64_t offset = AlignArchiveOffset(sizeof(header));
+    uint32_t pathOffset = 0;
+    for (PackedEntry& item : packed)
+    {
+        bool compressed = !item.compressed.empty();
+        item.entry.compression = static_cast<uint8_t>(compressed ? AssetCompression::Lz4 : AssetCompression::None);
+        item.entry.storedSize = compressed ? item.compressed.size() : item.input->data.size();
+        item.entry.offset = offset;
+        item.entry.pathOffset = pathOffset;
+        item.entry.pathLength = static_cast<uint16_t>(item.path.size());
+
+        offset = AlignArchiveOffset(offset + item.entry.storedSize);
+        pathOffset += static_cast<uint32_t>(item.path.size());
+    }
+    header.indexOffset = offset;
+    header.pathOffset = header.indexOffset + (packed.size() * sizeof(AssetArchiveEntry));
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Asset Archive: Failed to create {}", filePath);
+        return false;
+    }
+
+    uint64_t written = 0;
+    auto writeAt = [&](uint64_t position, const void* data, uint64_t byteSize) {
+        static const char zeros[ASSET_ARCHIVE_ALIGNMENT] = {};
+        while (written < position)
+        {
+            uint64_t padding = std::min<uint64_t>(position - written, sizeof(zeros));
+            file.write(zeros, static_cast<std::streamsize>(padding));
+            written += padding;
+        }
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(byteSize));
+        written += byteSize;
+    };
+
+    writeAt(0, &header, sizeof(header));
+    for (const PackedEntry& item : packed)
+    {
+        const void* data = item.compressed.empty() ? static_cast<const void*>(item.input->data.data()) : item.compressed.data();
+        writeAt(item.entry.offset, data, item.entry.storedSize);
+    }
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+        writeAt(header.indexOffset + (i * sizeof(AssetArchiveEntry)), &packed[i].entry, sizeof(AssetArchiveEntry));
+    }
+    for (const PackedEntry& item : packed)
+    {
+        writeAt(header.pathOffset + item.entry.pathOffset, item.path.data(), item.path.size());
+    }
+
+    if (!file)
+    {
+        LOG_ERROR("Asset Archive: Failed to write {}", filePath);
+        return false;
+    }
+    return true;
+}
+
+} // namespace Core
@@ -0,0 +1,170 @@
+#include <Core/BlockDecoder.ipp>
+#include <Core/ImageReader.ipp>
+
+// STD Lib
+#include <algorithm>
+
+namespace Core
+{
+
+// RGB565 to RGB888, replicating the high bits into the low ones.
+static void UnpackColor565(uint16_t color, uint8_t* rgb)
+{
+    uint32_t r = (color >> 11) & 0x1F;
+    uint32_t g = (color >> 5) & 0x3F;
+    uint32_t b = color & 0x1F;
+    rgb[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+    rgb[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+    rgb[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+}
+
+// 8 byte color block into 16 RGBA texels. BC2/BC3 always use the 4 color mode, their
+// alpha is written afterwards.
+static void DecodeColorBlock(const uint8_t* block, bool allowPunchThrough, uint8_t texels[16][4])
+{
+    uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+
+    uint8_t palette[4][4] = {};
+    UnpackColor565(color0, palette[0]);
+    UnpackColor565(color1, palette[1]);
+    palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+        if ((color0 > color1) || !allowPunchThrough)
+        {
+            palette[2][c] = static_cast<uint8_t>(((2 * palette[0][c]) + palette[1][c] + 1) / 3);
+            palette[3][c] = static_cast<uint8_t>((palette[0][c] + (2 * palette[1][c]) + 1) / 3);
+        }
+        else
+        {
+            palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c] + 1) / 2);
+            palette[3][c] = 0;
+        }
+    }
+    if ((color0 <= color1) && allowPunchThrough)
+    {
+        palette[3][3] = 0;
+    }
+
+    uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        std::copy(palette[(indices >> (i * 2)) & 0x3], palette[(indices >> (i * 2)) & 0x3] + 4, texels[i]);
+    }
+}
+
+// 8 byte BC4 style block (two endpoints, 3 bit indices) into one channel of 16 texels.
+static void DecodeChannelBlock(const uint8_t* block, uint8_t texels[16][4], uint32_t channel)
+{
+    uint32_t value0 = block[0];
+    uint32_t value1 = block[1];
+
+    uint8_t palette[8];
+    palette[0] = static_cast<uint8_t>(value0);
+    palette[1] = static_cast<uint8_t>(value1);
+    if (value0 > value1)
+    {
+        for (uint32_t i = 1; i < 7; ++i)
+        {
+            palette[i + 1] = static_cast<uint8_t>((((7 - i) * value0) + (i * value1) + 3) / 7);
+        }
+    }
+    else
+    {
+        for (uint32_t i = 1; i < 5; ++i)
+        {
+            palette[i + 1] = static_cast<uint8_t>((((5 - i) * value0) + (i * value1) + 2) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    uint64_t indices = 0;
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+    }
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        texels[i][channel] = palette[(indices >> (i * 3)) & 0x7];
+    }
+}
+
+static void DecodeBlock(BlockFormat format, const uint8_t* block, uint8_t texels[16][4])
+{
+    switch (format)
+    {
+    case BlockFormat::BC1:
+        DecodeColorBlock(block, true, texels);
+        break;
+
+    case BlockFormat::BC2:
+        DecodeColorBlock(block + 8, false, texels);
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            uint32_t alpha = (block[i / 2] >> ((i % 2) * 4)) & 0xF;
+            texels[i][3] = static_cast<uint8_t>((alpha << 4) | alpha);
+        }
+        break;
+
+    case BlockFormat::BC3:
+        DecodeColorBlock(block + 8, false, texels);
+        DecodeChannelBlock(block, texels, 3);
+        break;
+
+    case BlockFormat::BC4:
+    case BlockFormat::BC5:
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            texels[i][0] = texels[i][1] = texels[i][2] = 0;
+            texels[i][3] = 255;
+        }
+        DecodeChannelBlock(block, texels, 0);
+        if (format == BlockFormat::BC5)
+        {
+            DecodeChannelBlock(block + 8, texels, 1);
+        }
+        break;
+    }
+}
+
+bool DecodeBlocks(BlockFormat format, const uint8_t* data, size_t size, uint32_t width, uint32_t height, ImageData& image)
+{
+    uint32_t blocksX = (width + 3) / 4;
+    uint32_t blocksY = (height + 3) / 4;
+    size_t blockSize = GetBlockByteSize(format);
+    if ((width == 0) || (height == 0) || (size < (static_cast<size_t>(blocksX) * blocksY * blockSize)))
+    {
+        return false;
+    }
+
+    image.width = width;
+    image.height = height;
+    image.rgba.resize(image.GetByteSize());
+
+    uint8_t texels[16][4];
+    for (uint32_t by = 0; by < blocksY; ++by)
+    {
+        for (uint32_t bx = 0; bx < blocksX; ++bx)
+        {
+            DecodeBlock(format, data + (((static_cast<size_t>(by) * blocksX) + bx) * blockSize), texels);
+
+            // Edge blocks cover texels past the level size, those are dropped.
+            uint32_t rows = std::min(4u, height - (by * 4));
+            uint32_t columns = std::min(4u, width - (bx * 4));
+            for (uint32_t y = 0; y < rows; ++y)
+            {
+                uint8_t* dst = &image.rgba[((static_cast<size_t>((by * 4) + y) * width) + (bx * 4)) * 4];
+                for (uint32_t x = 0; x < columns; ++x)
+                {
+                    std::copy(texels[(y * 4) + x], texels[(y * 4) + x] + 4, dst + (x * 4));
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace Core
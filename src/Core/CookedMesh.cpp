@@ -0,0 +1,139 @@
+#include <Core/CookedMesh.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Core
+{
+
+// Offset + size inside the file, without overflowing.
+static bool IsInFile(uint64_t offset, uint64_t byteSize, size_t fileSize)
+{
+    return (offset <= fileSize) && (byteSize <= (fileSize - offset)) && ((offset % COOKED_MESH_ALIGNMENT) == 0);
+}
+
+bool ParseCookedMesh(
+    const uint8_t* data,
+    size_t size,
+    CookedVertexLayout layout,
+    uint32_t vertexStride,
+    CookedMeshView& view)
+{
+    if (size < sizeof(CookedMeshHeader))
+    {
+        LOG_ERROR("Cooked Mesh: File is smaller than its header");
+        return false;
+    }
+
+    CookedMeshHeader& header = view.header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if ((header.magic != COOKED_MESH_MAGIC) || (header.version != COOKED_MESH_VERSION))
+    {
+        LOG_ERROR("Cooked Mesh: Unknown magic or version {}, expected {}", header.version, COOKED_MESH_VERSION);
+        return false;
+    }
+
+    if ((header.vertexLayout != static_cast<uint32_t>(layout)) || (header.vertexStride != vertexStride))
+    {
+        LOG_ERROR("Cooked Mesh: Cooked for vertex layout {} ({} bytes), expected {} ({} bytes), re-cook it",
+            header.vertexLayout, header.vertexStride, static_cast<uint32_t>(layout), vertexStride);
+        return false;
+    }
+
+    uint64_t vertexBytes = static_cast<uint64_t>(header.vertexCount) * header.vertexStride;
+    uint64_t indexBytes = static_cast<uint64_t>(header.indexCount) * sizeof(uint32_t);
+    uint64_t lodBytes = static_cast<uint64_t>(header.lodCount) * sizeof(CookedMeshLod);
+
+    if ((header.vertexCount == 0) || (header.lodCount == 0) ||
+        !IsInFile(header.vertexOffset, vertexBytes, size) ||
+        !IsInFile(header.indexOffset, indexBytes, size) ||
+        !IsInFile(header.lodOffset, lodBytes, size))
+    {
+        LOG_ERROR("Cooked Mesh: Truncated file or blobs out of bounds");
+        return false;
+    }
+
+    view.vertexData = data + header.vertexOffset;
+    view.indexData = reinterpret_cast<const uint32_t*>(data + header.indexOffset);
+    view.lods = reinterpret_cast<const CookedMeshLod*>(data + header.lodOffset);
+
+    for (uint32_t i = 0; i < header.lodCount; ++i)
+    {
+        const CookedMeshLod& lod = view.lods[i];
+        if ((lod.firstIndex > header.indexCount) || (lod.indexCount > (header.indexCount - lod.firstIndex)) ||
+            ((lod.indexCount % 3) != 0))
+        {
+            LOG_ERROR("Cooked Mesh: LOD {} is out of the index blob", i);
+            return false;
+        }
+    }
+
+    // The pages are read by the upload copy right after anyway, this only warms them up.
+    const uint32_t* indexEnd = view.indexData + header.indexCount;
+    if (std::any_of(view.indexData, indexEnd, [&](uint32_t index) { return index >= header.vertexCount; }))
+    {
+        LOG_ERROR("Cooked Mesh: Index out of the {} vertices, re-cook it", header.vertexCount);
+        return false;
+    }
+    return true;
+}
+
+bool WriteCookedMesh(
+    const std::string& filePath,
+    CookedMeshHeader header,
+    const void* vertexData,
+    const std::vector<uint32_t>& indices,
+    const std::vector<CookedMeshLod>& lods)
+{
+    uint64_t vertexBytes = static_cast<uint64_t>(header.vertexCount) * header.vertexStride;
+    uint64_t indexBytes = indices.size() * sizeof(uint32_t);
+    uint64_t lodBytes = lods.size() * sizeof(CookedMeshLod);
+
+    header.magic = COOKED_MESH_MAGIC;
+    header.version = COOKED_MESH_VERSION;
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    header.lodCount = static_cast<uint32_t>(lods.size());
+    header.vertexOffset = AlignCookedOffset(sizeof(CookedMeshHeader));
+    header.indexOffset = AlignCookedOffset(header.vertexOffset + vertexBytes);
+    header.lodOffset = AlignCookedOffset(header.indexOffset + indexBytes);
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Cooked Mesh: Failed to create {}", filePath);
+        return false;
+    }
+
+    uint64_t written = 0;
+    auto writeAt = [&](uint64_t offset, const void* data, uint64_t byteSize) {
+        static const char zeros[COOKED_MESH_ALIGNMENT] = {};
+        while (written < offset)
+        {
+            uint64_t padding = std::min<uint64_t>(offset - written, sizeof(zeros));
+            file.write(zeros, static_cast<std::streamsize>(padding));
+            written += padding;
+        }
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(byteSize));
+        written += byteSize;
+    };
+
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.vertexOffset, vertexData, vertexBytes);
+    writeAt(header.indexOffset, indices.data(), indexBytes);
+    writeAt(header.lodOffset, lods.data(), lodBytes);
+
+    if (!file)
+    {
+        LOG_ERROR("Cooked Mesh: Failed to write {}", filePath);
+        return false;
+    }
+    return true;
+}
+
+} // namespace Core
@@ -0,0 +1,37 @@
+#include <Core/DeferredDeletionQueue.ipp>
+
+namespace Core
+{
+
+DeferredDeletionQueue::~DeferredDeletionQueue()
+{
+    FlushAll();
+}
+
+void DeferredDeletionQueue::Push(uint64_t lastUsedFrame, std::function<void()> deleter)
+{
+    pending_.push_back({lastUsedFrame, std::move(deleter)});
+}
+
+void DeferredDeletionQueue::Flush(uint64_t completedFrame)
+{
+    while (!pending_.empty() && (pending_.front().frame <= completedFrame))
+    {
+        // Pop first, the deleter may push new entries.
+        auto deleter = std::move(pending_.front().deleter);
+        pending_.pop_front();
+        deleter();
+    }
+}
+
+void DeferredDeletionQueue::FlushAll()
+{
+    while (!pending_.empty())
+    {
+        auto deleter = std::move(pending_.front().deleter);
+        pending_.pop_front();
+        deleter();
+    }
+}
+
+} // namespace Core
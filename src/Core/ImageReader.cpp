@@ -0,0 +1,262 @@
+#include <Core/ImageReader.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+namespace Core
+{
+
+// Guards against corrupted headers asking for absurd allocations.
+constexpr uint32_t MAX_IMAGE_DIMENSION = 16384;
+
+static bool IsValidImageSize(uint32_t width, uint32_t height)
+{
+    return (width > 0) && (height > 0) && (width <= MAX_IMAGE_DIMENSION) && (height <= MAX_IMAGE_DIMENSION);
+}
+
+//----------------------------------------------------------------------------//
+
+// Skips whitespace and '#' comments, then parses an unsigned decimal.
+static bool ReadPpmValue(const uint8_t* data, size_t size, size_t& offset, uint32_t& value)
+{
+    while (offset < size)
+    {
+        if (data[offset] == '#')
+        {
+            while ((offset < size) && (data[offset] != '\n')) { offset++; }
+        }
+        else if (std::isspace(data[offset]))
+        {
+            offset++;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if ((offset >= size) || !std::isdigit(data[offset])) { return false; }
+
+    value = 0;
+    while ((offset < size) && std::isdigit(data[offset]))
+    {
+        value = (value * 10) + (data[offset] - '0');
+        if (value > MAX_IMAGE_DIMENSION) { return false; }
+        offset++;
+    }
+    return true;
+}
+
+static bool DecodePpm(const uint8_t* data, size_t size, ImageData& image)
+{
+    size_t offset = 2; // "P6"
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t maxValue = 0;
+
+    if (!ReadPpmValue(data, size, offset, width) ||
+        !ReadPpmValue(data, size, offset, height) ||
+        !ReadPpmValue(data, size, offset, maxValue))
+    {
+        return false;
+    }
+
+    // A single whitespace separates the header from the pixels.
+    offset++;
+
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    if (!IsValidImageSize(width, height) || (maxValue != 255) || ((size - std::min(size, offset)) < (pixelCount * 3)))
+    {
+        return false;
+    }
+
+    image.width = width;
+    image.height = height;
+    image.rgba.resize(pixelCount * 4);
+
+    const uint8_t* src = data + offset;
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        image.rgba[(i * 4) + 0] = src[(i * 3) + 0];
+        image.rgba[(i * 4) + 1] = src[(i * 3) + 1];
+        image.rgba[(i * 4) + 2] = src[(i * 3) + 2];
+        image.rgba[(i * 4) + 3] = 255;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------//
+
+constexpr size_t TGA_HEADER_SIZE = 18;
+
+static uint16_t ReadU16LittleEndian(const uint8_t* data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+// Stored pixel (BGR(A) or gray) to RGBA.
+static void ConvertTgaPixel(const uint8_t* src, uint32_t bytesPerPixel, uint8_t* dst)
+{
+    if (bytesPerPixel == 1)
+    {
+        dst[0] = dst[1] = dst[2] = src[0];
+        dst[3] = 255;
+        return;
+    }
+
+    dst[0] = src[2];
+    dst[1] = src[1];
+    dst[2] = src[0];
+    dst[3] = (bytesPerPixel == 4) ? src[3] : 255;
+}
+
+static bool DecodeTga(const uint8_t* data, size_t size, ImageData& image)
+{
+    if (size < TGA_HEADER_SIZE) { return false; }
+
+    uint8_t idLength = data[0];
+    uint8_t colorMapType = data[1];
+    uint8_t imageType = data[2];
+    uint32_t width = ReadU16LittleEndian(data + 12);
+    uint32_t height = ReadU16LittleEndian(data + 14);
+    uint8_t bitsPerPixel = data[16];
+    uint8_t descriptor = data[17];
+
+    bool rle = (imageType == 10) || (imageType == 11);
+    bool gray = (imageType == 3) || (imageType == 11);
+    bool trueColor = (imageType == 2) || (imageType == 10);
+    uint32_t bytesPerPixel = bitsPerPixel / 8;
+
+    // Color mapped and 16 bit images aren't produced by any of our tools.
+    if ((colorMapType != 0) || !(gray || trueColor) || !IsValidImageSize(width, height) ||
+        (gray && (bitsPerPixel != 8)) || (trueColor && (bitsPerPixel != 24) && (bitsPerPixel != 32)))
+    {
+        return false;
+    }
+
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    size_t offset = TGA_HEADER_SIZE + idLength;
+
+    std::vector<uint8_t> decoded(pixelCount * 4);
+    size_t pixel = 0;
+    while (pixel < pixelCount)
+    {
+        // Raw images are one long raw packet.
+        size_t packetCount = pixelCount - pixel;
+        bool repeat = false;
+        if (rle)
+        {
+            if (offset >= size) { return false; }
+            uint8_t packetHeader = data[offset++];
+            packetCount = std::min<size_t>((packetHeader & 0x7F) + 1, pixelCount - pixel);
+            repeat = (packetHeader & 0x80) != 0;
+        }
+
+        size_t readSize = (repeat ? 1 : packetCount) * bytesPerPixel;
+        if ((size - std::min(size, offset)) < readSize) { return false; }
+
+        for (size_t i = 0; i < packetCount; ++i)
+        {
+            const uint8_t* src = data + offset + (repeat ? 0 : (i * bytesPerPixel));
+            ConvertTgaPixel(src, bytesPerPixel, &decoded[(pixel + i) * 4]);
+        }
+
+        offset += readSize;
+        pixel += packetCount;
+    }
+
+    // Bottom-left origin unless bit 5 is set, right-to-left when bit 4 is set.
+    bool topToBottom = (descriptor & 0x20) != 0;
+    bool rightToLeft = (descriptor & 0x10) != 0;
+
+    image.width = width;
+    image.height = height;
+    image.rgba.resize(pixelCount * 4);
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        uint32_t srcY = topToBottom ? y : (height - 1 - y);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            uint32_t srcX = rightToLeft ? (width - 1 - x) : x;
+            const uint8_t* src = &decoded[((static_cast<size_t>(srcY) * width) + srcX) * 4];
+            std::copy(src, src + 4, &image.rgba[((static_cast<size_t>(y) * width) + x) * 4]);
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------//
+
+bool DecodeImage(const uint8_t* data, size_t size, ImageData& image)
+{
+    if ((size >= 2) && (data[0] == 'P') && (data[1] == '6'))
+    {
+        return DecodePpm(data, size, image);
+    }
+
+    // TGA has no magic, DecodeTga validates the header fields instead.
+    return DecodeTga(data, size, image);
+}
+
+bool ReadImageFile(const std::string& filePath, ImageData& image)
+{
+    std::ifstream file(filePath, std::ios::ate | std::ios::binary);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Image Reader: Failed to open {}", filePath);
+        return false;
+    }
+
+    std::vector<uint8_t> buffer(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+    if (!file || !DecodeImage(buffer.data(), buffer.size(), image))
+    {
+        LOG_ERROR("Image Reader: Unsupported or corrupted image {}", filePath);
+        return false;
+    }
+    return true;
+}
+
+void HalveImage(const ImageData& src, ImageData& dst)
+{
+    uint32_t width = std::max(1u, src.width / 2);
+    uint32_t height = std::max(1u, src.height / 2);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        uint32_t y0 = std::min(y * 2, src.height - 1);
+        uint32_t y1 = std::min((y * 2) + 1, src.height - 1);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            uint32_t x0 = std::min(x * 2, src.width - 1);
+            uint32_t x1 = std::min((x * 2) + 1, src.width - 1);
+
+            const uint8_t* p00 = &src.rgba[((static_cast<size_t>(y0) * src.width) + x0) * 4];
+            const uint8_t* p01 = &src.rgba[((static_cast<size_t>(y0) * src.width) + x1) * 4];
+            const uint8_t* p10 = &src.rgba[((static_cast<size_t>(y1) * src.width) + x0) * 4];
+            const uint8_t* p11 = &src.rgba[((static_cast<size_t>(y1) * src.width) + x1) * 4];
+
+            uint8_t* out = &rgba[((static_cast<size_t>(y) * width) + x) * 4];
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                out[c] = static_cast<uint8_t>((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+            }
+        }
+    }
+
+    // src and dst may be the same image.
+    dst.width = width;
+    dst.height = height;
+    dst.rgba = std::move(rgba);
+}
+
+} // namespace Core
@@ -0,0 +1,181 @@
+#include <Core/ImageWriter.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <vector>
+
+namespace Core
+{
+
+static void AppendU32BigEndian(std::vector<uint8_t>& out, uint32_t value)
+{
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+//----------------------------------------------------------------------------//
+
+static const std::array<uint32_t, 256>& Crc32Table()
+{
+    static const std::array<uint32_t, 256> table = []() {
+        std::array<uint32_t, 256> result = {};
+        for (uint32_t n = 0; n < 256; ++n)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            result[n] = c;
+        }
+        return result;
+    }();
+    return table;
+}
+
+static uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0)
+{
+    const auto& table = Crc32Table();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void AppendPngChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& data)
+{
+    AppendU32BigEndian(out, static_cast<uint32_t>(data.size()));
+
+    size_t typeOffset = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+
+    // The CRC covers the chunk type and data, not the length.
+    AppendU32BigEndian(out, Crc32(out.data() + typeOffset, out.size() - typeOffset));
+}
+
+static std::vector<uint8_t> EncodePng(uint32_t width, uint32_t height, const uint8_t* rgba)
+{
+    // Scanlines with filter type 0 (None) in front of every row
+    size_t rowSize = static_cast<size_t>(width) * 4;
+    std::vector<uint8_t> scanlines;
+    scanlines.reserve((rowSize + 1) * height);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        scanlines.push_back(0);
+        const uint8_t* row = rgba + (y * rowSize);
+        scanlines.insert(scanlines.end(), row, row + rowSize);
+    }
+
+    // zlib stream made of stored deflate blocks (max 65535 bytes each)
+    constexpr size_t MAX_STORED_BLOCK = 65535;
+    std::vector<uint8_t> zlib;
+    zlib.reserve(scanlines.size() + (scanlines.size() / MAX_STORED_BLOCK + 1) * 5 + 6);
+    zlib.push_back(0x78); // CM 8, 32K window
+    zlib.push_back(0x01); // No preset dictionary, fastest, header % 31 == 0
+
+    size_t offset = 0;
+    do
+    {
+        size_t blockSize = std::min(MAX_STORED_BLOCK, scanlines.size() - offset);
+        bool lastBlock = (offset + blockSize) == scanlines.size();
+
+        zlib.push_back(lastBlock ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(blockSize & 0xFF));
+        zlib.push_back(static_cast<uint8_t>(blockSize >> 8));
+        zlib.push_back(static_cast<uint8_t>(~blockSize & 0xFF));
+        zlib.push_back(static_cast<uint8_t>((~blockSize >> 8) & 0xFF));
+        zlib.insert(zlib.end(), scanlines.begin() + offset, scanlines.begin() + offset + blockSize);
+
+        offset += blockSize;
+    } while (offset < scanlines.size());
+
+    // Adler-32 of the uncompressed data
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (uint8_t value : scanlines)
+    {
+        a = (a + value) % 65521;
+        b = (b + a) % 65521;
+    }
+    AppendU32BigEndian(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> header;
+    AppendU32BigEndian(header, width);
+    AppendU32BigEndian(header, height);
+    header.push_back(8); // Bit depth
+    header.push_back(6); // Color type RGBA
+    header.push_back(0); // Compression
+    header.push_back(0); // Filter
+    header.push_back(0); // Interlace
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png.reserve(png.size() + zlib.size() + 64);
+    AppendPngChunk(png, "IHDR", header);
+    AppendPngChunk(png, "IDAT", zlib);
+    AppendPngChunk(png, "IEND", {});
+
+    return png;
+}
+
+//----------------------------------------------------------------------------//
+
+bool WriteImageFile(
+    const std::string& filePath,
+    ImageFileFormat format,
+    uint32_t width,
+    uint32_t height,
+    const uint8_t* rgba)
+{
+    std::ofstream file(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG_ERROR("ImageWriter: Unable to open {}", filePath);
+        return false;
+    }
+
+    size_t pixelCount = static_cast<size_t>(width) * height;
+
+    switch (format)
+    {
+        case ImageFileFormat::Ppm:
+        {
+            std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+            file.write(header.data(), header.size());
+
+            std::vector<uint8_t> rgb(pixelCount * 3);
+            for (size_t i = 0; i < pixelCount; ++i)
+            {
+                rgb[(i * 3) + 0] = rgba[(i * 4) + 0];
+                rgb[(i * 3) + 1] = rgba[(i * 4) + 1];
+                rgb[(i * 3) + 2] = rgba[(i * 4) + 2];
+            }
+            file.write(reinterpret_cast<const char*>(rgb.data()), rgb.size());
+            break;
+        }
+        case ImageFileFormat::Png:
+        {
+            std::vector<uint8_t> png = EncodePng(width, height, rgba);
+            file.write(reinterpret_cast<const char*>(png.data()), png.size());
+            break;
+        }
+        case ImageFileFormat::Raw:
+        {
+            file.write(reinterpret_cast<const char*>(rgba), pixelCount * 4);
+            break;
+        }
+    }
+
+    return file.good();
+}
+
+} // namespace Core
@@ -0,0 +1,287 @@
+#include <Core/Json.ipp>
+
+// STD Lib
+#include <cstdlib>
+
+namespace Core
+{
+
+// Deeper documents are rejected instead of overflowing the stack.
+constexpr uint32_t JSON_MAX_DEPTH = 256;
+
+const JsonValue& JsonValue::GetNull()
+{
+    static const JsonValue nullValue;
+    return nullValue;
+}
+
+//----------------------------------------------------------------------------//
+
+class JsonParser
+{
+
+public:
+    explicit JsonParser(std::string_view text) : text_(text) {}
+
+    bool Parse(JsonValue& value)
+    {
+        SkipWhitespace();
+        if (!ParseValue(value, 0)) { return false; }
+
+        SkipWhitespace();
+        return (offset_ == text_.size()) || Fail("Trailing characters");
+    }
+
+    const std::string& GetError() const { return error_; }
+
+private:
+    bool Fail(const char* reason)
+    {
+        if (error_.empty())
+        {
+            error_ = std::string(reason) + " at byte " + std::to_string(offset_);
+        }
+        return false;
+    }
+
+    void SkipWhitespace()
+    {
+        while ((offset_ < text_.size()) &&
+               ((text_[offset_] == ' ') || (text_[offset_] == '\t') || (text_[offset_] == '\n') || (text_[offset_] == '\r')))
+        {
+            offset_++;
+        }
+    }
+
+    bool Consume(std::string_view literal)
+    {
+        if (text_.substr(offset_, literal.size()) != literal) { return false; }
+        offset_ += literal.size();
+        return true;
+    }
+
+    bool ParseValue(JsonValue& value, uint32_t depth)
+    {
+        if (depth > JSON_MAX_DEPTH) { return Fail("Nesting too deep"); }
+        if (offset_ >= text_.size()) { return Fail("Unexpected end"); }
+
+        switch (text_[offset_])
+        {
+        case '{': return ParseObject(value, depth);
+        case '[': return ParseArray(value, depth);
+        case '"':
+            value.type_ = JsonType::String;
+            return ParseString(value.string_);
+        case 't':
+            value.type_ = JsonType::Bool;
+            value.bool_ = true;
+            return Consume("true") || Fail("Invalid literal");
+        case 'f':
+            value.type_ = JsonType::Bool;
+            value.bool_ = false;
+            return Consume("false") || Fail("Invalid literal");
+        case 'n':
+            value.type_ = JsonType::Null;
+            return Consume("null") || Fail("Invalid literal");
+        default:
+            return ParseNumber(value);
+        }
+    }
+
+    bool ParseObject(JsonValue& value, uint32_t depth)
+    {
+        value.type_ = JsonType::Object;
+        offset_++; // '{'
+        SkipWhitespace();
+        if (Consume("}")) { return true; }
+
+        while (true)
+        {
+            SkipWhitespace();
+            if ((offset_ >= text_.size()) || (text_[offset_] != '"')) { return Fail("Expected a key"); }
+
+            value.members_.emplace_back();
+            if (!ParseString(value.members_.back().first)) { return false; }
+
+            SkipWhitespace();
+            if (!Consume(":")) { return Fail("Expected ':'"); }
+            SkipWhitespace();
+            if (!ParseValue(value.members_.back().second, depth + 1)) { return false; }
+
+            SkipWhitespace();
+            if (Consume("}")) { return true; }
+            if (!Consume(",")) { return Fail("Expected ',' or '}'"); }
+        }
+    }
+
+    bool ParseArray(JsonValue& value, uint32_t depth)
+    {
+        value.type_ = JsonType::Array;
+        offset_++; // '['
+        SkipWhitespace();
+        if (Consume("]")) { return true; }
+
+        while (true)
+        {
+            SkipWhitespace();
+            value.array_.emplace_back();
+            if (!ParseValue(value.array_.back(), depth + 1)) { return false; }
+
+            SkipWhitespace();
+            if (Consume("]")) { return true; }
+            if (!Consume(",")) { return Fail("Expected ',' or ']'"); }
+        }
+    }
+
+    bool ParseHex4(uint32_t& codePoint)
+    {
+        if ((text_.size() - offset_) < 4) { return Fail("Truncated escape"); }
+
+        codePoint = 0;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            char c = text_[offset_++];
+            codePoint <<= 4;
+            if ((c >= '0') && (c <= '9')) { codePoint |= static_cast<uint32_t>(c - '0'); }
+            else if ((c >= 'a') && (c <= 'f')) { codePoint |= static_cast<uint32_t>(c - 'a' + 10); }
+            else if ((c >= 'A') && (c <= 'F')) { codePoint |= static_cast<uint32_t>(c - 'A' + 10); }
+            else { return Fail("Invalid escape"); }
+        }
+        return true;
+    }
+
+    static void AppendUtf8(uint32_t codePoint, std::string& out)
+    {
+        if (codePoint < 0x80)
+        {
+            out += static_cast<char>(codePoint);
+        }
+        else if (codePoint < 0x800)
+        {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    bool ParseString(std::string& out)
+    {
+        offset_++; // '"'
+        while (offset_ < text_.size())
+        {
+            char c = text_[offset_++];
+            if (c == '"') { return true; }
+            if (static_cast<unsigned char>(c) < 0x20) { return Fail("Control character in string"); }
+            if (c != '\\')
+            {
+                out += c;
+                continue;
+            }
+
+            if (offset_ >= text_.size()) { break; }
+            char escape = text_[offset_++];
+            switch (escape)
+            {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u':
+            {
+                uint32_t codePoint = 0;
+                if (!ParseHex4(codePoint)) { return false; }
+
+                // High surrogate, the low half follows as a second escape.
+                if ((codePoint >= 0xD800) && (codePoint <= 0xDBFF))
+                {
+                    uint32_t low = 0;
+                    if (!Consume("\\u") || !ParseHex4(low) || (low < 0xDC00) || (low > 0xDFFF))
+                    {
+                        return Fail("Invalid surrogate pair");
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                AppendUtf8(codePoint, out);
+                break;
+            }
+            default:
+                return Fail("Invalid escape");
+            }
+        }
+        return Fail("Unterminated string");
+    }
+
+    bool ParseNumber(JsonValue& value)
+    {
+        // Validate the grammar first, strtod accepts more (hex, inf, leading '+').
+        size_t start = offset_;
+        auto isDigit = [this]() { return (offset_ < text_.size()) && (text_[offset_] >= '0') && (text_[offset_] <= '9'); };
+
+        if ((offset_ < text_.size()) && (text_[offset_] == '-')) { offset_++; }
+        if (!isDigit()) { return Fail("Invalid value"); }
+        if (text_[offset_] == '0') { offset_++; }
+        else { while (isDigit()) { offset_++; } }
+
+        if ((offset_ < text_.size()) && (text_[offset_] == '.'))
+        {
+            offset_++;
+            if (!isDigit()) { return Fail("Invalid number"); }
+            while (isDigit()) { offset_++; }
+        }
+
+        if ((offset_ < text_.size()) && ((text_[offset_] == 'e') || (text_[offset_] == 'E')))
+        {
+            offset_++;
+            if ((offset_ < text_.size()) && ((text_[offset_] == '+') || (text_[offset_] == '-'))) { offset_++; }
+            if (!isDigit()) { return Fail("Invalid number"); }
+            while (isDigit()) { offset_++; }
+        }
+
+        // The text may not be null terminated, copy the (short) token.
+        std::string token(text_.substr(start, offset_ - start));
+        value.type_ = JsonType::Number;
+        value.number_ = std::strtod(token.c_str(), nullptr);
+        return true;
+    }
+
+    std::string_view text_;
+    size_t offset_ = 0;
+    std::string error_;
+};
+
+//----------------------------------------------------------------------------//
+
+bool ParseJson(std::string_view text, JsonValue& value, std::string* error)
+{
+    value = JsonValue{};
+
+    JsonParser parser(text);
+    if (!parser.Parse(value))
+    {
+        if (error != nullptr)
+        {
+            *error = parser.GetError();
+        }
+        value = JsonValue{};
+        return false;
+    }
+    return true;
+}
+
+} // namespace Core
@@ -0,0 +1,101 @@
+#include <Core/Ktx2Reader.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <cstring>
+
+namespace Core
+{
+
+constexpr size_t KTX2_HEADER_SIZE = 80; // Identifier, header and section index
+constexpr size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+
+// Fields are little endian, as are the platforms we run on.
+template <typename T>
+static T ReadField(const uint8_t* data, size_t offset)
+{
+    T value;
+    memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+bool ParseKtx2(const uint8_t* data, size_t size, Ktx2Image& image)
+{
+    if (!IsKtx2(data, size) || (size < KTX2_HEADER_SIZE))
+    {
+        LOG_ERROR("KTX2 Reader: Not a KTX2 container");
+        return false;
+    }
+
+    uint32_t vkFormat = ReadField<uint32_t>(data, 12);
+    uint32_t width = ReadField<uint32_t>(data, 20);
+    uint32_t height = ReadField<uint32_t>(data, 24);
+    uint32_t depth = ReadField<uint32_t>(data, 28);
+    uint32_t layerCount = ReadField<uint32_t>(data, 32);
+    uint32_t faceCount = ReadField<uint32_t>(data, 36);
+    uint32_t levelCount = std::max(1u, ReadField<uint32_t>(data, 40));
+    uint32_t supercompression = ReadField<uint32_t>(data, 44);
+
+    if ((width == 0) || (height == 0) || (depth > 1) || (layerCount > 1) || (faceCount != 1))
+    {
+        LOG_ERROR("KTX2 Reader: Only single layer 2D textures are supported ({}x{}x{}, {} layers, {} faces)",
+                  width, height, depth, layerCount, faceCount);
+        return false;
+    }
+
+    // Levels past the 1x1 one don't exist, the image couldn't be created with them.
+    uint32_t fullChainLength = 1;
+    for (uint32_t extent = std::max(width, height); extent > 1; extent >>= 1)
+    {
+        fullChainLength++;
+    }
+
+    if (levelCount > fullChainLength)
+    {
+        LOG_ERROR("KTX2 Reader: {} levels declared, a {}x{} texture has at most {}",
+                  levelCount, width, height, fullChainLength);
+        return false;
+    }
+
+    if (supercompression != 0)
+    {
+        LOG_ERROR("KTX2 Reader: Supercompression scheme {} is not supported", supercompression);
+        return false;
+    }
+
+    if ((size - KTX2_HEADER_SIZE) < (static_cast<size_t>(levelCount) * KTX2_LEVEL_INDEX_ENTRY_SIZE))
+    {
+        LOG_ERROR("KTX2 Reader: Truncated level index");
+        return false;
+    }
+
+    image.vkFormat = vkFormat;
+    image.width = width;
+    image.height = height;
+    image.levels.resize(levelCount);
+
+    for (uint32_t level = 0; level < levelCount; ++level)
+    {
+        size_t entry = KTX2_HEADER_SIZE + (level * KTX2_LEVEL_INDEX_ENTRY_SIZE);
+        uint64_t byteOffset = ReadField<uint64_t>(data, entry);
+        uint64_t byteLength = ReadField<uint64_t>(data, entry + 8);
+
+        if ((byteOffset > size) || (byteLength > (size - byteOffset)))
+        {
+            LOG_ERROR("KTX2 Reader: Level {} is out of bounds", level);
+            return false;
+        }
+
+        Ktx2Level& levelInfo = image.levels[level];
+        levelInfo.data = data + byteOffset;
+        levelInfo.size = static_cast<size_t>(byteLength);
+        levelInfo.width = std::max(1u, width >> level);
+        levelInfo.height = std::max(1u, height >> level);
+    }
+    return true;
+}
+
+} // namespace Core
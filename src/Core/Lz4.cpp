@@ -0,0 +1,199 @@
+#include <Core/Lz4.ipp>
+
+// STD Lib
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace Core
+{
+
+// Block format limits : matches are at least 4 bytes, the last 5 bytes are always
+// literals and the last match starts at least 12 bytes before the end.
+constexpr size_t LZ4_MIN_MATCH = 4;
+constexpr size_t LZ4_LAST_LITERALS = 5;
+constexpr size_t LZ4_MF_LIMIT = 12;
+constexpr size_t LZ4_MAX_OFFSET = 65535;
+constexpr uint32_t LZ4_HASH_BITS = 12;
+
+static uint32_t Read32(const uint8_t* data)
+{
+    uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint32_t HashSequence(uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+}
+
+// Length continuation bytes after a saturated (15) token nibble.
+static void WriteLength(size_t length, uint8_t* dst, size_t& out)
+{
+    while (length >= 255)
+    {
+        dst[out++] = 255;
+        length -= 255;
+    }
+    dst[out++] = static_cast<uint8_t>(length);
+}
+
+static bool ReadLength(const uint8_t* src, size_t srcSize, size_t& in, size_t& length)
+{
+    uint8_t value = 255;
+    while (value == 255)
+    {
+        if (in >= srcSize) { return false; }
+        value = src[in++];
+        length += value;
+    }
+    return true;
+}
+
+// Literals [anchor, anchor + literalCount), then the match unless matchLength is 0.
+static bool WriteSequence(
+    const uint8_t* literals,
+    size_t literalCount,
+    size_t offset,
+    size_t matchLength,
+    uint8_t* dst,
+    size_t dstCapacity,
+    size_t& out)
+{
+    size_t worstCase = 1 + (literalCount / 255) + 1 + literalCount + 2 + (matchLength / 255) + 1;
+    if (worstCase > (dstCapacity - out)) { return false; }
+
+    size_t tokenOffset = out++;
+    uint8_t token = static_cast<uint8_t>(std::min<size_t>(literalCount, 15) << 4);
+    if (literalCount >= 15)
+    {
+        WriteLength(literalCount - 15, dst, out);
+    }
+    std::memcpy(dst + out, literals, literalCount);
+    out += literalCount;
+
+    if (matchLength > 0)
+    {
+        dst[out++] = static_cast<uint8_t>(offset & 0xFF);
+        dst[out++] = static_cast<uint8_t>(offset >> 8);
+
+        size_t extra = matchLength - LZ4_MIN_MATCH;
+        token |= static_cast<uint8_t>(std::min<size_t>(extra, 15));
+        if (extra >= 15)
+        {
+            WriteLength(extra - 15, dst, out);
+        }
+    }
+
+    dst[tokenOffset] = token;
+    return true;
+}
+
+size_t Lz4Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+{
+    if (srcSize > UINT32_MAX) { return 0; }
+
+    size_t out = 0;
+    size_t anchor = 0;
+
+    if (srcSize > LZ4_MF_LIMIT)
+    {
+        std::vector<uint32_t> table(size_t(1) << LZ4_HASH_BITS, UINT32_MAX);
+        size_t matchLimit = srcSize - LZ4_LAST_LITERALS;
+        size_t pos = 0;
+
+        while ((pos + LZ4_MF_LIMIT) <= srcSize)
+        {
+            uint32_t sequence = Read32(src + pos);
+            uint32_t& slot = table[HashSequence(sequence)];
+            size_t candidate = slot;
+            slot = static_cast<uint32_t>(pos);
+
+            if ((candidate == UINT32_MAX) || ((pos - candidate) > LZ4_MAX_OFFSET) || (Read32(src + candidate) != sequence))
+            {
+                pos++;
+                continue;
+            }
+
+            // Grow the match backwards into the pending literals, then forwards.
+            while ((pos > anchor) && (candidate > 0) && (src[pos - 1] == src[candidate - 1]))
+            {
+                pos--;
+                candidate--;
+            }
+
+            size_t length = LZ4_MIN_MATCH;
+            while (((pos + length) < matchLimit) && (src[candidate + length] == src[pos + length]))
+            {
+                length++;
+            }
+
+            if (!WriteSequence(src + anchor, pos - anchor, pos - candidate, length, dst, dstCapacity, out))
+            {
+                return 0;
+            }
+
+            pos += length;
+            anchor = pos;
+        }
+    }
+
+    // Whatever is left, at least the last 5 bytes, goes out as literals.
+    if (!WriteSequence(src + anchor, srcSize - anchor, 0, 0, dst, dstCapacity, out))
+    {
+        return 0;
+    }
+    return out;
+}
+
+bool Lz4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < srcSize)
+    {
+        uint8_t token = src[in++];
+
+        size_t literalCount = token >> 4;
+        if ((literalCount == 15) && !ReadLength(src, srcSize, in, literalCount)) { return false; }
+        if ((literalCount > (srcSize - in)) || (literalCount > (dstSize - out))) { return false; }
+
+        std::memcpy(dst + out, src + in, literalCount);
+        in += literalCount;
+        out += literalCount;
+
+        // The last sequence has no match.
+        if (in == srcSize) { break; }
+
+        if ((srcSize - in) < 2) { return false; }
+        size_t offset = static_cast<size_t>(src[in]) | (static_cast<size_t>(src[in + 1]) << 8);
+        in += 2;
+        if ((offset == 0) || (offset > out)) { return false; }
+
+        size_t length = token & 0x0F;
+        if ((length == 15) && !ReadLength(src, srcSize, in, length)) { return false; }
+        length += LZ4_MIN_MATCH;
+        if (length > (dstSize - out)) { return false; }
+
+        // Overlapping matches repeat the last 'offset' bytes, copy them in order.
+        const uint8_t* match = dst + out - offset;
+        if (offset >= length)
+        {
+            std::memcpy(dst + out, match, length);
+        }
+        else
+        {
+            for (size_t i = 0; i < length; ++i)
+            {
+                dst[out + i] = match[i];
+            }
+        }
+        out += length;
+    }
+
+    return out == dstSize;
+}
+
+} // namespace Core
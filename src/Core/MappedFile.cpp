@@ -0,0 +1,163 @@
+#include <Core/MappedFile.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// STD Lib
+#include <algorithm>
+#include <utility>
+
+namespace Core
+{
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& filePath)
+{
+    Close();
+
+    HANDLE file = CreateFileA(
+        filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR("Mapped File: Failed to open {}", filePath);
+        return false;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && (fileSize.QuadPart > 0))
+    {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+
+    // The view keeps the mapping alive, neither handle is needed past this point.
+    void* view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (mapping != nullptr) { CloseHandle(mapping); }
+    CloseHandle(file);
+
+    if (view == nullptr)
+    {
+        LOG_ERROR("Mapped File: Failed to map {}", filePath);
+        return false;
+    }
+
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data_ != nullptr)
+    {
+        UnmapViewOfFile(data_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const
+{
+    // PrefetchVirtualMemory needs Windows 8 headers, pages fault in on access instead.
+    (void)offset;
+    (void)size;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& filePath)
+{
+    Close();
+
+    int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        LOG_ERROR("Mapped File: Failed to open {}", filePath);
+        return false;
+    }
+
+    struct stat fileStat = {};
+    void* view = MAP_FAILED;
+    if ((fstat(fd, &fileStat) == 0) && (fileStat.st_size > 0))
+    {
+        view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    // The mapping holds its own reference to the file.
+    close(fd);
+
+    if (view == MAP_FAILED)
+    {
+        LOG_ERROR("Mapped File: Failed to map {}", filePath);
+        return false;
+    }
+
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(fileStat.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data_ != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const
+{
+    if ((data_ == nullptr) || (offset >= size_))
+    {
+        return;
+    }
+
+    // madvise wants a page aligned start.
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t alignedOffset = offset & ~(pageSize - 1);
+    size_t end = std::min(offset + size, size_);
+    madvise(const_cast<uint8_t*>(data_) + alignedOffset, end - alignedOffset, MADV_WILLNEED);
+}
+
+#endif
+
+} // namespace Core
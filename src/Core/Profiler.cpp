@@ -0,0 +1,136 @@
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <filesystem>
+#include <fstream>
+
+namespace Core
+{
+
+ProfileEventRing::ProfileEventRing(uint32_t threadId)
+    : threadId_(threadId)
+{
+}
+
+//----------------------------------------------------------------------------//
+
+Profiler::Profiler()
+    : epoch_(std::chrono::steady_clock::now())
+{
+}
+
+ProfileEventRing* Profiler::RegisterThread()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint32_t threadId = static_cast<uint32_t>(rings_.size());
+    rings_.push_back(std::make_unique<ProfileEventRing>(threadId));
+    threadNames_.push_back("Thread " + std::to_string(threadId));
+
+    return rings_.back().get();
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+    ProfileEventRing* ring = GetThreadRing();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    threadNames_[ring->GetThreadId()] = name;
+}
+
+void Profiler::Collect()
+{
+    // The lock keeps a single consumer per ring, producers never take it.
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto& ring : rings_)
+    {
+        uint32_t threadId = ring->GetThreadId();
+        ring->Drain([this, threadId](const ProfileEvent& event) {
+            history_.push_back({event, threadId});
+        });
+    }
+
+    while (history_.size() > CPU_PROFILER_HISTORY)
+    {
+        history_.pop_front();
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+// Scope names are literals from our own code, only quotes and backslashes need escaping.
+static void WriteJsonString(std::ofstream& file, const char* text)
+{
+    file << '"';
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        if ((*c == '"') || (*c == '\\'))
+        {
+            file << '\\';
+        }
+        file << *c;
+    }
+    file << '"';
+}
+
+bool Profiler::DumpChromeTrace(const std::string& filePath)
+{
+    Collect();
+
+    namespace fs = std::filesystem;
+    std::error_code errCode;
+    fs::create_directories(fs::path(filePath).parent_path(), errCode);
+
+    std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Profiler: Unable to open {}", filePath);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    for (size_t threadId = 0; threadId < threadNames_.size(); ++threadId)
+    {
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId
+             << ",\"args\":{\"name\":";
+        WriteJsonString(file, threadNames_[threadId].c_str());
+        file << "}}";
+        first = false;
+    }
+
+    // Complete events, timestamps in microseconds.
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    for (const CapturedEvent& captured : history_)
+    {
+        const ProfileEvent& event = captured.event;
+        file << (first ? "" : ",\n") << "{\"name\":";
+        WriteJsonString(file, event.name);
+        file << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << captured.threadId
+             << ",\"ts\":" << (static_cast<double>(event.startNs) / 1000.0)
+             << ",\"dur\":" << (static_cast<double>(event.endNs - event.startNs) / 1000.0) << "}";
+        first = false;
+    }
+
+    file << "\n]}\n";
+
+    uint64_t dropped = 0;
+    for (const auto& ring : rings_)
+    {
+        dropped += ring->GetDroppedCount();
+    }
+
+    LOG_INFO("Profiler: Wrote {} events to {} ({} dropped)", history_.size(), filePath, dropped);
+    return true;
+}
+
+} // namespace Core
@@ -0,0 +1,97 @@
+#include <Core/ThreadPool.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+
+namespace Core
+{
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        uint32_t hwThreads = std::thread::hardware_concurrency();
+        threadCount = std::max(1u, (hwThreads > 1) ? (hwThreads - 1) : 1u);
+    }
+
+    workers_.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    jobCondition_.notify_all();
+
+    for (auto& worker : workers_)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPool::Enqueue(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push(std::move(job));
+    }
+    jobCondition_.notify_one();
+}
+
+void ThreadPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCondition_.wait(lock, [this]() { return jobs_.empty() && (activeJobs_ == 0); });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    PROFILE_THREAD_NAME("Worker");
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobCondition_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+
+            // Drain remaining jobs before leaving so no promise is left unfulfilled.
+            if (stopping_ && jobs_.empty())
+            {
+                return;
+            }
+
+            job = std::move(jobs_.front());
+            jobs_.pop();
+            ++activeJobs_;
+        }
+
+        {
+            PROFILE_SCOPE("ThreadPool::Job");
+            job();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --activeJobs_;
+            if (jobs_.empty() && (activeJobs_ == 0))
+            {
+                idleCondition_.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace Core
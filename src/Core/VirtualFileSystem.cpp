@@ -0,0 +1,155 @@
+#include <Core/VirtualFileSystem.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#endif
+
+// STD Lib
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+namespace Core
+{
+
+bool VirtualFileSystem::Mount(const std::string& archivePath)
+{
+    auto archive = std::make_unique<AssetArchive>();
+    if (!archive->Open(archivePath))
+    {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    archives_.push_back(std::move(archive));
+    return true;
+}
+
+void VirtualFileSystem::UnmountAll()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    archives_.clear();
+}
+
+void VirtualFileSystem::SetLooseRoot(const std::string& directory)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    looseRoot_ = directory;
+}
+
+std::string VirtualFileSystem::GetLoosePath(std::string_view path) const
+{
+    return looseRoot_.empty() ? NormalizeAssetPath(path) : (looseRoot_ + "/" + NormalizeAssetPath(path));
+}
+
+const AssetArchiveEntry* VirtualFileSystem::FindEntry(std::string_view path, const AssetArchive*& archive) const
+{
+    for (auto it = archives_.rbegin(); it != archives_.rend(); ++it)
+    {
+        const AssetArchiveEntry* entry = (*it)->Find(path);
+        if (entry != nullptr)
+        {
+            archive = it->get();
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+bool VirtualFileSystem::Exists(std::string_view path) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    const AssetArchive* archive = nullptr;
+    if (FindEntry(path, archive) != nullptr)
+    {
+        return true;
+    }
+    return std::ifstream(GetLoosePath(path)).is_open();
+}
+
+bool VirtualFileSystem::ReadFile(std::string_view path, std::vector<char>& data) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    const AssetArchive* archive = nullptr;
+    const AssetArchiveEntry* entry = FindEntry(path, archive);
+    if (entry != nullptr)
+    {
+        return archive->Read(*entry, data);
+    }
+
+    std::string loosePath = GetLoosePath(path);
+    std::ifstream file(loosePath, std::ios::ate | std::ios::binary);
+    if (!file.is_open())
+    {
+        LOG_WARN("Virtual File System: {} is neither in a mounted archive nor at {}", path, loosePath);
+        data.clear();
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool VirtualFileSystem::GetMappedData(std::string_view path, const uint8_t*& data, size_t& size) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    const AssetArchive* archive = nullptr;
+    const AssetArchiveEntry* entry = FindEntry(path, archive);
+    if ((entry == nullptr) || (entry->compression != static_cast<uint8_t>(AssetCompression::None)))
+    {
+        return false;
+    }
+
+    data = archive->GetStoredData(*entry);
+    size = static_cast<size_t>(entry->size);
+    return true;
+}
+
+//----------------------------------------------------------------------------//
+
+std::string GetExecutableDirectory()
+{
+#ifdef _WIN32
+    std::wstring path(MAX_PATH, L'\0');
+    DWORD length = 0;
+    while (true)
+    {
+        length = GetModuleFileNameW(nullptr, path.data(), static_cast<DWORD>(path.size()));
+        if ((length == 0) || (length < path.size())) { break; }
+        path.resize(path.size() * 2); // Truncated
+    }
+
+    if (length == 0)
+    {
+        LOG_WARN("Virtual File System: Failed to resolve the executable path");
+        return {};
+    }
+    path.resize(length);
+    return std::filesystem::path(path).parent_path().string();
+#else
+    std::error_code errCode;
+    std::filesystem::path path = std::filesystem::read_symlink("/proc/self/exe", errCode);
+    if (errCode)
+    {
+        LOG_WARN("Virtual File System: Failed to resolve the executable path");
+        return {};
+    }
+    return path.parent_path().string();
+#endif
+}
+
+} // namespace Core
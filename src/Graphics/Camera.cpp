@@ -0,0 +1,100 @@
+#include <Graphics/Camera.ipp>
+
+// STD Lib
+#include <cassert>
+#include <cmath>
+
+namespace Graphic
+{
+
+void Camera::SetOrthographicProjection(float left, float right, float top, float bottom, float near, float far)
+{
+    projection_ = glm::mat4{1.0f};
+    projection_[0][0] = 2.0f / (right - left);
+    projection_[1][1] = 2.0f / (bottom - top);
+    projection_[2][2] = 1.0f / (far - near);
+    projection_[3][0] = -(right + left) / (right - left);
+    projection_[3][1] = -(bottom + top) / (bottom - top);
+    projection_[3][2] = -near / (far - near);
+}
+
+void Camera::SetPerspectiveProjection(float fovy, float aspect, float near, float far)
+{
+    assert((aspect > 0.0f) && "Camera: Invalid aspect ratio");
+
+    const float tanHalfFovy = std::tan(fovy / 2.0f);
+    projection_ = glm::mat4{0.0f};
+    projection_[0][0] = 1.0f / (aspect * tanHalfFovy);
+    projection_[1][1] = 1.0f / (tanHalfFovy);
+    projection_[2][2] = far / (far - near);
+    projection_[2][3] = 1.0f;
+    projection_[3][2] = -(far * near) / (far - near);
+}
+
+void Camera::SetViewDirection(glm::vec3 position, glm::vec3 direction, glm::vec3 up)
+{
+    // Orthonormal basis, w looks along the view direction.
+    const glm::vec3 w{glm::normalize(direction)};
+    const glm::vec3 u{glm::normalize(glm::cross(w, up))};
+    const glm::vec3 v{glm::cross(w, u)};
+
+    view_ = glm::mat4{1.0f};
+    view_[0][0] = u.x;
+    view_[1][0] = u.y;
+    view_[2][0] = u.z;
+    view_[0][1] = v.x;
+    view_[1][1] = v.y;
+    view_[2][1] = v.z;
+    view_[0][2] = w.x;
+    view_[1][2] = w.y;
+    view_[2][2] = w.z;
+    view_[3][0] = -glm::dot(u, position);
+    view_[3][1] = -glm::dot(v, position);
+    view_[3][2] = -glm::dot(w, position);
+}
+
+void Camera::SetViewTarget(glm::vec3 position, glm::vec3 target, glm::vec3 up)
+{
+    SetViewDirection(position, target - position, up);
+}
+
+void Camera::SetViewYXZ(glm::vec3 position, glm::vec3 rotation)
+{
+    const float c3 = glm::cos(rotation.z);
+    const float s3 = glm::sin(rotation.z);
+    const float c2 = glm::cos(rotation.x);
+    const float s2 = glm::sin(rotation.x);
+    const float c1 = glm::cos(rotation.y);
+    const float s1 = glm::sin(rotation.y);
+    const glm::vec3 u{(c1 * c3 + s1 * s2 * s3), (c2 * s3), (c1 * s2 * s3 - c3 * s1)};
+    const glm::vec3 v{(c3 * s1 * s2 - c1 * s3), (c2 * c3), (c1 * c3 * s2 + s1 * s3)};
+    const glm::vec3 w{(c2 * s1), (-s2), (c1 * c2)};
+
+    view_ = glm::mat4{1.0f};
+    view_[0][0] = u.x;
+    view_[1][0] = u.y;
+    view_[2][0] = u.z;
+    view_[0][1] = v.x;
+    view_[1][1] = v.y;
+    view_[2][1] = v.z;
+    view_[0][2] = w.x;
+    view_[1][2] = w.y;
+    view_[2][2] = w.z;
+    view_[3][0] = -glm::dot(u, position);
+    view_[3][1] = -glm::dot(v, position);
+    view_[3][2] = -glm::dot(w, position);
+}
+
+void Camera::Set2DView(glm::vec2 center, float zoom, float aspect)
+{
+    // Sprites sit at z = 0, keep them in the middle of the depth range.
+    const float halfHeight = 1.0f / zoom;
+    const float halfWidth = halfHeight * aspect;
+    SetOrthographicProjection(-halfWidth, halfWidth, -halfHeight, halfHeight, -1.0f, 1.0f);
+
+    view_ = glm::mat4{1.0f};
+    view_[3][0] = -center.x;
+    view_[3][1] = -center.y;
+}
+
+} // namespace Graphic
@@ -0,0 +1,1013 @@
+#include <Graphics/MeshImporter.ipp>
+#include <Core/CookedMesh.ipp>
+#include <Core/Json.ipp>
+#include <Core/MappedFile.ipp>
+#include <Core/ThreadPool.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <string_view>
+
+namespace Graphic
+{
+
+// Binary glTF container
+constexpr uint32_t GLB_MAGIC = 0x46546C67;       // "glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;  // "JSON"
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;   // "BIN\0"
+constexpr size_t GLB_HEADER_SIZE = 12;
+constexpr size_t GLB_CHUNK_HEADER_SIZE = 8;
+
+// Accessor component types and the triangle list primitive mode
+constexpr uint32_t GLTF_BYTE = 5120;
+constexpr uint32_t GLTF_UNSIGNED_BYTE = 5121;
+constexpr uint32_t GLTF_SHORT = 5122;
+constexpr uint32_t GLTF_UNSIGNED_SHORT = 5123;
+constexpr uint32_t GLTF_UNSIGNED_INT = 5125;
+constexpr uint32_t GLTF_FLOAT = 5126;
+constexpr uint32_t GLTF_TRIANGLES = 4;
+
+// Node hierarchies are disjoint trees, these only stop malformed files.
+constexpr uint32_t GLTF_MAX_NODE_DEPTH = 256;
+constexpr size_t GLTF_MAX_MESH_INSTANCES = 65536;
+
+struct MeshImporter::GltfDocument
+{
+    Core::JsonValue json;
+    std::vector<Core::MappedFile> files; // The .glb, or the .gltf and its .bin files
+    std::vector<std::pair<const uint8_t*, size_t>> buffers; // Into 'files'
+};
+
+//----------------------------------------------------------------------------//
+
+static std::string GetExtension(const std::string& filePath)
+{
+    size_t dot = filePath.find_last_of('.');
+    if ((dot == std::string::npos) || (filePath.find_first_of("/\\", dot) != std::string::npos))
+    {
+        return {};
+    }
+
+    std::string extension = filePath.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](char c) { return static_cast<char>(((c >= 'A') && (c <= 'Z')) ? (c - 'A' + 'a') : c); });
+    return extension;
+}
+
+static std::string GetDirectory(const std::string& filePath)
+{
+    size_t slash = filePath.find_last_of("/\\");
+    return (slash == std::string::npos) ? std::string{} : filePath.substr(0, slash + 1);
+}
+
+static uint32_t ReadU32LittleEndian(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static uint32_t GetComponentSize(uint32_t componentType)
+{
+    switch (componentType)
+    {
+    case GLTF_BYTE:
+    case GLTF_UNSIGNED_BYTE: return 1;
+    case GLTF_SHORT:
+    case GLTF_UNSIGNED_SHORT: return 2;
+    case GLTF_UNSIGNED_INT:
+    case GLTF_FLOAT: return 4;
+    default: return 0;
+    }
+}
+
+static uint32_t GetComponentCount(const std::string& type)
+{
+    if (type == "SCALAR") { return 1; }
+    if (type == "VEC2") { return 2; }
+    if (type == "VEC3") { return 3; }
+    if (type == "VEC4") { return 4; }
+    if (type == "MAT2") { return 4; }
+    if (type == "MAT3") { return 9; }
+    if (type == "MAT4") { return 16; }
+    return 0;
+}
+
+// Buffer data has no alignment guarantee across strides, read through memcpy.
+static float ReadComponent(const uint8_t* src, uint32_t componentType, bool normalized)
+{
+    switch (componentType)
+    {
+    case GLTF_FLOAT:
+    {
+        float value = 0.0f;
+        std::memcpy(&value, src, sizeof(value));
+        return value;
+    }
+    case GLTF_UNSIGNED_BYTE:
+        return normalized ? (src[0] / 255.0f) : src[0];
+    case GLTF_BYTE:
+    {
+        float value = static_cast<int8_t>(src[0]);
+        return normalized ? std::max(value / 127.0f, -1.0f) : value;
+    }
+    case GLTF_UNSIGNED_SHORT:
+    {
+        uint16_t value = 0;
+        std::memcpy(&value, src, sizeof(value));
+        return normalized ? (value / 65535.0f) : value;
+    }
+    case GLTF_SHORT:
+    {
+        int16_t value = 0;
+        std::memcpy(&value, src, sizeof(value));
+        return normalized ? std::max(value / 32767.0f, -1.0f) : value;
+    }
+    default:
+    {
+        uint32_t value = 0;
+        std::memcpy(&value, src, sizeof(value));
+        return static_cast<float>(value);
+    }
+    }
+}
+
+static uint32_t ReadIndex(const uint8_t* src, uint32_t componentType)
+{
+    if (componentType == GLTF_UNSIGNED_BYTE)
+    {
+        return src[0];
+    }
+    if (componentType == GLTF_UNSIGNED_SHORT)
+    {
+        uint16_t value = 0;
+        std::memcpy(&value, src, sizeof(value));
+        return value;
+    }
+
+    uint32_t value = 0;
+    std::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+static glm::mat4 GetNodeTransform(const Core::JsonValue& node)
+{
+    const Core::JsonValue& matrix = node["matrix"];
+    if (matrix.GetSize() == 16)
+    {
+        // Column major, like glm.
+        glm::mat4 transform(1.0f);
+        for (uint32_t column = 0; column < 4; ++column)
+        {
+            for (uint32_t row = 0; row < 4; ++row)
+            {
+                transform[column][row] = matrix[(column * 4) + row].GetFloat();
+            }
+        }
+        return transform;
+    }
+
+    const Core::JsonValue& translation = node["translation"];
+    const Core::JsonValue& rotation = node["rotation"];
+    const Core::JsonValue& scale = node["scale"];
+
+    glm::vec3 t{translation[0].GetFloat(0.0f), translation[1].GetFloat(0.0f), translation[2].GetFloat(0.0f)};
+    glm::quat r{rotation[3].GetFloat(1.0f), rotation[0].GetFloat(0.0f), rotation[1].GetFloat(0.0f), rotation[2].GetFloat(0.0f)};
+    glm::vec3 s{scale[0].GetFloat(1.0f), scale[1].GetFloat(1.0f), scale[2].GetFloat(1.0f)};
+
+    return glm::translate(glm::mat4(1.0f), t) * glm::mat4_cast(r) * glm::scale(glm::mat4(1.0f), s);
+}
+
+//----------------------------------------------------------------------------//
+
+static bool IsObjSpace(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r');
+}
+
+static bool IsDigit(char c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+static void SkipObjSpaces(const char*& cursor, const char* end)
+{
+    while ((cursor < end) && IsObjSpace(*cursor)) { cursor++; }
+}
+
+static double GetPowerOfTen(int32_t exponent)
+{
+    static constexpr double POWERS[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    return (exponent <= 22) ? POWERS[exponent] : std::pow(10.0, exponent);
+}
+
+// Decimal float without locale or null terminator, strtof needs both. Digits past the
+// 18th only scale the result, which is plenty for a float.
+static bool ParseObjFloat(const char*& cursor, const char* end, float& value)
+{
+    SkipObjSpaces(cursor, end);
+
+    const char* p = cursor;
+    bool negative = false;
+    if ((p < end) && ((*p == '-') || (*p == '+')))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int32_t exponent = 0;
+    bool hasDigits = false;
+
+    for (; (p < end) && IsDigit(*p); ++p)
+    {
+        hasDigits = true;
+        if (mantissa < 100000000000000000ull) { mantissa = (mantissa * 10) + static_cast<uint64_t>(*p - '0'); }
+        else { exponent++; }
+    }
+
+    if ((p < end) && (*p == '.'))
+    {
+        for (++p; (p < end) && IsDigit(*p); ++p)
+        {
+            hasDigits = true;
+            if (mantissa < 100000000000000000ull)
+            {
+                mantissa = (mantissa * 10) + static_cast<uint64_t>(*p - '0');
+                exponent--;
+            }
+        }
+    }
+
+    if (!hasDigits) { return false; }
+
+    if ((p < end) && ((*p == 'e') || (*p == 'E')))
+    {
+        const char* e = p + 1;
+        bool negativeExponent = false;
+        if ((e < end) && ((*e == '-') || (*e == '+')))
+        {
+            negativeExponent = (*e == '-');
+            e++;
+        }
+
+        if ((e < end) && IsDigit(*e))
+        {
+            int32_t explicitExponent = 0;
+            for (; (e < end) && IsDigit(*e); ++e)
+            {
+                explicitExponent = std::min((explicitExponent * 10) + (*e - '0'), 100000);
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+            p = e;
+        }
+    }
+
+    double result = static_cast<double>(mantissa);
+    result = (exponent < 0) ? (result / GetPowerOfTen(-exponent)) : (result * GetPowerOfTen(exponent));
+
+    value = static_cast<float>(negative ? -result : result);
+    cursor = p;
+    return true;
+}
+
+static bool ParseObjInt(const char*& cursor, const char* end, int64_t& value)
+{
+    const char* p = cursor;
+    bool negative = false;
+    if ((p < end) && ((*p == '-') || (*p == '+')))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    if ((p >= end) || !IsDigit(*p)) { return false; }
+
+    int64_t result = 0;
+    for (; (p < end) && IsDigit(*p); ++p)
+    {
+        result = std::min<int64_t>((result * 10) + (*p - '0'), INT64_C(1) << 40);
+    }
+
+    value = negative ? -result : result;
+    cursor = p;
+    return true;
+}
+
+// Statement keyword at the start of a line, e.g. "v" or "f".
+static bool IsObjStatement(const char* cursor, const char* end, char keyword)
+{
+    return ((end - cursor) >= 2) && (cursor[0] == keyword) && IsObjSpace(cursor[1]);
+}
+
+//----------------------------------------------------------------------------//
+
+// No parsing, the mapped blobs are copied straight into staging (or device memory on
+// unified memory devices). The mapping is released once VkModel has copied them.
+static std::shared_ptr<VkModel> LoadCookedModel(VkDeviceInstance* deviceInst, const std::string& filePath)
+{
+    PROFILE_SCOPE("LoadCookedModel");
+
+    Core::MappedFile file;
+    if (!file.Open(filePath)) { return nullptr; }
+    file.Prefetch(0, file.GetSize());
+
+    Core::CookedMeshView view;
+    if (!Core::ParseCookedMesh(
+            file.GetData(), file.GetSize(), Core::CookedVertexLayout::Position2Color3, sizeof(Vertex), view))
+    {
+        LOG_ERROR("Mesh Importer: Invalid cooked mesh {}", filePath);
+        return nullptr;
+    }
+
+    auto model = std::make_shared<VkModel>(
+        deviceInst,
+        reinterpret_cast<const Vertex*>(view.vertexData),
+        view.header.vertexCount,
+        view.indexData,
+        view.header.indexCount);
+
+    std::vector<ModelLod> lods(view.header.lodCount);
+    for (uint32_t i = 0; i < view.header.lodCount; ++i)
+    {
+        lods[i] = {view.lods[i].firstIndex, view.lods[i].indexCount};
+    }
+    model->SetLods(lods);
+
+    LOG_INFO("Mesh Importer: {} -> {} vertices, {} LODs", filePath, view.header.vertexCount, view.header.lodCount);
+    return model;
+}
+
+MeshImporter::MeshImporter(uint32_t threadCount) : threadPool_(threadCount)
+{
+}
+
+bool MeshImporter::Import(const std::string& filePath, MeshData& mesh)
+{
+    PROFILE_SCOPE("MeshImporter::Import");
+
+    mesh = MeshData{};
+
+    std::string extension = GetExtension(filePath);
+    bool imported = false;
+    if ((extension == "gltf") || (extension == "glb"))
+    {
+        imported = ImportGltf(filePath, mesh);
+    }
+    else if (extension == "obj")
+    {
+        imported = ImportObj(filePath, mesh);
+    }
+    else
+    {
+        LOG_ERROR("Mesh Importer: Unsupported file type {}", filePath);
+    }
+
+    if (!imported)
+    {
+        mesh = MeshData{};
+        return false;
+    }
+
+    LOG_INFO("Mesh Importer: {} -> {} vertices, {} triangles", filePath, mesh.vertices.size(), mesh.indices.size() / 3);
+    return true;
+}
+
+std::shared_ptr<VkModel> MeshImporter::LoadModel(VkDeviceInstance* deviceInst, const std::string& filePath)
+{
+    if (GetExtension(filePath) == Core::COOKED_MESH_EXTENSION)
+    {
+        return LoadCookedModel(deviceInst, filePath);
+    }
+
+    MeshData mesh;
+    if (!Import(filePath, mesh) || mesh.indices.empty())
+    {
+        return nullptr;
+    }
+    return std::make_shared<VkModel>(deviceInst, mesh.vertices, mesh.indices);
+}
+
+void MeshImporter::RunParallel(size_t taskCount, const std::function<void(size_t)>& task)
+{
+    std::atomic<size_t> nextTask{0};
+    auto runTasks = [&]() {
+        for (size_t i = nextTask++; i < taskCount; i = nextTask++)
+        {
+            task(i);
+        }
+    };
+
+    size_t helperCount = std::min<size_t>(threadPool_.GetThreadCount(), (taskCount > 0) ? (taskCount - 1) : 0);
+    std::vector<std::future<void>> helpers;
+    helpers.reserve(helperCount);
+    for (size_t i = 0; i < helperCount; ++i)
+    {
+        helpers.push_back(threadPool_.Submit(runTasks));
+    }
+
+    runTasks();
+    for (auto& helper : helpers)
+    {
+        helper.wait();
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+bool MeshImporter::LoadGltfBuffers(const std::string& filePath, GltfDocument& document) const
+{
+    Core::MappedFile file;
+    if (!file.Open(filePath)) { return false; }
+
+    const uint8_t* data = file.GetData();
+    size_t size = file.GetSize();
+    std::string_view jsonText;
+    std::pair<const uint8_t*, size_t> binChunk{nullptr, 0};
+
+    if ((size >= GLB_HEADER_SIZE) && (ReadU32LittleEndian(data) == GLB_MAGIC))
+    {
+        size_t length = ReadU32LittleEndian(data + 8);
+        if ((ReadU32LittleEndian(data + 4) != 2) || (length < GLB_HEADER_SIZE) || (length > size))
+        {
+            LOG_ERROR("Mesh Importer: Unsupported or truncated GLB {}", filePath);
+            return false;
+        }
+
+        // JSON chunk first, then an optional BIN chunk. Unknown chunks are skipped.
+        size_t offset = GLB_HEADER_SIZE;
+        size = length;
+        while ((size - offset) >= GLB_CHUNK_HEADER_SIZE)
+        {
+            size_t chunkSize = ReadU32LittleEndian(data + offset);
+            uint32_t chunkType = ReadU32LittleEndian(data + offset + 4);
+            offset += GLB_CHUNK_HEADER_SIZE;
+            if (chunkSize > (size - offset)) { break; }
+
+            if ((chunkType == GLB_CHUNK_JSON) && jsonText.empty())
+            {
+                jsonText = std::string_view(reinterpret_cast<const char*>(data + offset), chunkSize);
+            }
+            else if ((chunkType == GLB_CHUNK_BIN) && (binChunk.first == nullptr))
+            {
+                binChunk = {data + offset, chunkSize};
+            }
+            offset += chunkSize;
+        }
+    }
+    else
+    {
+        jsonText = std::string_view(reinterpret_cast<const char*>(data), size);
+    }
+
+    std::string error;
+    if (jsonText.empty() || !Core::ParseJson(jsonText, document.json, &error))
+    {
+        LOG_ERROR("Mesh Importer: Invalid glTF JSON in {}: {}", filePath, error);
+        return false;
+    }
+    document.files.push_back(std::move(file));
+
+    const Core::JsonValue& buffers = document.json["buffers"];
+    for (size_t i = 0; i < buffers.GetSize(); ++i)
+    {
+        const Core::JsonValue& buffer = buffers[i];
+        size_t byteLength = buffer["byteLength"].GetUint(0);
+        const std::string& uri = buffer["uri"].GetString();
+
+        std::pair<const uint8_t*, size_t> range{nullptr, 0};
+        if (uri.empty())
+        {
+            // GLB-stored buffer, may be padded past byteLength.
+            range = binChunk;
+        }
+        else if (uri.compare(0, 5, "data:") == 0)
+        {
+            LOG_ERROR("Mesh Importer: Embedded data URIs aren't supported ({})", filePath);
+            return false;
+        }
+        else
+        {
+            Core::MappedFile bufferFile;
+            if (!bufferFile.Open(GetDirectory(filePath) + uri)) { return false; }
+
+            range = {bufferFile.GetData(), bufferFile.GetSize()};
+            bufferFile.Prefetch(0, bufferFile.GetSize());
+            document.files.push_back(std::move(bufferFile));
+        }
+
+        if ((range.first == nullptr) || (range.second < byteLength))
+        {
+            LOG_ERROR("Mesh Importer: Buffer {} of {} is missing or truncated", i, filePath);
+            return false;
+        }
+        document.buffers.push_back({range.first, byteLength});
+    }
+    return true;
+}
+
+bool MeshImporter::ResolveAccessor(const GltfDocument& document, uint32_t accessorIndex, AccessorView& view) const
+{
+    const Core::JsonValue& accessor = document.json["accessors"][accessorIndex];
+    if (!accessor.IsObject())
+    {
+        LOG_ERROR("Mesh Importer: Missing accessor {}", accessorIndex);
+        return false;
+    }
+    if (accessor.Has("sparse"))
+    {
+        LOG_ERROR("Mesh Importer: Sparse accessors aren't supported (accessor {})", accessorIndex);
+        return false;
+    }
+
+    const Core::JsonValue& bufferView = document.json["bufferViews"][accessor["bufferView"].GetUint(UINT32_MAX)];
+    uint32_t bufferIndex = bufferView["buffer"].GetUint(UINT32_MAX);
+    if (!bufferView.IsObject() || (bufferIndex >= document.buffers.size()))
+    {
+        LOG_ERROR("Mesh Importer: Accessor {} has no valid buffer view", accessorIndex);
+        return false;
+    }
+
+    view.componentType = accessor["componentType"].GetUint(0);
+    view.componentCount = GetComponentCount(accessor["type"].GetString());
+    view.normalized = accessor["normalized"].GetBool(false);
+    view.count = accessor["count"].GetUint(0);
+
+    size_t elementSize = static_cast<size_t>(GetComponentSize(view.componentType)) * view.componentCount;
+    view.stride = bufferView["byteStride"].GetUint(0);
+    if (view.stride == 0)
+    {
+        view.stride = elementSize;
+    }
+
+    // Everything in 64 bits, the sums can't overflow from 32 bit JSON values.
+    const auto& buffer = document.buffers[bufferIndex];
+    size_t viewOffset = bufferView["byteOffset"].GetUint(0);
+    size_t viewLength = bufferView["byteLength"].GetUint(0);
+    size_t accessorOffset = accessor["byteOffset"].GetUint(0);
+
+    bool valid = (elementSize > 0) && (view.stride >= elementSize) && ((viewOffset + viewLength) <= buffer.second);
+    if (valid && (view.count > 0))
+    {
+        valid = (accessorOffset + (view.stride * (view.count - 1)) + elementSize) <= viewLength;
+    }
+
+    if (!valid)
+    {
+        LOG_ERROR("Mesh Importer: Accessor {} is out of bounds or has an invalid layout", accessorIndex);
+        return false;
+    }
+
+    view.data = buffer.first + viewOffset + accessorOffset;
+    return true;
+}
+
+bool MeshImporter::CollectNodes(
+    const GltfDocument& document,
+    uint32_t nodeIndex,
+    const glm::mat4& parentTransform,
+    uint32_t depth,
+    std::vector<bool>& visitedNodes,
+    std::vector<std::pair<uint32_t, glm::mat4>>& meshInstances) const
+{
+    const Core::JsonValue& node = document.json["nodes"][nodeIndex];
+    if (!node.IsObject() || (depth > GLTF_MAX_NODE_DEPTH))
+    {
+        LOG_WARN("Mesh Importer: Skipping invalid node {}", nodeIndex);
+        return true;
+    }
+
+    // A node reached twice is either shared or part of a cycle, both break the tree.
+    if (visitedNodes[nodeIndex])
+    {
+        LOG_ERROR("Mesh Importer: Node {} has more than one parent", nodeIndex);
+        return false;
+    }
+    visitedNodes[nodeIndex] = true;
+
+    glm::mat4 transform = parentTransform * GetNodeTransform(node);
+    if (node.Has("mesh"))
+    {
+        if (meshInstances.size() >= GLTF_MAX_MESH_INSTANCES)
+        {
+            LOG_ERROR("Mesh Importer: More than {} mesh instances", GLTF_MAX_MESH_INSTANCES);
+            return false;
+        }
+        meshInstances.push_back({node["mesh"].GetUint(UINT32_MAX), transform});
+    }
+
+    const Core::JsonValue& children = node["children"];
+    for (size_t i = 0; i < children.GetSize(); ++i)
+    {
+        if (!CollectNodes(document, children[i].GetUint(UINT32_MAX), transform, depth + 1, visitedNodes, meshInstances))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MeshImporter::AddPrimitive(
+    const GltfDocument& document,
+    const Core::JsonValue& primitive,
+    const glm::mat4& transform,
+    std::vector<PrimitiveJob>& jobs) const
+{
+    if (primitive["mode"].GetUint(GLTF_TRIANGLES) != GLTF_TRIANGLES)
+    {
+        LOG_WARN("Mesh Importer: Skipping a non triangle list primitive");
+        return true;
+    }
+
+    PrimitiveJob job;
+    job.transform = transform;
+
+    const Core::JsonValue& attributes = primitive["attributes"];
+    if (!ResolveAccessor(document, attributes["POSITION"].GetUint(UINT32_MAX), job.positions) ||
+        (job.positions.componentCount != 3))
+    {
+        LOG_ERROR("Mesh Importer: Primitive without a VEC3 POSITION");
+        return false;
+    }
+
+    if (attributes.Has("COLOR_0"))
+    {
+        if (!ResolveAccessor(document, attributes["COLOR_0"].GetUint(UINT32_MAX), job.colors) ||
+            (job.colors.count < job.positions.count) ||
+            ((job.colors.componentCount != 3) && (job.colors.componentCount != 4)))
+        {
+            LOG_ERROR("Mesh Importer: Invalid COLOR_0 attribute");
+            return false;
+        }
+    }
+
+    const Core::JsonValue& material = document.json["materials"][primitive["material"].GetUint(UINT32_MAX)];
+    const Core::JsonValue& baseColor = material["pbrMetallicRoughness"]["baseColorFactor"];
+    job.baseColor = {baseColor[0].GetFloat(1.0f), baseColor[1].GetFloat(1.0f), baseColor[2].GetFloat(1.0f)};
+
+    size_t indexCount = job.positions.count;
+    if (primitive.Has("indices"))
+    {
+        if (!ResolveAccessor(document, primitive["indices"].GetUint(UINT32_MAX), job.indices) ||
+            (job.indices.componentCount != 1) ||
+            ((job.indices.componentType != GLTF_UNSIGNED_BYTE) &&
+             (job.indices.componentType != GLTF_UNSIGNED_SHORT) &&
+             (job.indices.componentType != GLTF_UNSIGNED_INT)))
+        {
+            LOG_ERROR("Mesh Importer: Invalid index accessor");
+            return false;
+        }
+        indexCount = job.indices.count;
+    }
+
+    // A trailing partial triangle would shift every following one.
+    job.indexCount = indexCount - (indexCount % 3);
+
+    if (!jobs.empty())
+    {
+        job.vertexBase = jobs.back().vertexBase + jobs.back().positions.count;
+        job.indexBase = jobs.back().indexBase + jobs.back().indexCount;
+    }
+    jobs.push_back(job);
+    return true;
+}
+
+bool MeshImporter::ImportGltf(const std::string& filePath, MeshData& mesh)
+{
+    GltfDocument document;
+    if (!LoadGltfBuffers(filePath, document)) { return false; }
+
+    const Core::JsonValue& json = document.json;
+
+    // Default scene, or every mesh untransformed when the file has no scenes.
+    std::vector<std::pair<uint32_t, glm::mat4>> meshInstances;
+    const Core::JsonValue& scenes = json["scenes"];
+    if (scenes.GetSize() > 0)
+    {
+        const Core::JsonValue& rootNodes = scenes[json["scene"].GetUint(0)]["nodes"];
+        std::vector<bool> visitedNodes(json["nodes"].GetSize(), false);
+        for (size_t i = 0; i < rootNodes.GetSize(); ++i)
+        {
+            if (!CollectNodes(document, rootNodes[i].GetUint(UINT32_MAX), glm::mat4(1.0f), 0, visitedNodes, meshInstances))
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < json["meshes"].GetSize(); ++i)
+        {
+            meshInstances.push_back({i, glm::mat4(1.0f)});
+        }
+    }
+
+    // Checked as the jobs are added, before anything the size of the output is allocated.
+    std::vector<PrimitiveJob> jobs;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (const auto& instance : meshInstances)
+    {
+        const Core::JsonValue& primitives = json["meshes"][instance.first]["primitives"];
+        for (size_t i = 0; i < primitives.GetSize(); ++i)
+        {
+            if (!AddPrimitive(document, primitives[i], instance.second, jobs)) { return false; }
+            if (jobs.empty()) { continue; }
+
+            vertexCount = jobs.back().vertexBase + jobs.back().positions.count;
+            indexCount = jobs.back().indexBase + jobs.back().indexCount;
+            if ((vertexCount > UINT32_MAX) || (indexCount > UINT32_MAX))
+            {
+                LOG_ERROR("Mesh Importer: {} has more than 2^32 vertices or indices", filePath);
+                return false;
+            }
+
+            uint64_t outputBytes = (vertexCount * sizeof(Vertex)) + (indexCount * sizeof(uint32_t));
+            if (outputBytes > MESH_IMPORT_MAX_BYTES)
+            {
+                LOG_ERROR("Mesh Importer: {} expands to more than {} bytes", filePath, MESH_IMPORT_MAX_BYTES);
+                return false;
+            }
+        }
+    }
+
+    if (jobs.empty())
+    {
+        LOG_ERROR("Mesh Importer: No triangle primitives in {}", filePath);
+        return false;
+    }
+
+    mesh.vertices.resize(vertexCount);
+    mesh.indices.resize(indexCount);
+
+    // Flat task list over every primitive, so a few large primitives still spread over
+    // all workers and many small ones don't cost a task each.
+    struct ChunkTask
+    {
+        uint32_t job;
+        bool indices;
+        size_t begin;
+        size_t end;
+    };
+
+    std::vector<ChunkTask> tasks;
+    for (uint32_t i = 0; i < jobs.size(); ++i)
+    {
+        for (size_t begin = 0; begin < jobs[i].positions.count; begin += MESH_IMPORT_CHUNK_SIZE)
+        {
+            tasks.push_back({i, false, begin, std::min<size_t>(begin + MESH_IMPORT_CHUNK_SIZE, jobs[i].positions.count)});
+        }
+        for (size_t begin = 0; begin < jobs[i].indexCount; begin += MESH_IMPORT_CHUNK_SIZE)
+        {
+            tasks.push_back({i, true, begin, std::min<size_t>(begin + MESH_IMPORT_CHUNK_SIZE, jobs[i].indexCount)});
+        }
+    }
+
+    std::atomic<bool> indicesValid{true};
+    RunParallel(tasks.size(), [&](size_t taskIndex) {
+        const ChunkTask& task = tasks[taskIndex];
+        const PrimitiveJob& job = jobs[task.job];
+
+        if (task.indices)
+        {
+            uint32_t* dst = mesh.indices.data() + job.indexBase;
+            for (size_t i = task.begin; i < task.end; ++i)
+            {
+                size_t index = (job.indices.data != nullptr)
+                    ? ReadIndex(job.indices.data + (i * job.indices.stride), job.indices.componentType)
+                    : i;
+                if (index >= job.positions.count)
+                {
+                    indicesValid = false;
+                    index = 0;
+                }
+                dst[i] = static_cast<uint32_t>(job.vertexBase + index);
+            }
+            return;
+        }
+
+        const AccessorView& positions = job.positions;
+        const AccessorView& colors = job.colors;
+        uint32_t positionSize = GetComponentSize(positions.componentType);
+        uint32_t colorSize = GetComponentSize(colors.componentType);
+
+        Vertex* dst = mesh.vertices.data() + job.vertexBase;
+        for (size_t i = task.begin; i < task.end; ++i)
+        {
+            const uint8_t* src = positions.data + (i * positions.stride);
+            glm::vec4 position{
+                ReadComponent(src, positions.componentType, positions.normalized),
+                ReadComponent(src + positionSize, positions.componentType, positions.normalized),
+                ReadComponent(src + (2 * positionSize), positions.componentType, positions.normalized),
+                1.0f};
+            position = job.transform * position;
+            dst[i].position = {position.x, position.y};
+
+            if (colors.data != nullptr)
+            {
+                const uint8_t* color = colors.data + (i * colors.stride);
+                dst[i].color = {
+                    ReadComponent(color, colors.componentType, colors.normalized),
+                    ReadComponent(color + colorSize, colors.componentType, colors.normalized),
+                    ReadComponent(color + (2 * colorSize), colors.componentType, colors.normalized)};
+            }
+            else
+            {
+                dst[i].color = job.baseColor;
+            }
+        }
+    });
+
+    if (!indicesValid)
+    {
+        LOG_ERROR("Mesh Importer: {} has out of range indices", filePath);
+        return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------//
+
+bool MeshImporter::ImportObj(const std::string& filePath, MeshData& mesh)
+{
+    Core::MappedFile file;
+    if (!file.Open(filePath)) { return false; }
+    file.Prefetch(0, file.GetSize());
+
+    // Whole lines per chunk, so every statement is parsed by a single task.
+    struct ObjChunk
+    {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        size_t vertexBase = 0;
+        size_t vertexCount = 0;
+        size_t indexBase = 0;
+        std::vector<uint32_t> indices;
+    };
+
+    const char* text = reinterpret_cast<const char*>(file.GetData());
+    const char* textEnd = text + file.GetSize();
+
+    std::vector<ObjChunk> chunks;
+    for (const char* begin = text; begin < textEnd;)
+    {
+        const char* end = begin + std::min<size_t>(MESH_IMPORT_OBJ_CHUNK_BYTES, static_cast<size_t>(textEnd - begin));
+        const char* newline = static_cast<const char*>(std::memchr(end - 1, '\n', static_cast<size_t>(textEnd - (end - 1))));
+        end = (newline != nullptr) ? (newline + 1) : textEnd;
+
+        ObjChunk chunk;
+        chunk.begin = begin;
+        chunk.end = end;
+        chunks.push_back(std::move(chunk));
+        begin = end;
+    }
+
+    auto forEachLine = [](const ObjChunk& chunk, auto&& callback) {
+        for (const char* line = chunk.begin; line < chunk.end;)
+        {
+            const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(chunk.end - line)));
+            const char* lineEnd = (newline != nullptr) ? newline : chunk.end;
+
+            const char* cursor = line;
+            SkipObjSpaces(cursor, lineEnd);
+            callback(cursor, lineEnd);
+            line = lineEnd + 1;
+        }
+    };
+
+    // Pass 1 : vertices per chunk, so pass 2 knows where each chunk writes and can
+    // resolve relative (negative) indices.
+    RunParallel(chunks.size(), [&](size_t chunkIndex) {
+        ObjChunk& chunk = chunks[chunkIndex];
+        forEachLine(chunk, [&chunk](const char* cursor, const char* lineEnd) {
+            if (IsObjStatement(cursor, lineEnd, 'v')) { chunk.vertexCount++; }
+        });
+    });
+
+    size_t vertexCount = 0;
+    for (ObjChunk& chunk : chunks)
+    {
+        chunk.vertexBase = vertexCount;
+        vertexCount += chunk.vertexCount;
+    }
+
+    if ((vertexCount == 0) || (vertexCount > UINT32_MAX))
+    {
+        LOG_ERROR("Mesh Importer: {} has no vertices or more than 2^32", filePath);
+        return false;
+    }
+    mesh.vertices.resize(vertexCount);
+
+    // Pass 2 : "v x y z [r g b]" and "f a b c ..." (a, a/t, a//n or a/t/n), polygons
+    // are fanned into triangles. Other statements are ignored.
+    std::atomic<bool> valid{true};
+    RunParallel(chunks.size(), [&](size_t chunkIndex) {
+        ObjChunk& chunk = chunks[chunkIndex];
+        size_t vertexIndex = chunk.vertexBase;
+        std::vector<uint32_t> face;
+
+        forEachLine(chunk, [&](const char* cursor, const char* lineEnd) {
+            if (IsObjStatement(cursor, lineEnd, 'v'))
+            {
+                cursor++;
+                Vertex& vertex = mesh.vertices[vertexIndex++];
+                float z = 0.0f;
+                if (!ParseObjFloat(cursor, lineEnd, vertex.position.x) ||
+                    !ParseObjFloat(cursor, lineEnd, vertex.position.y) ||
+                    !ParseObjFloat(cursor, lineEnd, z))
+                {
+                    valid = false;
+                    return;
+                }
+
+                glm::vec3 color{1.0f};
+                if (ParseObjFloat(cursor, lineEnd, color.r) &&
+                    ParseObjFloat(cursor, lineEnd, color.g) &&
+                    ParseObjFloat(cursor, lineEnd, color.b))
+                {
+                    vertex.color = color;
+                }
+                else
+                {
+                    vertex.color = glm::vec3{1.0f};
+                }
+            }
+            else if (IsObjStatement(cursor, lineEnd, 'f'))
+            {
+                cursor++;
+                face.clear();
+                while (true)
+                {
+                    SkipObjSpaces(cursor, lineEnd);
+                    if (cursor >= lineEnd) { break; }
+
+                    int64_t index = 0;
+                    if (!ParseObjInt(cursor, lineEnd, index))
+                    {
+                        valid = false;
+                        return;
+                    }
+
+                    // 1 based, negative counts back from the last vertex read.
+                    int64_t resolved = (index > 0) ? (index - 1) : (static_cast<int64_t>(vertexIndex) + index);
+                    if ((index == 0) || (resolved < 0) || (static_cast<size_t>(resolved) >= vertexCount))
+                    {
+                        valid = false;
+                        return;
+                    }
+                    face.push_back(static_cast<uint32_t>(resolved));
+
+                    // Texture coordinate and normal references.
+                    while ((cursor < lineEnd) && !IsObjSpace(*cursor)) { cursor++; }
+                }
+
+                for (size_t i = 2; i < face.size(); ++i)
+                {
+                    chunk.indices.push_back(face[0]);
+                    chunk.indices.push_back(face[i - 1]);
+                    chunk.indices.push_back(face[i]);
+                }
+            }
+        });
+    });
+
+    if (!valid)
+    {
+        LOG_ERROR("Mesh Importer: Malformed vertex or face statement in {}", filePath);
+        return false;
+    }
+
+    size_t indexCount = 0;
+    for (ObjChunk& chunk : chunks)
+    {
+        chunk.indexBase = indexCount;
+        indexCount += chunk.indices.size();
+    }
+
+    if ((indexCount == 0) || (indexCount > UINT32_MAX))
+    {
+        LOG_ERROR("Mesh Importer: {} has no faces or more than 2^32 indices", filePath);
+        return false;
+    }
+
+    mesh.indices.resize(indexCount);
+    RunParallel(chunks.size(), [&](size_t chunkIndex) {
+        const ObjChunk& chunk = chunks[chunkIndex];
+        std::copy(chunk.indices.begin(), chunk.indices.end(), mesh.indices.begin() + chunk.indexBase);
+    });
+    return true;
+}
+
+} // namespace Graphic
@@ -1,6 +1,8 @@
-#include <Graphics/Pipeline/SimpleRenderPipeline.hpp>
+#include <Graphics/Pipeline/SimpleRenderPipeline.ipp>
 #include <Graphics/Vulkan/VkInstanceImpl.ipp>
 #include <Graphics/Vulkan/VkUtil.ipp>
+#include <Graphics/Vulkan/VkGlobalUboImpl.ipp>
+#include <Core/Profiler.ipp>
 
 // External Lib
 #define GLM_FORCE_RADIANS
@@ -20,33 +22,44 @@ struct SimplePushConstants
 
 
 SimpleRenderPipeline::SimpleRenderPipeline(
-    VkDeviceInstance* deviceInst, VkRenderPass renderPass) :
-    deviceInst_(deviceInst)
+    VkDeviceInstance* deviceInst,
+    GlobalUniformBuffer* globalUniforms,
+    const RenderTargetInfo& renderTarget,
+    AsyncPipelineBuilder* pipelineBuilder) :
+    deviceInst_(deviceInst), globalUniforms_(globalUniforms)
 {
     CreatePipelineLayout();
-    CreatePipeline(renderPass);
+    CreatePipeline(renderTarget, pipelineBuilder);
 }
 
 SimpleRenderPipeline::~SimpleRenderPipeline()
 {
+    // The layout must outlive any compile still running on a worker.
+    variants_.reset();
+
     if (pipelineLayout_ != VK_NULL_HANDLE)
     {
-        vkDestroyPipelineLayout(deviceInst_->GetLogicalDevice(), pipelineLayout_, nullptr);
+        vkDestroyPipelineLayout(deviceInst_->GetLogicalDevice(), pipelineLayout_, deviceInst_->GetAllocator());
     }
 }
 
-void SimpleRenderPipeline::CreatePipeline(VkRenderPass renderPass)
+void SimpleRenderPipeline::CreatePipeline(const RenderTargetInfo& renderTarget, AsyncPipelineBuilder* pipelineBuilder)
 {
     PipelineConfigInfo pipeConfig = {};
     GraphicPipeline::DefaultPipelineConfigInfo(pipeConfig);
-    pipeConfig.renderPass = renderPass;
+    pipeConfig.renderTarget = renderTarget;
     pipeConfig.pipelineLayout = pipelineLayout_;
 
-    pipeline_ = std::make_unique<GraphicPipeline>(
+    // Every variant is built from the same SPIR-V, only the specialization constants differ.
+    variants_ = std::make_unique<PipelineVariantCache>(
         deviceInst_,
         VERT_SHADER_PATH,
         FRAG_SHADER_PATH,
-        pipeConfig);
+        pipeConfig,
+        pipelineBuilder);
+
+    // Kick off the default variant right away.
+    variants_->GetOrCreate(ShaderPermutation{});
 }
 
 void SimpleRenderPipeline::CreatePipelineLayout()
@@ -57,31 +70,52 @@ void SimpleRenderPipeline::CreatePipelineLayout()
     pushConstantRange.offset = 0;
     pushConstantRange.size = sizeof(SimplePushConstants);
 
+    // Set 0 : per frame globals (camera, time, viewport)
+    VkDescriptorSetLayout globalSetLayout = globalUniforms_->GetDescriptorSetLayout();
+
     VkPipelineLayoutCreateInfo pipeLayoutInfo = {};
     pipeLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipeLayoutInfo.setLayoutCount = 0;
-    pipeLayoutInfo.pSetLayouts = nullptr;
+    pipeLayoutInfo.setLayoutCount = 1;
+    pipeLayoutInfo.pSetLayouts = &globalSetLayout;
     pipeLayoutInfo.pushConstantRangeCount = 1;
     pipeLayoutInfo.pPushConstantRanges = &pushConstantRange;
 
     VK_CHECK(
-        vkCreatePipelineLayout(deviceInst_->GetLogicalDevice(), &pipeLayoutInfo, nullptr, &pipelineLayout_),
+        vkCreatePipelineLayout(deviceInst_->GetLogicalDevice(), &pipeLayoutInfo, deviceInst_->GetAllocator(), &pipelineLayout_),
         "Pipeline Layout: Failed to create Pipeline Layout"
     )
 
 }
 
 void SimpleRenderPipeline::RenderGameObjects(
-    VkCommandBuffer cmdBuffer, std::vector<GameObject>& gameObjects)
+    VkCommandBuffer cmdBuffer,
+    std::vector<GameObject>& gameObjects,
+    const ShaderPermutation& permutation,
+    const char* profileName)
 {
+    PROFILE_SCOPE("SimpleRenderPipeline::RenderGameObjects");
 
     // Apply colour !!
     // rainbow_.update(0.05f ,gameObjects);
 
-    pipeline_->BindPipeline(cmdBuffer);
+    GraphicPipeline* pipeline = GetPipeline(permutation);
+    if (pipeline == nullptr)
+    {
+        // Still compiling, draw with the fallback if there is one.
+        pipeline = fallbackPipeline_;
+    }
+    if (pipeline == nullptr) { return; }
+
+    GpuProfileScope profileScope(profiler_, cmdBuffer, profileName);
+
+    pipeline->BindPipeline(cmdBuffer);
+    globalUniforms_->Bind(cmdBuffer, pipelineLayout_);
 
     for (auto& obj : gameObjects)
     {
+        // Still uploading on the transfer queue
+        if (!obj.model->IsReady()) { continue; }
+
         // Triangle vertex
         // obj.transform2d.rotation = glm::mod(obj.transform2d.rotation + 0.01f, glm::two_pi<float>());
 
@@ -0,0 +1,134 @@
+#include <Graphics/Pipeline/SpriteRenderPipeline.ipp>
+#include <Graphics/TextureManager.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkGlobalUboImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Graphics/VkModel.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+namespace Graphic
+{
+
+// Matches Push in sprite_shader.vert / sprite_shader.frag.
+struct SpritePushConstants
+{
+    glm::mat2 transform{1.0f};
+    glm::vec2 offset;
+    alignas(16) glm::vec3 tint;
+};
+
+SpriteRenderPipeline::SpriteRenderPipeline(
+    VkDeviceInstance* deviceInst,
+    GlobalUniformBuffer* globalUniforms,
+    TextureManager* textureManager,
+    const RenderTargetInfo& renderTarget)
+    : deviceInst_(deviceInst), globalUniforms_(globalUniforms), textureManager_(textureManager)
+{
+    CreatePipelineLayout();
+    CreatePipeline(renderTarget);
+
+    if (!IsReady())
+    {
+        LOG_WARN("Sprite Render: Shaders unavailable, sprites are skipped");
+    }
+}
+
+SpriteRenderPipeline::~SpriteRenderPipeline()
+{
+    pipeline_.reset();
+    vkDestroyPipelineLayout(deviceInst_->GetLogicalDevice(), pipelineLayout_, deviceInst_->GetAllocator());
+}
+
+void SpriteRenderPipeline::CreatePipelineLayout()
+{
+    VkPushConstantRange pushConstantRange = {};
+    pushConstantRange.stageFlags = (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(SpritePushConstants);
+
+    // Set 0 : per frame globals, set 1 : sprite texture
+    VkDescriptorSetLayout setLayouts[] = {
+        globalUniforms_->GetDescriptorSetLayout(),
+        textureManager_->GetDescriptorSetLayout()};
+
+    VkPipelineLayoutCreateInfo pipeLayoutInfo = {};
+    pipeLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeLayoutInfo.setLayoutCount = 2;
+    pipeLayoutInfo.pSetLayouts = setLayouts;
+    pipeLayoutInfo.pushConstantRangeCount = 1;
+    pipeLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    VK_CHECK(
+        vkCreatePipelineLayout(deviceInst_->GetLogicalDevice(), &pipeLayoutInfo, deviceInst_->GetAllocator(), &pipelineLayout_),
+        "Sprite Render: Failed to create Pipeline Layout"
+    )
+}
+
+void SpriteRenderPipeline::CreatePipeline(const RenderTargetInfo& renderTarget)
+{
+    PipelineConfigInfo pipeConfig = {};
+    GraphicPipeline::DefaultPipelineConfigInfo(pipeConfig);
+    pipeConfig.renderTarget = renderTarget;
+    pipeConfig.pipelineLayout = pipelineLayout_;
+
+    // Drawn over the scene in submission order, straight alpha.
+    pipeConfig.depthStencilInfo.depthTestEnable = VK_FALSE;
+    pipeConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
+    pipeConfig.colorBlendAttachment.blendEnable = VK_TRUE;
+    pipeConfig.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    pipeConfig.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    pipeConfig.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    pipeConfig.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+
+    pipeline_ = std::make_unique<GraphicPipeline>(
+        deviceInst_, SPRITE_VERT_SHADER_PATH, SPRITE_FRAG_SHADER_PATH, pipeConfig);
+}
+
+void SpriteRenderPipeline::RenderSprites(
+    VkCommandBuffer cmdBuffer,
+    std::vector<GameObject>& sprites,
+    TextureHandle texture,
+    const char* profileName)
+{
+    PROFILE_SCOPE("SpriteRenderPipeline::RenderSprites");
+
+    if (!IsReady() || sprites.empty()) { return; }
+
+    GpuProfileScope profileScope(profiler_, cmdBuffer, profileName);
+
+    // Also marks the texture as used by this frame for the residency LRU.
+    VkDescriptorSet textureSet = textureManager_->GetDescriptorSet(texture);
+
+    pipeline_->BindPipeline(cmdBuffer);
+    globalUniforms_->Bind(cmdBuffer, pipelineLayout_);
+    vkCmdBindDescriptorSets(
+        cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout_, 1, 1, &textureSet, 0, nullptr);
+
+    for (auto& obj : sprites)
+    {
+        // Still uploading on the transfer queue
+        if (!obj.model->IsReady()) { continue; }
+
+        SpritePushConstants push = {};
+        push.offset = obj.transform2d.translation;
+        push.tint = obj.color;
+        push.transform = obj.transform2d.mat2();
+
+        vkCmdPushConstants(
+            cmdBuffer,
+            pipelineLayout_,
+            (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT),
+            0,
+            sizeof(SpritePushConstants),
+            &push
+        );
+
+        obj.model->Bind(cmdBuffer);
+        obj.model->Draw(cmdBuffer);
+    }
+}
+
+} // namespace Graphic
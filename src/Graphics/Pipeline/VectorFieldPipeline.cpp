@@ -0,0 +1,293 @@
+#include <Graphics/Pipeline/VectorFieldPipeline.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkAsyncComputeImpl.ipp>
+#include <Graphics/Vulkan/VkGlobalUboImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Graphics/VkModel.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <cassert>
+
+namespace Graphic
+{
+
+// Matches FieldInstance in vector_field.comp / vector_field.vert (std430).
+struct FieldInstance
+{
+    glm::vec4 transform; // mat2 columns
+    glm::vec4 offset;    // xy, unused
+};
+
+// Matches Push in vector_field.comp.
+struct FieldComputePushConstants
+{
+    glm::vec4 bodies[VECTOR_FIELD_MAX_BODIES]; // position, mass, unused
+    uint32_t bodyCount = 0;
+    uint32_t gridCount = 0;
+    float strength = 0.0f;
+    float sampleMass = 0.0f;
+};
+
+constexpr uint32_t FIELD_WORKGROUP_SIZE = 64;
+
+VectorFieldPipeline::VectorFieldPipeline(
+    VkDeviceInstance* deviceInst,
+    GlobalUniformBuffer* globalUniforms,
+    const RenderTargetInfo& renderTarget,
+    uint32_t gridCount)
+    : deviceInst_(deviceInst), globalUniforms_(globalUniforms), gridCount_(gridCount)
+{
+    CreateDescriptors();
+    CreateInstanceBuffers();
+    CreatePipelineLayouts();
+
+    computePipeline_ = std::make_unique<ComputePipeline>(deviceInst_, VECTOR_FIELD_COMP_SHADER_PATH, computeLayout_);
+
+    PipelineConfigInfo pipeConfig = {};
+    GraphicPipeline::DefaultPipelineConfigInfo(pipeConfig);
+    pipeConfig.renderTarget = renderTarget;
+    pipeConfig.pipelineLayout = graphicsLayout_;
+    graphicsPipeline_ = std::make_unique<GraphicPipeline>(
+        deviceInst_, VECTOR_FIELD_VERT_SHADER_PATH, VECTOR_FIELD_FRAG_SHADER_PATH, pipeConfig);
+
+    if (!IsReady())
+    {
+        LOG_WARN("Vector Field: Shaders unavailable, the field is evaluated on the CPU");
+    }
+}
+
+VectorFieldPipeline::~VectorFieldPipeline()
+{
+    // Caller is expected to have waited for the device to go idle.
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    computePipeline_.reset();
+    graphicsPipeline_.reset();
+    vkDestroyPipelineLayout(device, computeLayout_, deviceInst_->GetAllocator());
+    vkDestroyPipelineLayout(device, graphicsLayout_, deviceInst_->GetAllocator());
+
+    // Frees the sets as well.
+    vkDestroyDescriptorPool(device, descriptorPool_, deviceInst_->GetAllocator());
+    vkDestroyDescriptorSetLayout(device, instanceSetLayout_, deviceInst_->GetAllocator());
+
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        vkDestroyBuffer(device, instanceBuffers_[i], deviceInst_->GetAllocator());
+        deviceInst_->FreeMemory(instanceMemory_[i]);
+    }
+}
+
+void VectorFieldPipeline::CreateDescriptors()
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &binding;
+
+    VK_CHECK(
+        vkCreateDescriptorSetLayout(device, &layoutInfo, deviceInst_->GetAllocator(), &instanceSetLayout_),
+        "Vector Field: Failed to create descriptor set layout !!"
+    )
+
+    VkDescriptorPoolSize poolSize = {};
+    poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize.descriptorCount = MAX_FRAMES_IN_FLIGHT;
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    VK_CHECK(
+        vkCreateDescriptorPool(device, &poolInfo, deviceInst_->GetAllocator(), &descriptorPool_),
+        "Vector Field: Failed to create descriptor pool !!"
+    )
+
+    std::array<VkDescriptorSetLayout, MAX_FRAMES_IN_FLIGHT> setLayouts;
+    setLayouts.fill(instanceSetLayout_);
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool_;
+    allocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
+    allocInfo.pSetLayouts = setLayouts.data();
+
+    VK_CHECK(
+        vkAllocateDescriptorSets(device, &allocInfo, instanceSets_.data()),
+        "Vector Field: Failed to allocate descriptor sets !!"
+    )
+}
+
+void VectorFieldPipeline::CreateInstanceBuffers()
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+    VkDeviceSize size = sizeof(FieldInstance) * std::max(1u, gridCount_ * gridCount_);
+
+    // Written on the compute queue and read on the graphics queue, no ownership transfer.
+    const std::vector<uint32_t>& queueFamilies = deviceInst_->GetAsyncCompute()->GetQueueFamilies();
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (queueFamilies.size() > 1)
+    {
+        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+        bufferInfo.pQueueFamilyIndices = queueFamilies.data();
+    }
+    else
+    {
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        VK_CHECK(
+            vkCreateBuffer(device, &bufferInfo, deviceInst_->GetAllocator(), &instanceBuffers_[i]),
+            "Vector Field: Failed to create instance buffer !!"
+        )
+
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(device, instanceBuffers_[i], &memRequirements);
+
+        VkMemoryAllocateInfo memAllocInfo = {};
+        memAllocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        memAllocInfo.allocationSize = memRequirements.size;
+        memAllocInfo.memoryTypeIndex = deviceInst_->FindMemoryType(
+            memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        VK_CHECK(
+            deviceInst_->AllocateMemory(memAllocInfo, MemoryCategory::Geometry, instanceMemory_[i]),
+            "Vector Field: Failed to allocate instance buffer memory !!"
+        )
+        vkBindBufferMemory(device, instanceBuffers_[i], instanceMemory_[i], 0);
+
+        VkDescriptorBufferInfo descBufferInfo = {};
+        descBufferInfo.buffer = instanceBuffers_[i];
+        descBufferInfo.offset = 0;
+        descBufferInfo.range = size;
+
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = instanceSets_[i];
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &descBufferInfo;
+
+        vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    }
+}
+
+void VectorFieldPipeline::CreatePipelineLayouts()
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    VkPushConstantRange computePushRange = {};
+    computePushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    computePushRange.offset = 0;
+    computePushRange.size = sizeof(FieldComputePushConstants);
+
+    VkPipelineLayoutCreateInfo computeLayoutInfo = {};
+    computeLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    computeLayoutInfo.setLayoutCount = 1;
+    computeLayoutInfo.pSetLayouts = &instanceSetLayout_;
+    computeLayoutInfo.pushConstantRangeCount = 1;
+    computeLayoutInfo.pPushConstantRanges = &computePushRange;
+
+    VK_CHECK(
+        vkCreatePipelineLayout(device, &computeLayoutInfo, deviceInst_->GetAllocator(), &computeLayout_),
+        "Vector Field: Failed to create compute pipeline layout"
+    )
+
+    // Line color
+    VkPushConstantRange graphicsPushRange = {};
+    graphicsPushRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    graphicsPushRange.offset = 0;
+    graphicsPushRange.size = sizeof(glm::vec4);
+
+    // Set 0 : per frame globals, set 1 : instances
+    VkDescriptorSetLayout graphicsSetLayouts[] = {globalUniforms_->GetDescriptorSetLayout(), instanceSetLayout_};
+
+    VkPipelineLayoutCreateInfo graphicsLayoutInfo = {};
+    graphicsLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    graphicsLayoutInfo.setLayoutCount = 2;
+    graphicsLayoutInfo.pSetLayouts = graphicsSetLayouts;
+    graphicsLayoutInfo.pushConstantRangeCount = 1;
+    graphicsLayoutInfo.pPushConstantRanges = &graphicsPushRange;
+
+    VK_CHECK(
+        vkCreatePipelineLayout(device, &graphicsLayoutInfo, deviceInst_->GetAllocator(), &graphicsLayout_),
+        "Vector Field: Failed to create graphics pipeline layout"
+    )
+}
+
+void VectorFieldPipeline::Dispatch(
+    VkCommandBuffer commandBuffer,
+    size_t frameSlot,
+    const std::vector<GameObject>& bodies,
+    float strength)
+{
+    PROFILE_SCOPE("VectorFieldPipeline::Dispatch");
+    assert((frameSlot < MAX_FRAMES_IN_FLIGHT) && "Vector Field: Invalid frame slot");
+
+    FieldComputePushConstants push = {};
+    push.bodyCount = static_cast<uint32_t>(std::min<size_t>(bodies.size(), VECTOR_FIELD_MAX_BODIES));
+    push.gridCount = gridCount_;
+    push.strength = strength;
+    push.sampleMass = RigidBody2dCompoenent{}.mass; // Field lines have the default mass
+    for (uint32_t i = 0; i < push.bodyCount; i++)
+    {
+        const GameObject& body = bodies[i];
+        push.bodies[i] = glm::vec4(body.transform2d.translation, body.rigidBody2d.mass, 0.0f);
+    }
+
+    computePipeline_->BindPipeline(commandBuffer);
+    vkCmdBindDescriptorSets(
+        commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computeLayout_, 0, 1, &instanceSets_[frameSlot], 0, nullptr);
+    vkCmdPushConstants(
+        commandBuffer, computeLayout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FieldComputePushConstants), &push);
+
+    uint32_t instanceCount = gridCount_ * gridCount_;
+    vkCmdDispatch(commandBuffer, (instanceCount + FIELD_WORKGROUP_SIZE - 1) / FIELD_WORKGROUP_SIZE, 1, 1);
+
+    lastSlot_ = frameSlot;
+}
+
+void VectorFieldPipeline::Render(VkCommandBuffer commandBuffer, VkModel& model, const glm::vec3& color)
+{
+    PROFILE_SCOPE("VectorFieldPipeline::Render");
+
+    // Nothing dispatched yet, or the vertex buffer is still uploading
+    if ((lastSlot_ == SIZE_MAX) || !model.IsReady()) { return; }
+
+    GpuProfileScope profileScope(profiler_, commandBuffer, "VectorField");
+
+    graphicsPipeline_->BindPipeline(commandBuffer);
+    globalUniforms_->Bind(commandBuffer, graphicsLayout_);
+    vkCmdBindDescriptorSets(
+        commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsLayout_, 1, 1, &instanceSets_[lastSlot_], 0, nullptr);
+
+    glm::vec4 push(color, 1.0f);
+    vkCmdPushConstants(commandBuffer, graphicsLayout_, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::vec4), &push);
+
+    model.Bind(commandBuffer);
+    model.Draw(commandBuffer, 0, gridCount_ * gridCount_);
+}
+
+} // namespace Graphic
@@ -0,0 +1,706 @@
+#include <Graphics/RenderGraph.ipp>
+#include <Graphics/Renderer.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <numeric>
+
+namespace Graphic
+{
+
+namespace
+{
+
+struct AccessInfo
+{
+    VkImageLayout layout;
+    VkPipelineStageFlags2 stage;
+    VkAccessFlags2 access;
+    VkImageUsageFlags usage;
+};
+
+// Only flags that exist in the legacy enums as well, FlushBarriers relies on it.
+AccessInfo GetAccessInfo(RGAccess access, RGPassType passType)
+{
+    VkPipelineStageFlags2 shaderStage = (passType == RGPassType::Compute) ?
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+
+    switch (access)
+    {
+    case RGAccess::ColorAttachment:
+        return {VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT};
+    case RGAccess::DepthAttachment:
+        return {VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT};
+    case RGAccess::SampledRead:
+        return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, shaderStage,
+                VK_ACCESS_2_SHADER_READ_BIT, VK_IMAGE_USAGE_SAMPLED_BIT};
+    case RGAccess::StorageRead:
+        return {VK_IMAGE_LAYOUT_GENERAL, shaderStage,
+                VK_ACCESS_2_SHADER_READ_BIT, VK_IMAGE_USAGE_STORAGE_BIT};
+    case RGAccess::StorageWrite:
+        return {VK_IMAGE_LAYOUT_GENERAL, shaderStage,
+                VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_USAGE_STORAGE_BIT};
+    case RGAccess::TransferSrc:
+        return {VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_USAGE_TRANSFER_SRC_BIT};
+    case RGAccess::TransferDst:
+        return {VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_USAGE_TRANSFER_DST_BIT};
+    }
+
+    return {VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+            VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT, 0};
+}
+
+bool IsWriteAccess(RGAccess access)
+{
+    return (access == RGAccess::ColorAttachment) || (access == RGAccess::DepthAttachment) ||
+           (access == RGAccess::StorageWrite) || (access == RGAccess::TransferDst);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------//
+
+RGResource RenderGraphBuilder::CreateImage(const char* name, const RGImageDesc& desc)
+{
+    RenderGraph::ResourceNode node;
+    node.name = name;
+    node.desc = desc;
+
+    graph_->resources_.push_back(node);
+    return RGResource{static_cast<uint32_t>(graph_->resources_.size() - 1)};
+}
+
+RenderGraphBuilder& RenderGraphBuilder::Read(RGResource resource, RGAccess access)
+{
+    assert(resource.IsValid() && !IsWriteAccess(access) && "Render Graph: Invalid read");
+    graph_->passes_[passIdx_].accesses.push_back({resource.id, access, false});
+    return *this;
+}
+
+RenderGraphBuilder& RenderGraphBuilder::Write(RGResource resource, RGAccess access)
+{
+    assert(resource.IsValid() && IsWriteAccess(access) && "Render Graph: Invalid write");
+
+    RenderGraph::PassNode& pass = graph_->passes_[passIdx_];
+    pass.accesses.push_back({resource.id, access, true});
+
+    // What ends up on screen is the one output that is always needed.
+    if (graph_->resources_[resource.id].imported)
+    {
+        assert((pass.type == RGPassType::Raster) && (access == RGAccess::ColorAttachment) &&
+               "Render Graph: The backbuffer is only written as color attachment");
+        pass.swapchainPass = true;
+        pass.sideEffect = true;
+    }
+    return *this;
+}
+
+RenderGraphBuilder& RenderGraphBuilder::SetSideEffect()
+{
+    graph_->passes_[passIdx_].sideEffect = true;
+    return *this;
+}
+
+//----------------------------------------------------------------------------//
+
+RenderGraph::RenderGraph(VkDeviceInstance* deviceInst, Renderer* renderer)
+    : deviceInst_(deviceInst), renderer_(renderer)
+{
+    frames_.resize(renderer->GetFramesInFlight());
+    Reset();
+}
+
+RenderGraph::~RenderGraph()
+{
+    // Caller is expected to have waited for the device to go idle.
+    for (FrameResources& frame : frames_)
+    {
+        DestroyResources(frame);
+    }
+}
+
+void RenderGraph::Reset()
+{
+    passes_.clear();
+    resources_.clear();
+    executionOrder_.clear();
+
+    ResourceNode backbuffer;
+    backbuffer.name = "Backbuffer";
+    backbuffer.imported = true;
+    resources_.push_back(backbuffer);
+}
+
+RenderGraphBuilder RenderGraph::AddPass(const char* name, RGPassType type, ExecuteFn execute)
+{
+    PassNode pass;
+    pass.name = name;
+    pass.type = type;
+    pass.execute = std::move(execute);
+
+    passes_.push_back(std::move(pass));
+    return RenderGraphBuilder(this, static_cast<uint32_t>(passes_.size() - 1));
+}
+
+VkExtent2D RenderGraph::ResolveExtent(const RGImageDesc& desc) const
+{
+    if ((desc.extent.width == 0) || (desc.extent.height == 0))
+    {
+        return renderer_->GetSwapChainExtent();
+    }
+    return desc.extent;
+}
+
+//----------------------------------------------------------------------------//
+
+void RenderGraph::CullPasses()
+{
+    bool dynamicRendering = deviceInst_->IsDynamicRenderingEnabled();
+
+    for (PassNode& pass : passes_)
+    {
+        for (const PassAccess& use : pass.accesses)
+        {
+            if (use.write)
+            {
+                pass.refCount++;
+            }
+            else
+            {
+                resources_[use.resource].refCount++;
+            }
+        }
+
+        // Transient attachments are begun with vkCmdBeginRendering, nothing to fall back on.
+        bool transientAttachment = (pass.type == RGPassType::Raster) && !pass.swapchainPass &&
+            std::any_of(pass.accesses.begin(), pass.accesses.end(), [](const PassAccess& use) {
+                return use.write; });
+        if (transientAttachment && !dynamicRendering)
+        {
+            if (!loggedDynamicRendering_)
+            {
+                LOG_ERROR("Render Graph: Pass {} renders to transient images without dynamic rendering, skipped", pass.name);
+                loggedDynamicRendering_ = true;
+            }
+            pass.culled = true;
+            pass.sideEffect = false;
+        }
+    }
+
+    // Resources nobody reads make their writers redundant, which may leave the resources
+    // those writers read unused in turn.
+    std::vector<uint32_t> unused;
+    for (uint32_t i = 0; i < resources_.size(); i++)
+    {
+        if (resources_[i].refCount == 0)
+        {
+            unused.push_back(i);
+        }
+    }
+
+    auto cullPass = [this, &unused](PassNode& pass) {
+        for (const PassAccess& use : pass.accesses)
+        {
+            if (!use.write && (--resources_[use.resource].refCount == 0))
+            {
+                unused.push_back(use.resource);
+            }
+        }
+    };
+
+    // Passes already culled above, and those writing nothing, release their reads first.
+    for (PassNode& pass : passes_)
+    {
+        if (pass.culled || ((pass.refCount == 0) && !pass.sideEffect))
+        {
+            pass.culled = true;
+            cullPass(pass);
+        }
+    }
+
+    while (!unused.empty())
+    {
+        uint32_t resource = unused.back();
+        unused.pop_back();
+
+        for (PassNode& pass : passes_)
+        {
+            if (pass.culled) { continue; }
+
+            bool writes = std::any_of(pass.accesses.begin(), pass.accesses.end(),
+                [resource](const PassAccess& use) { return use.write && (use.resource == resource); });
+            if (!writes) { continue; }
+
+            if ((--pass.refCount == 0) && !pass.sideEffect)
+            {
+                pass.culled = true;
+                cullPass(pass);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < passes_.size(); i++)
+    {
+        if (!passes_[i].culled)
+        {
+            executionOrder_.push_back(i);
+        }
+    }
+}
+
+void RenderGraph::ComputeLifetimes()
+{
+    for (uint32_t order = 0; order < executionOrder_.size(); order++)
+    {
+        const PassNode& pass = passes_[executionOrder_[order]];
+        for (const PassAccess& use : pass.accesses)
+        {
+            ResourceNode& resource = resources_[use.resource];
+            resource.firstPass = std::min(resource.firstPass, order);
+            resource.lastPass = std::max(resource.lastPass, order);
+            resource.usage |= GetAccessInfo(use.access, pass.type).usage;
+
+            if (!resource.imported && !use.write && (resource.firstPass == order))
+            {
+                LOG_WARN("Render Graph: {} is read by {} before anything writes it", resource.name, pass.name);
+            }
+        }
+    }
+}
+
+void RenderGraph::Compile()
+{
+    PROFILE_SCOPE("RenderGraph::Compile");
+
+    CullPasses();
+    ComputeLifetimes();
+
+    // The Renderer drains the GPU when the frames in flight change, dropped slots are idle.
+    size_t frameCount = renderer_->GetFramesInFlight();
+    if (frames_.size() != frameCount)
+    {
+        for (size_t i = frameCount; i < frames_.size(); i++)
+        {
+            DestroyResources(frames_[i]);
+        }
+        frames_.resize(frameCount);
+    }
+
+    FrameResources& frame = frames_[renderer_->GetCurrentFrameIndex()];
+    RealizeResources(frame);
+    currentFrame_ = &frame;
+}
+
+//----------------------------------------------------------------------------//
+
+void RenderGraph::RealizeResources(FrameResources& frame)
+{
+    // Images that are used at all, in a stable order.
+    std::vector<uint32_t> transient;
+    std::vector<ImageKey> keys;
+    for (uint32_t i = 0; i < resources_.size(); i++)
+    {
+        const ResourceNode& resource = resources_[i];
+        if (resource.imported || (resource.firstPass == UINT32_MAX)) { continue; }
+
+        ImageKey key;
+        key.format = resource.desc.format;
+        key.extent = ResolveExtent(resource.desc);
+        key.usage = resource.usage;
+        key.firstPass = resource.firstPass;
+        key.lastPass = resource.lastPass;
+
+        resources_[i].physicalIdx = static_cast<uint32_t>(transient.size());
+        transient.push_back(i);
+        keys.push_back(key);
+    }
+
+    if (keys == frame.keys)
+    {
+        return;
+    }
+
+    // The slot's previous frame has completed (Renderer::BeginFrame waited for it).
+    DestroyResources(frame);
+    frame.keys = keys;
+    frame.images.resize(keys.size());
+
+    VkDevice device = deviceInst_->GetLogicalDevice();
+    std::vector<VkMemoryRequirements> requirements(keys.size());
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        VkImageCreateInfo imageInfo = {};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = keys[i].extent.width;
+        imageInfo.extent.height = keys[i].extent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = keys[i].format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = keys[i].usage;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VK_CHECK(
+            vkCreateImage(device, &imageInfo, deviceInst_->GetAllocator(), &frame.images[i].image),
+            "Render Graph: Failed to create transient image !!"
+        )
+        vkGetImageMemoryRequirements(device, frame.images[i].image, &requirements[i]);
+        frame.unaliasedSize += requirements[i].size;
+
+        frame.images[i].aspect = (keys[i].usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) ?
+            GetDepthAspectMask(keys[i].format) : VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+
+    // Largest first, each image goes to the first block whose images are all dead by
+    // the time it is first used (or not yet alive after its last use).
+    std::vector<uint32_t> bySize(keys.size());
+    std::iota(bySize.begin(), bySize.end(), 0);
+    std::stable_sort(bySize.begin(), bySize.end(), [&requirements](uint32_t a, uint32_t b) {
+        return requirements[a].size > requirements[b].size; });
+
+    std::vector<std::vector<uint32_t>> blockImages;
+    for (uint32_t image : bySize)
+    {
+        const VkMemoryRequirements& req = requirements[image];
+        uint32_t chosen = UINT32_MAX;
+
+        for (uint32_t block = 0; block < frame.blocks.size(); block++)
+        {
+            if ((frame.blocks[block].typeBits & req.memoryTypeBits) == 0) { continue; }
+
+            bool overlaps = std::any_of(blockImages[block].begin(), blockImages[block].end(),
+                [&keys, image](uint32_t other) {
+                    return (keys[image].firstPass <= keys[other].lastPass) &&
+                           (keys[other].firstPass <= keys[image].lastPass); });
+            if (!overlaps)
+            {
+                chosen = block;
+                break;
+            }
+        }
+
+        if (chosen == UINT32_MAX)
+        {
+            chosen = static_cast<uint32_t>(frame.blocks.size());
+            frame.blocks.push_back({VK_NULL_HANDLE, 0, req.memoryTypeBits});
+            blockImages.emplace_back();
+        }
+
+        // Bound at offset 0, so the block only has to satisfy the size.
+        MemoryBlock& block = frame.blocks[chosen];
+        block.size = std::max(block.size, req.size);
+        block.typeBits &= req.memoryTypeBits;
+        blockImages[chosen].push_back(image);
+        frame.images[image].block = chosen;
+    }
+
+    for (MemoryBlock& block : frame.blocks)
+    {
+        VkMemoryAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = block.size;
+        allocInfo.memoryTypeIndex = deviceInst_->FindMemoryType(block.typeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        VK_CHECK(
+            deviceInst_->AllocateMemory(allocInfo, MemoryCategory::Transient, block.memory),
+            "Render Graph: Failed to allocate transient memory !!"
+        )
+        frame.aliasedSize += block.size;
+    }
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        PhysicalImage& physical = frame.images[i];
+        VK_CHECK(
+            vkBindImageMemory(device, physical.image, frame.blocks[physical.block].memory, 0),
+            "Render Graph: Failed to bind transient image memory !!"
+        )
+
+        VkImageViewCreateInfo viewInfo = {};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = physical.image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = keys[i].format;
+        viewInfo.subresourceRange.aspectMask = physical.aspect;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        VK_CHECK(
+            vkCreateImageView(device, &viewInfo, deviceInst_->GetAllocator(), &physical.view),
+            "Render Graph: Failed to create transient image view !!"
+        )
+    }
+
+    LOG_INFO("Render Graph: {} transient images in {} blocks, {} KB ({} KB without aliasing)",
+             keys.size(), frame.blocks.size(), frame.aliasedSize / 1024, frame.unaliasedSize / 1024);
+}
+
+void RenderGraph::DestroyResources(FrameResources& frame)
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    for (PhysicalImage& physical : frame.images)
+    {
+        vkDestroyImageView(device, physical.view, deviceInst_->GetAllocator());
+        vkDestroyImage(device, physical.image, deviceInst_->GetAllocator());
+    }
+    for (MemoryBlock& block : frame.blocks)
+    {
+        deviceInst_->FreeMemory(block.memory);
+    }
+
+    frame.keys.clear();
+    frame.images.clear();
+    frame.blocks.clear();
+    frame.aliasedSize = 0;
+    frame.unaliasedSize = 0;
+}
+
+//----------------------------------------------------------------------------//
+
+void RenderGraph::Execute(VkCommandBuffer commandBuffer)
+{
+    PROFILE_SCOPE("RenderGraph::Execute");
+    Compile();
+
+    resourceState_.assign(resources_.size(), SyncState{});
+    blockState_.assign(currentFrame_->blocks.size(), SyncState{});
+
+    for (uint32_t order = 0; order < executionOrder_.size(); order++)
+    {
+        const PassNode& pass = passes_[executionOrder_[order]];
+
+        RecordBarriers(commandBuffer, pass);
+
+        if (pass.swapchainPass)
+        {
+            // Profiled as the main pass by the Renderer.
+            renderer_->BeginSwapChainRenderPass(commandBuffer);
+            pass.execute(commandBuffer, *this);
+            renderer_->EndSwapChainRenderPass(commandBuffer);
+            continue;
+        }
+
+        GpuProfileScope profileScope(renderer_->GetGpuProfiler(), commandBuffer, pass.name);
+        if (pass.type == RGPassType::Raster)
+        {
+            BeginRendering(commandBuffer, pass, order);
+            pass.execute(commandBuffer, *this);
+            vkCmdEndRendering(commandBuffer);
+        }
+        else
+        {
+            pass.execute(commandBuffer, *this);
+        }
+    }
+}
+
+void RenderGraph::RecordBarriers(VkCommandBuffer commandBuffer, const PassNode& pass)
+{
+    std::vector<VkImageMemoryBarrier2> barriers;
+
+    for (const PassAccess& use : pass.accesses)
+    {
+        const ResourceNode& resource = resources_[use.resource];
+        if (resource.imported) { continue; } // Synchronized by the Renderer
+
+        const PhysicalImage& physical = currentFrame_->images[resource.physicalIdx];
+        AccessInfo info = GetAccessInfo(use.access, pass.type);
+        SyncState& state = resourceState_[use.resource];
+        SyncState& block = blockState_[physical.block];
+
+        VkImageMemoryBarrier2 barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = physical.image;
+        barrier.subresourceRange = {physical.aspect, 0, 1, 0, 1};
+        barrier.dstStageMask = info.stage;
+        barrier.dstAccessMask = info.access;
+        barrier.newLayout = info.layout;
+
+        if (state.layout == VK_IMAGE_LAYOUT_UNDEFINED)
+        {
+            // First use, the memory may still hold an aliased image. Its contents are
+            // discarded but its last accesses have to finish first.
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.srcStageMask = block.writeStage | block.readStage;
+            barrier.srcAccessMask = block.writeAccess;
+        }
+        else if (!use.write && (state.layout == info.layout) &&
+                 ((state.readStage & info.stage) == info.stage) &&
+                 ((state.readAccess & info.access) == info.access))
+        {
+            // Already visible to this kind of read.
+            continue;
+        }
+        else
+        {
+            barrier.oldLayout = state.layout;
+            barrier.srcStageMask = state.writeStage;
+            barrier.srcAccessMask = state.writeAccess;
+
+            // Write after read, and layout transitions, also wait for the readers.
+            if (use.write || (state.layout != info.layout))
+            {
+                barrier.srcStageMask |= state.readStage;
+            }
+        }
+
+        if (use.write)
+        {
+            state.writeStage = info.stage;
+            state.writeAccess = info.access;
+            state.readStage = VK_PIPELINE_STAGE_2_NONE;
+            state.readAccess = VK_ACCESS_2_NONE;
+        }
+        else if (state.layout != info.layout)
+        {
+            // The transition counts as a write done before this stage, later readers
+            // chain on it.
+            state.writeStage = info.stage;
+            state.writeAccess = VK_ACCESS_2_NONE;
+            state.readStage = info.stage;
+            state.readAccess = info.access;
+        }
+        else
+        {
+            state.readStage |= info.stage;
+            state.readAccess |= info.access;
+        }
+        state.layout = info.layout;
+        block = state;
+
+        barriers.push_back(barrier);
+    }
+
+    FlushBarriers(commandBuffer, barriers);
+}
+
+void RenderGraph::FlushBarriers(VkCommandBuffer commandBuffer, const std::vector<VkImageMemoryBarrier2>& barriers)
+{
+    if (barriers.empty()) { return; }
+
+    if (deviceInst_->IsSynchronization2Enabled())
+    {
+        VkDependencyInfo dependencyInfo = {};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+        dependencyInfo.pImageMemoryBarriers = barriers.data();
+
+        vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+        return;
+    }
+
+    // Legacy barrier, the stages and accesses in use share their values with the old enums.
+    VkPipelineStageFlags srcStage = 0;
+    VkPipelineStageFlags dstStage = 0;
+    std::vector<VkImageMemoryBarrier> legacyBarriers(barriers.size());
+
+    for (size_t i = 0; i < barriers.size(); i++)
+    {
+        const VkImageMemoryBarrier2& barrier = barriers[i];
+        srcStage |= static_cast<VkPipelineStageFlags>(barrier.srcStageMask);
+        dstStage |= static_cast<VkPipelineStageFlags>(barrier.dstStageMask);
+
+        VkImageMemoryBarrier& legacy = legacyBarriers[i];
+        legacy.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        legacy.srcAccessMask = static_cast<VkAccessFlags>(barrier.srcAccessMask);
+        legacy.dstAccessMask = static_cast<VkAccessFlags>(barrier.dstAccessMask);
+        legacy.oldLayout = barrier.oldLayout;
+        legacy.newLayout = barrier.newLayout;
+        legacy.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        legacy.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        legacy.image = barrier.image;
+        legacy.subresourceRange = barrier.subresourceRange;
+    }
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        (srcStage != 0) ? srcStage : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        dstStage,
+        0,
+        0, nullptr,
+        0, nullptr,
+        static_cast<uint32_t>(legacyBarriers.size()), legacyBarriers.data());
+}
+
+void RenderGraph::BeginRendering(VkCommandBuffer commandBuffer, const PassNode& pass, uint32_t passIdx)
+{
+    std::vector<VkRenderingAttachmentInfo> colorAttachments;
+    VkRenderingAttachmentInfo depthAttachment = {};
+    bool hasDepth = false;
+    VkExtent2D extent = {0, 0};
+
+    for (const PassAccess& use : pass.accesses)
+    {
+        if ((use.access != RGAccess::ColorAttachment) && (use.access != RGAccess::DepthAttachment)) { continue; }
+
+        const ResourceNode& resource = resources_[use.resource];
+        VkRenderingAttachmentInfo attachment = {};
+        attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        attachment.imageView = currentFrame_->images[resource.physicalIdx].view;
+        attachment.imageLayout = GetAccessInfo(use.access, pass.type).layout;
+
+        // Cleared on its first use, dropped after its last one.
+        attachment.loadOp = (resource.firstPass == passIdx) ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+        attachment.storeOp = (resource.lastPass == passIdx) ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+        attachment.clearValue = resource.desc.clearValue;
+        extent = ResolveExtent(resource.desc);
+
+        if (use.access == RGAccess::DepthAttachment)
+        {
+            depthAttachment = attachment;
+            hasDepth = true;
+        }
+        else
+        {
+            colorAttachments.push_back(attachment);
+        }
+    }
+
+    VkRenderingInfo renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+    renderingInfo.renderArea.offset = {0, 0};
+    renderingInfo.renderArea.extent = extent;
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = static_cast<uint32_t>(colorAttachments.size());
+    renderingInfo.pColorAttachments = colorAttachments.data();
+    renderingInfo.pDepthAttachment = hasDepth ? &depthAttachment : nullptr;
+
+    vkCmdBeginRendering(commandBuffer, &renderingInfo);
+
+    VkViewport viewPort{};
+    viewPort.x = 0.0f;
+    viewPort.y = 0.0f;
+    viewPort.width = static_cast<float>(extent.width);
+    viewPort.height = static_cast<float>(extent.height);
+    viewPort.minDepth = 0.0f;
+    viewPort.maxDepth = 1.0f;
+    VkRect2D scissor{{0, 0}, extent};
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewPort);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+}
+
+} // namespace Graphic
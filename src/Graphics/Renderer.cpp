@@ -2,8 +2,10 @@
 #include <Graphics/Vulkan/VkInstanceImpl.ipp>
 #include <Graphics/Vulkan/VkUtil.ipp>
 #include <Graphics/WindowHandler.ipp>
+#include <Core/Profiler.ipp>
 
 // STD Lib
+#include <algorithm>
 #include <array>
 
 namespace Graphic
@@ -11,15 +13,28 @@ namespace Graphic
 
 Renderer::Renderer(
     WindowHandler* window,
-    VkDeviceInstance* deviceInst)
-    : window_(window), deviceInst_(deviceInst)
+    VkDeviceInstance* deviceInst,
+    VkExtent2D headlessExtent)
+    : window_(window), deviceInst_(deviceInst), headlessExtent_(headlessExtent),
+      presentTracker_(deviceInst), gpuProfiler_(deviceInst),
+      globalUniforms_(deviceInst, DEFAULT_FRAMES_IN_FLIGHT)
 {
+#if ENABLE_PRESENT_TIMING
+    swapChainConfig_.presentTracker = &presentTracker_;
+#endif
     RecreateSwapChain();
     CreateCommandBuffer();
 }
 
 Renderer::~Renderer()
 {
+    // Caller is expected to have waited for the device to go idle.
+    frameCapture_.reset();
+    for (std::function<void()>& deleter : frameDeletions_)
+    {
+        deleter();
+    }
+    deletionQueue_.FlushAll();
     FreeCommandBuffers();
     window_ = nullptr;
     deviceInst_ = nullptr;
@@ -27,24 +42,61 @@ Renderer::~Renderer()
 
 void Renderer::RecreateSwapChain()
 {
-    auto extent = window_->GetWindowExtent();
-    while ((extent.width == 0) || (extent.height == 0))
+    VkExtent2D extent = headlessExtent_;
+    if (window_ != nullptr)
     {
         extent = window_->GetWindowExtent();
-        glfwWaitEvents();
+        while ((extent.width == 0) || (extent.height == 0))
+        {
+            extent = window_->GetWindowExtent();
+            glfwWaitEvents();
+        }
+    }
+
+    // No device idle here, the new swapchain is created with the old one as
+    // oldSwapchain and takes over its render pass and sync objects.
+    std::unique_ptr<SwapChainInstance> oldSwapChain = std::move(swapChainInst_);
+    swapChainInst_ = std::make_unique<SwapChainInstance>(
+        deviceInst_, extent, swapChainConfig_, oldSwapChain.get());
+    swapChainDirty_ = false;
+
+    if (oldSwapChain != nullptr)
+    {
+        // Old images, views, depth buffers and framebuffers can still be referenced
+        // by frames in flight, release them once the last submitted frame completes.
+        std::shared_ptr<SwapChainInstance> retired = std::move(oldSwapChain);
+        deletionQueue_.Push(
+            swapChainInst_->GetLastSubmittedValue(),
+            [retired]() mutable { retired.reset(); });
     }
-    vkDeviceWaitIdle(deviceInst_->GetLogicalDevice());
+}
+
+void Renderer::ResizeFrameResources()
+{
+    PROFILE_SCOPE("Renderer::ResizeFrameResources");
+
+    // Frame slots get remapped, nothing may still use them.
+    swapChainInst_->WaitForFrame(swapChainInst_->GetLastSubmittedValue());
+    if (frameCapture_ != nullptr)
+    {
+        for (uint32_t slot = 0; slot < swapChainInst_->GetFramesInFlight(); slot++)
+        {
+            frameCapture_->CollectSlot(slot);
+        }
+    }
+
+    RecreateSwapChain();
+
+    FreeCommandBuffers();
+    CreateCommandBuffer();
+    globalUniforms_.SetFrameCount(swapChainInst_->GetFramesInFlight());
 
-    // Object was not destroyed quickly enough to release 
-    // the surface from GLFW. Caused - VK_ERROR_NATIVE_WINDOW_IN_USE_KHR
-    // @todo Need to implement Old swapchain handling.
-    swapChainInst_.reset();
-    swapChainInst_ = std::make_unique<SwapChainInstance>(deviceInst_, extent);
+    LOG_INFO("Render: Frames in flight -> {}", swapChainInst_->GetFramesInFlight());
 }
 
 void Renderer::CreateCommandBuffer()
 {
-    commandBuffers_.resize(swapChainInst_->GetImageCount());
+    commandBuffers_.resize(swapChainInst_->GetFramesInFlight());
 
     VkCommandBufferAllocateInfo allocInfo = {};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -58,10 +110,148 @@ void Renderer::CreateCommandBuffer()
     )
 }
 
+void Renderer::SetPresentMode(PresentMode mode)
+{
+    if (mode == swapChainConfig_.presentMode) { return; }
+
+    swapChainConfig_.presentMode = mode;
+    swapChainDirty_ = true;
+}
+
+void Renderer::SetFramesInFlight(uint32_t count)
+{
+    count = std::clamp<uint32_t>(count, 1, MAX_FRAMES_IN_FLIGHT);
+    if (count == swapChainConfig_.framesInFlight) { return; }
+
+    swapChainConfig_.framesInFlight = count;
+    swapChainDirty_ = true;
+}
+
+void Renderer::SetSwapChainImageCount(uint32_t count)
+{
+    if (count == swapChainConfig_.imageCount) { return; }
+
+    swapChainConfig_.imageCount = count;
+    swapChainDirty_ = true;
+}
+
+void Renderer::DeferDeletion(std::function<void()> deleter)
+{
+    if (isFrameStarted_)
+    {
+        frameDeletions_.push_back(std::move(deleter));
+        return;
+    }
+
+    deletionQueue_.Push(swapChainInst_->GetLastSubmittedValue(), std::move(deleter));
+}
+
+void Renderer::SetFrameLatencyLimit(uint32_t maxQueuedFrames)
+{
+    frameLatencyLimit_ = maxQueuedFrames;
+    LOG_INFO("Render: Frame latency limit -> {}", maxQueuedFrames);
+}
+
+bool Renderer::StartCapture(const FrameCaptureConfig& config)
+{
+    assert(!isFrameStarted_ && "Can't start a capture while a frame is in progress");
+
+    if (!swapChainInst_->SupportsReadback())
+    {
+        LOG_ERROR("Render: Swapchain images can't be read back, capture unavailable");
+        return false;
+    }
+
+    StopCapture();
+    frameCapture_ = std::make_unique<FrameCapture>(deviceInst_, config);
+    return true;
+}
+
+void Renderer::StopCapture()
+{
+    assert(!isFrameStarted_ && "Can't stop a capture while a frame is in progress");
+
+    if (frameCapture_ == nullptr) { return; }
+
+    // Every pending readback must have landed before the buffers are collected.
+    swapChainInst_->WaitForFrame(swapChainInst_->GetLastSubmittedValue());
+    frameCapture_.reset();
+}
+
+void Renderer::UpdateGlobalUniforms(const Camera& camera, float time, float deltaTime)
+{
+    assert(isFrameStarted_ && "Global uniforms are written once the frame slot is free");
+
+    VkExtent2D extent = swapChainInst_->GetSwapChainExtent();
+    GlobalUbo ubo = {};
+    ubo.viewProj = camera.GetViewProjection();
+    ubo.viewport = glm::vec4(
+        static_cast<float>(extent.width), static_cast<float>(extent.height),
+        1.0f / static_cast<float>(extent.width), 1.0f / static_cast<float>(extent.height));
+    ubo.time = glm::vec4(time, deltaTime, 0.0f, 0.0f);
+
+    globalUniforms_.Update(swapChainInst_->GetCurrentFrameIndex(), ubo);
+}
+
+VkCommandBuffer Renderer::BeginCompute()
+{
+    assert(!isFrameStarted_ && "Compute for the next frame is recorded before BeginFrame");
+
+    // Still the slot of the next frame, it only advances on submit.
+    return deviceInst_->GetAsyncCompute()->Begin(swapChainInst_->GetCurrentFrameIndex());
+}
+
+uint64_t Renderer::SubmitCompute(VkPipelineStageFlags2 graphicsWaitStage)
+{
+    PROFILE_SCOPE("Renderer::SubmitCompute");
+    AsyncCompute* compute = deviceInst_->GetAsyncCompute();
+
+    // The slot's resources may still be read by the last frame submitted from it.
+    uint64_t slotFrame = swapChainInst_->GetFrameSlotValue(swapChainInst_->GetCurrentFrameIndex());
+    uint64_t value = compute->Submit(slotFrame);
+
+    SemaphoreSubmit wait = {};
+    if (compute->TakeGraphicsWait(graphicsWaitStage, wait))
+    {
+        computeWaits_.push_back(wait);
+    }
+
+    return value;
+}
+
+void Renderer::ThrottleFrameLatency()
+{
+    // The frame slots already cap the queue at the frames in flight.
+    if ((frameLatencyLimit_ == 0) || (frameLatencyLimit_ >= swapChainInst_->GetFramesInFlight())) { return; }
+
+    PROFILE_SCOPE("Renderer::ThrottleFrameLatency");
+
+    // Allow at most 'limit' frames to be queued once the next one is submitted : frame
+    // N waits for frame N - limit. Timeline values also advance on uploads and compute
+    // submits, so the frame is looked up by slot rather than derived from the counter.
+    uint64_t frameValue = swapChainInst_->GetRecentFrameValue(frameLatencyLimit_);
+    if (frameValue != 0)
+    {
+        swapChainInst_->WaitForFrame(frameValue);
+    }
+}
+
 VkCommandBuffer Renderer::BeginFrame()
 {
+    PROFILE_SCOPE("Renderer::BeginFrame");
     assert(!isFrameStarted_ && "Can't call Begin Frame while in already in progress");
 
+    if (swapChainDirty_ && (swapChainConfig_.framesInFlight != swapChainInst_->GetFramesInFlight()))
+    {
+        ResizeFrameResources();
+    }
+    else if (swapChainDirty_)
+    {
+        RecreateSwapChain();
+    }
+
+    ThrottleFrameLatency();
+
     VkResult result = swapChainInst_->AcquireNextImage(&currImgIdx_);
 
     if (result == VK_ERROR_OUT_OF_DATE_KHR)
@@ -75,6 +265,17 @@ VkCommandBuffer Renderer::BeginFrame()
         LOG_ERROR("Render: Failed to acquire next SwapChain image");
     }
 
+    deletionQueue_.Flush(swapChainInst_->GetCompletedFrameCount());
+
+    // The slot's fence was waited on by AcquireNextImage, its readback is done.
+    if (frameCapture_ != nullptr)
+    {
+        frameCapture_->CollectSlot(static_cast<uint32_t>(swapChainInst_->GetCurrentFrameIndex()));
+    }
+
+    // Heap budgets after the slot's deletions, periodic memory log.
+    deviceInst_->GetMemoryStats()->Tick();
+
     // Set this to true to record new commands.
     isFrameStarted_ = true;
 
@@ -87,27 +288,59 @@ VkCommandBuffer Renderer::BeginFrame()
         "CommandBuffer: Failed to start recording command !!"
     )
 
+    gpuProfiler_.BeginFrame(commandBuffer, swapChainInst_->GetCurrentFrameIndex());
+
+    // Take ownership of finished uploads before anything in this frame reads them.
+    frameWaits_.clear();
+    deviceInst_->GetTransferQueue()->RecordAcquires(commandBuffer, frameWaits_);
+    frameWaits_.insert(frameWaits_.end(), computeWaits_.begin(), computeWaits_.end());
+    computeWaits_.clear();
+
     return commandBuffer;
 }
 
 void Renderer::EndFrame()
 {
+    PROFILE_SCOPE("Renderer::EndFrame");
     assert(isFrameStarted_ && "Can't call EndFrame while frame is not in progress");
 
     auto commandBuffer = GetCurrentCommandBuffer();
 
+    if (frameCapture_ != nullptr)
+    {
+        frameCapture_->RecordCopy(
+            commandBuffer,
+            static_cast<uint32_t>(swapChainInst_->GetCurrentFrameIndex()),
+            swapChainInst_->GetImage(currImgIdx_),
+            swapChainInst_->GetSwapChainImageFormat(),
+            swapChainInst_->GetSwapChainExtent(),
+            swapChainInst_->GetFinalColorLayout());
+    }
+
+    gpuProfiler_.EndFrame(commandBuffer);
+
     VK_CHECK(
         vkEndCommandBuffer(commandBuffer),
         "CommandBuffer: Failed to record command in buffers !!"
     )
 
-    VkResult result = swapChainInst_->SubmitCommandBuffers(&commandBuffer, &currImgIdx_);
+    VkResult result = swapChainInst_->SubmitCommandBuffers(&commandBuffer, &currImgIdx_, frameWaits_);
+
+    for (std::function<void()>& deleter : frameDeletions_)
+    {
+        deletionQueue_.Push(swapChainInst_->GetLastSubmittedValue(), std::move(deleter));
+    }
+    frameDeletions_.clear();
 
     // @todo Enhance the swapchain recreation with old swapchain mechanics
+    bool windowResized = (window_ != nullptr) && window_->WasWindowResized();
     if ((result == VK_ERROR_OUT_OF_DATE_KHR) || 
-       (result == VK_SUBOPTIMAL_KHR) || window_->WasWindowResized())
+       (result == VK_SUBOPTIMAL_KHR) || windowResized)
     {
-        window_->ResetFrameBufferResized();
+        if (window_ != nullptr)
+        {
+            window_->ResetFrameBufferResized();
+        }
         RecreateSwapChain();
     }
     if (result != VK_SUCCESS)
@@ -126,23 +359,35 @@ void Renderer::BeginSwapChainRenderPass(VkCommandBuffer commandBuffer)
         commandBuffer == GetCurrentCommandBuffer() &&
         "Can't begin RenderPass due to missmatch on current CommandBuffer");
 
-    VkRenderPassBeginInfo renderPassInfo = {};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass = swapChainInst_->GetRenderPass();
-    renderPassInfo.framebuffer = swapChainInst_->GetFrameBuffer(currImgIdx_);
-
-    renderPassInfo.renderArea.offset = {0,0};
-    renderPassInfo.renderArea.extent = swapChainInst_->GetSwapChainExtent();
-
-    // Both color attachment and depth attachemnt indexs are binded
-    // at the Swapchain Instantiation during the CreateRenderPass()
     std::array<VkClearValue, 2> clearValues{};
     clearValues[0].color = {0.01f, 0.01f, 0.01f, 1.0f};
     clearValues[1].depthStencil = {1.0f, 0};
-    renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-    renderPassInfo.pClearValues = clearValues.data();
 
-    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    // Timestamps only, draw scopes inside the pass collect the pipeline statistics.
+    mainPassScope_ = gpuProfiler_.BeginScope(commandBuffer, "MainPass", false);
+
+    if (swapChainInst_->UsesDynamicRendering())
+    {
+        BeginDynamicRendering(commandBuffer, clearValues[0], clearValues[1]);
+    }
+    else
+    {
+        VkRenderPassBeginInfo renderPassInfo = {};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = swapChainInst_->GetRenderPass();
+        renderPassInfo.framebuffer =
+            swapChainInst_->GetFrameBuffer(swapChainInst_->GetCurrentFrameIndex(), currImgIdx_);
+
+        renderPassInfo.renderArea.offset = {0,0};
+        renderPassInfo.renderArea.extent = swapChainInst_->GetSwapChainExtent();
+
+        // Both color attachment and depth attachemnt indexs are binded
+        // at the Swapchain Instantiation during the CreateRenderPass()
+        renderPassInfo.clearValueCount = swapChainInst_->HasDepth() ? 2u : 1u;
+        renderPassInfo.pClearValues = clearValues.data();
+
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    }
 
     VkViewport viewPort{};
     viewPort.x = 0.0f;
@@ -163,7 +408,88 @@ void Renderer::EndSwapChainRenderPass(VkCommandBuffer commandBuffer)
         commandBuffer == GetCurrentCommandBuffer() &&
         "Can't end RenderPass due to missmatch on current CommandBuffer");
 
-    vkCmdEndRenderPass(commandBuffer);
+    if (swapChainInst_->UsesDynamicRendering())
+    {
+        EndDynamicRendering(commandBuffer);
+    }
+    else
+    {
+        vkCmdEndRenderPass(commandBuffer);
+    }
+
+    gpuProfiler_.EndScope(commandBuffer, mainPassScope_);
+    mainPassScope_ = UINT32_MAX;
+}
+
+void Renderer::BeginDynamicRendering(
+    VkCommandBuffer commandBuffer,
+    const VkClearValue& colorClear,
+    const VkClearValue& depthClear)
+{
+    size_t frameSlot = swapChainInst_->GetCurrentFrameIndex();
+    VkImage colorImage = swapChainInst_->GetImage(currImgIdx_);
+
+    // Contents are cleared anyway, start from UNDEFINED. The source stage matches the
+    // image acquire semaphore wait stage so the transition happens after the acquire.
+    ImageBarrier2(
+        commandBuffer, colorImage, VK_IMAGE_ASPECT_COLOR_BIT,
+        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE,
+        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+
+    VkRenderingAttachmentInfo colorAttachment = {};
+    colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+    colorAttachment.imageView = swapChainInst_->GetImageView(currImgIdx_);
+    colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.clearValue = colorClear;
+
+    VkRenderingAttachmentInfo depthAttachment = {};
+    if (swapChainInst_->HasDepth())
+    {
+        // The previous frame using this slot's depth image may still be testing against it.
+        ImageBarrier2(
+            commandBuffer, swapChainInst_->GetDepthImage(frameSlot),
+            GetDepthAspectMask(swapChainInst_->GetSwapChainDepthFormat()),
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+
+        depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        depthAttachment.imageView = swapChainInst_->GetDepthImageView(frameSlot);
+        depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.clearValue = depthClear;
+    }
+
+    VkRenderingInfo renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+    renderingInfo.renderArea.offset = {0, 0};
+    renderingInfo.renderArea.extent = swapChainInst_->GetSwapChainExtent();
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachments = &colorAttachment;
+    renderingInfo.pDepthAttachment = swapChainInst_->HasDepth() ? &depthAttachment : nullptr;
+
+    vkCmdBeginRendering(commandBuffer, &renderingInfo);
+}
+
+void Renderer::EndDynamicRendering(VkCommandBuffer commandBuffer)
+{
+    vkCmdEndRendering(commandBuffer);
+
+    // Same final layout the legacy render pass leaves the image in. The destination stage
+    // stays COLOR_ATTACHMENT_OUTPUT so the frame capture barrier chains after the transition,
+    // presentation is ordered by the render complete semaphore.
+    ImageBarrier2(
+        commandBuffer, swapChainInst_->GetImage(currImgIdx_), VK_IMAGE_ASPECT_COLOR_BIT,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, swapChainInst_->GetFinalColorLayout(),
+        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE);
 }
 
 void Renderer::FreeCommandBuffers()
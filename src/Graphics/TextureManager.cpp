@@ -0,0 +1,1018 @@
+#include <Graphics/TextureManager.ipp>
+#include <Graphics/Renderer.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkTransferQueueImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Core/BlockDecoder.ipp>
+#include <Core/ImageReader.ipp>
+#include <Core/Ktx2Reader.ipp>
+#include <Core/MappedFile.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <optional>
+
+namespace Graphic
+{
+
+namespace
+{
+
+// Decoded images are color data, sampled with sRGB decoding.
+constexpr VkFormat TEXTURE_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+
+enum class FormatFamily
+{
+    Uncompressed = 0,
+    BC = 1,
+    ETC2 = 2,
+    ASTC = 3
+};
+
+struct FormatInfo
+{
+    VkFormat format;
+    FormatFamily family;
+    uint32_t blockWidth;
+    uint32_t blockHeight;
+    uint32_t blockBytes;
+    bool srgb;
+    std::optional<Core::BlockFormat> cpuFormat; // Set when level 0 can be decoded on the CPU
+};
+
+// Formats accepted from KTX2 files.
+constexpr FormatInfo FORMAT_INFOS[] = {
+    {VK_FORMAT_R8G8B8A8_UNORM,            FormatFamily::Uncompressed, 1, 1, 4,  false, std::nullopt},
+    {VK_FORMAT_R8G8B8A8_SRGB,             FormatFamily::Uncompressed, 1, 1, 4,  true,  std::nullopt},
+    {VK_FORMAT_BC1_RGB_UNORM_BLOCK,       FormatFamily::BC,           4, 4, 8,  false, Core::BlockFormat::BC1},
+    {VK_FORMAT_BC1_RGB_SRGB_BLOCK,        FormatFamily::BC,           4, 4, 8,  true,  Core::BlockFormat::BC1},
+    {VK_FORMAT_BC1_RGBA_UNORM_BLOCK,      FormatFamily::BC,           4, 4, 8,  false, Core::BlockFormat::BC1},
+    {VK_FORMAT_BC1_RGBA_SRGB_BLOCK,       FormatFamily::BC,           4, 4, 8,  true,  Core::BlockFormat::BC1},
+    {VK_FORMAT_BC2_UNORM_BLOCK,           FormatFamily::BC,           4, 4, 16, false, Core::BlockFormat::BC2},
+    {VK_FORMAT_BC2_SRGB_BLOCK,            FormatFamily::BC,           4, 4, 16, true,  Core::BlockFormat::BC2},
+    {VK_FORMAT_BC3_UNORM_BLOCK,           FormatFamily::BC,           4, 4, 16, false, Core::BlockFormat::BC3},
+    {VK_FORMAT_BC3_SRGB_BLOCK,            FormatFamily::BC,           4, 4, 16, true,  Core::BlockFormat::BC3},
+    {VK_FORMAT_BC4_UNORM_BLOCK,           FormatFamily::BC,           4, 4, 8,  false, Core::BlockFormat::BC4},
+    {VK_FORMAT_BC5_UNORM_BLOCK,           FormatFamily::BC,           4, 4, 16, false, Core::BlockFormat::BC5},
+    {VK_FORMAT_BC7_UNORM_BLOCK,           FormatFamily::BC,           4, 4, 16, false, std::nullopt},
+    {VK_FORMAT_BC7_SRGB_BLOCK,            FormatFamily::BC,           4, 4, 16, true,  std::nullopt},
+    {VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK,   FormatFamily::ETC2,         4, 4, 8,  false, std::nullopt},
+    {VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK,    FormatFamily::ETC2,         4, 4, 8,  true,  std::nullopt},
+    {VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK, FormatFamily::ETC2,         4, 4, 16, false, std::nullopt},
+    {VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK,  FormatFamily::ETC2,         4, 4, 16, true,  std::nullopt},
+    {VK_FORMAT_ASTC_4x4_UNORM_BLOCK,      FormatFamily::ASTC,         4, 4, 16, false, std::nullopt},
+    {VK_FORMAT_ASTC_4x4_SRGB_BLOCK,       FormatFamily::ASTC,         4, 4, 16, true,  std::nullopt},
+    {VK_FORMAT_ASTC_6x6_UNORM_BLOCK,      FormatFamily::ASTC,         6, 6, 16, false, std::nullopt},
+    {VK_FORMAT_ASTC_6x6_SRGB_BLOCK,       FormatFamily::ASTC,         6, 6, 16, true,  std::nullopt},
+    {VK_FORMAT_ASTC_8x8_UNORM_BLOCK,      FormatFamily::ASTC,         8, 8, 16, false, std::nullopt},
+    {VK_FORMAT_ASTC_8x8_SRGB_BLOCK,       FormatFamily::ASTC,         8, 8, 16, true,  std::nullopt},
+};
+
+const FormatInfo* FindFormatInfo(VkFormat format)
+{
+    for (const FormatInfo& info : FORMAT_INFOS)
+    {
+        if (info.format == format)
+        {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+VkDeviceSize GetLevelByteSize(const FormatInfo& info, uint32_t width, uint32_t height)
+{
+    VkDeviceSize blocksX = (width + info.blockWidth - 1) / info.blockWidth;
+    VkDeviceSize blocksY = (height + info.blockHeight - 1) / info.blockHeight;
+    return blocksX * blocksY * info.blockBytes;
+}
+
+// First level whose largest side fits in TEXTURE_TAIL_SIZE.
+uint32_t GetTailLevel(uint32_t width, uint32_t height)
+{
+    uint32_t level = 0;
+    while ((std::max(width, height) >> level) > TEXTURE_TAIL_SIZE)
+    {
+        level++;
+    }
+    return level;
+}
+
+VkExtent2D GetLevelExtent(VkExtent2D extent, uint32_t level)
+{
+    return {std::max(1u, extent.width >> level), std::max(1u, extent.height >> level)};
+}
+
+VkImageMemoryBarrier MakeImageBarrier(
+    VkImage image,
+    uint32_t baseLevel,
+    uint32_t levelCount,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    VkAccessFlags srcAccess,
+    VkAccessFlags dstAccess)
+{
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, baseLevel, levelCount, 0, 1};
+    return barrier;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------//
+
+TextureManager::TextureManager(VkDeviceInstance* deviceInst, Renderer* renderer)
+    : deviceInst_(deviceInst), renderer_(renderer), loaderPool_(TEXTURE_LOADER_THREADS)
+{
+    // Linear blits and sampling need the format feature, nearest still gives valid mips.
+    VkFormatProperties formatProps;
+    vkGetPhysicalDeviceFormatProperties(deviceInst_->GetPhyDevice(), TEXTURE_FORMAT, &formatProps);
+    if (!(formatProps.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+    {
+        LOG_WARN("Texture Manager: No linear filtering for the texture format, using nearest");
+        blitFilter_ = VK_FILTER_NEAREST;
+    }
+
+    // Compressed formats also need their device feature, see VkDeviceInstance.
+    const VkPhysicalDeviceFeatures& features = deviceInst_->GetEnabledFeatures();
+    VkFormatFeatureFlags required =
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_SRC_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+
+    for (const FormatInfo& info : FORMAT_INFOS)
+    {
+        bool featureEnabled =
+            (info.family == FormatFamily::Uncompressed) ||
+            ((info.family == FormatFamily::BC) && features.textureCompressionBC) ||
+            ((info.family == FormatFamily::ETC2) && features.textureCompressionETC2) ||
+            ((info.family == FormatFamily::ASTC) && features.textureCompressionASTC_LDR);
+
+        VkFormatProperties props;
+        vkGetPhysicalDeviceFormatProperties(deviceInst_->GetPhyDevice(), info.format, &props);
+        if (featureEnabled && ((props.optimalTilingFeatures & required) == required))
+        {
+            sampledFormats_.push_back(info.format);
+        }
+    }
+
+    LOG_INFO("Texture Manager: Block compression BC {} / ETC2 {} / ASTC {}",
+             features.textureCompressionBC ? "yes" : "no (CPU decode)",
+             features.textureCompressionETC2 ? "yes" : "no",
+             features.textureCompressionASTC_LDR ? "yes" : "no");
+
+    CreateDescriptorObjects();
+    CreateFallback();
+}
+
+// Caller is expected to have waited for the device to go idle.
+TextureManager::~TextureManager()
+{
+    // Queued jobs return right away, running ones finish before loaderPool_ is joined.
+    stopping_ = true;
+
+    for (Texture& texture : textures_)
+    {
+        ReleaseGpuImage(texture.resident);
+        ReleaseGpuImage(texture.incoming);
+    }
+    ReleaseGpuImage(fallback_);
+
+    // Queued behind the image releases, their descriptor sets are freed first.
+    VkDevice device = deviceInst_->GetLogicalDevice();
+    const VkAllocationCallbacks* allocator = deviceInst_->GetAllocator();
+    VkDescriptorPool descriptorPool = descriptorPool_;
+    VkDescriptorSetLayout setLayout = setLayout_;
+    VkSampler sampler = sampler_;
+
+    renderer_->DeferDeletion([device, allocator, descriptorPool, setLayout, sampler]() {
+        vkDestroyDescriptorPool(device, descriptorPool, allocator);
+        vkDestroyDescriptorSetLayout(device, setLayout, allocator);
+        vkDestroySampler(device, sampler, allocator);
+    });
+}
+
+void TextureManager::CreateDescriptorObjects()
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    VkSamplerCreateInfo samplerInfo = {};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = blitFilter_;
+    samplerInfo.minFilter = blitFilter_;
+    samplerInfo.mipmapMode = (blitFilter_ == VK_FILTER_LINEAR) ?
+        VK_SAMPLER_MIPMAP_MODE_LINEAR : VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+    samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+
+    VK_CHECK(
+        vkCreateSampler(device, &samplerInfo, deviceInst_->GetAllocator(), &sampler_),
+        "Texture Manager: Failed to create sampler !!"
+    )
+
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &binding;
+
+    VK_CHECK(
+        vkCreateDescriptorSetLayout(device, &layoutInfo, deviceInst_->GetAllocator(), &setLayout_),
+        "Texture Manager: Failed to create descriptor set layout !!"
+    )
+
+    // One set per image, a texture has two while a stream step is being swapped in.
+    VkDescriptorPoolSize poolSize = {};
+    poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSize.descriptorCount = TEXTURE_MAX_DESCRIPTOR_SETS;
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    poolInfo.maxSets = TEXTURE_MAX_DESCRIPTOR_SETS;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    VK_CHECK(
+        vkCreateDescriptorPool(device, &poolInfo, deviceInst_->GetAllocator(), &descriptorPool_),
+        "Texture Manager: Failed to create descriptor pool !!"
+    )
+}
+
+void TextureManager::CreateFallback()
+{
+    const uint8_t white[4] = {255, 255, 255, 255};
+
+    if (!CreateGpuImage({1, 1}, 0, 1, TEXTURE_FORMAT, fallback_))
+    {
+        return;
+    }
+
+    // Needed by the very first frame, wait for it once at startup.
+    TransferQueue* transferQueue = deviceInst_->GetTransferQueue();
+    TransferTicket ticket = transferQueue->UploadImage(
+        fallback_.image,
+        white,
+        sizeof(white),
+        {1, 1, 1},
+        1,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        VK_ACCESS_SHADER_READ_BIT);
+    transferQueue->WaitReady(ticket);
+
+    CreateView(fallback_);
+}
+
+//----------------------------------------------------------------------------//
+
+TextureHandle TextureManager::Load(const std::string& filePath)
+{
+    auto it = pathLookup_.find(filePath);
+    if (it != pathLookup_.end())
+    {
+        return TextureHandle{it->second};
+    }
+
+    uint32_t textureId = static_cast<uint32_t>(textures_.size());
+    textures_.emplace_back();
+    textures_.back().filePath = filePath;
+    textures_.back().lastUsedFrame = frame_;
+    pathLookup_.emplace(filePath, textureId);
+
+    QueueLoad(textureId, UINT32_MAX);
+    return TextureHandle{textureId};
+}
+
+void TextureManager::QueueLoad(uint32_t textureId, uint32_t level)
+{
+    Texture& texture = textures_[textureId];
+    texture.loading = true;
+
+    // The tail level isn't known before decoding, it is the cheapest step anyway.
+    texture.reservedSize = (level == UINT32_MAX) ? 0 : EstimateSize(texture, level);
+
+    LoadRequest request;
+    request.textureId = textureId;
+    request.filePath = texture.filePath;
+    request.level = level;
+    request.format = texture.format;
+    request.source = texture.source;
+    request.ktx = texture.ktx;
+
+    loaderPool_.Enqueue([this, request = std::move(request)]() mutable {
+        LoadLevel(std::move(request));
+    });
+}
+
+bool TextureManager::CanSampleFormat(VkFormat format) const
+{
+    return std::find(sampledFormats_.begin(), sampledFormats_.end(), format) != sampledFormats_.end();
+}
+
+bool TextureManager::OpenSource(LoadRequest& request) const
+{
+    Core::MappedFile file;
+    if (!file.Open(request.filePath))
+    {
+        return false;
+    }
+
+    if (!Core::IsKtx2(file.GetData(), file.GetSize()))
+    {
+        auto decoded = std::make_shared<Core::ImageData>();
+        if (!Core::DecodeImage(file.GetData(), file.GetSize(), *decoded))
+        {
+            LOG_ERROR("Texture Manager: Unsupported or corrupted image {}", request.filePath);
+            return false;
+        }
+
+        request.source = std::move(decoded);
+        request.format = TEXTURE_FORMAT;
+        return true;
+    }
+
+    // Moving the MappedFile keeps the mapping where it is, parse once it's in place.
+    auto container = std::make_shared<KtxSource>();
+    container->file = std::move(file);
+    if (!Core::ParseKtx2(container->file.GetData(), container->file.GetSize(), container->image))
+    {
+        LOG_ERROR("Texture Manager: Failed to read {}", request.filePath);
+        return false;
+    }
+
+    VkFormat format = static_cast<VkFormat>(container->image.vkFormat);
+    const FormatInfo* info = FindFormatInfo(format);
+    if (info == nullptr)
+    {
+        LOG_ERROR("Texture Manager: {} uses unsupported format {}", request.filePath, container->image.vkFormat);
+        return false;
+    }
+
+    // Levels are copied to the GPU as they are, they must hold a whole level each.
+    for (const Core::Ktx2Level& level : container->image.levels)
+    {
+        if (level.size < GetLevelByteSize(*info, level.width, level.height))
+        {
+            LOG_ERROR("Texture Manager: {} has a truncated {}x{} level", request.filePath, level.width, level.height);
+            return false;
+        }
+    }
+
+    if (CanSampleFormat(format))
+    {
+        request.ktx = std::move(container);
+        request.format = format;
+        return true;
+    }
+
+    if (!info->cpuFormat)
+    {
+        LOG_ERROR("Texture Manager: {} uses format {} the device can't sample", request.filePath, container->image.vkFormat);
+        return false;
+    }
+
+    // Only level 0 is decoded, the finer levels are rebuilt like for any other image.
+    const Core::Ktx2Level& baseLevel = container->image.levels[0];
+    auto decoded = std::make_shared<Core::ImageData>();
+    if (!Core::DecodeBlocks(*info->cpuFormat, baseLevel.data, baseLevel.size, baseLevel.width, baseLevel.height, *decoded))
+    {
+        LOG_ERROR("Texture Manager: Failed to decode {}", request.filePath);
+        return false;
+    }
+
+    LOG_INFO("Texture Manager: {} decoded on the CPU, format {} isn't supported by the device",
+             request.filePath, container->image.vkFormat);
+    request.source = std::move(decoded);
+    request.format = info->srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+    return true;
+}
+
+void TextureManager::LoadLevel(LoadRequest request)
+{
+    PROFILE_SCOPE("TextureManager::LoadLevel");
+
+    if (stopping_)
+    {
+        return;
+    }
+
+    LoadResult result;
+    result.textureId = request.textureId;
+
+    // First step, or again after an eviction dropped the source.
+    bool opened = (request.source != nullptr) || (request.ktx != nullptr) || OpenSource(request);
+    if (!opened)
+    {
+        result.failed = true;
+    }
+    else if (request.ktx != nullptr)
+    {
+        const Core::Ktx2Image& image = request.ktx->image;
+        uint32_t levelCount = static_cast<uint32_t>(image.levels.size());
+        uint32_t level = request.level;
+        if (level == UINT32_MAX)
+        {
+            level = std::min(GetTailLevel(image.width, image.height), levelCount - 1);
+        }
+
+        // Fault the step's pages in here rather than in the staging copy on the render thread.
+        for (uint32_t i = level; i < levelCount; ++i)
+        {
+            request.ktx->file.Prefetch(
+                static_cast<size_t>(image.levels[i].data - request.ktx->file.GetData()), image.levels[i].size);
+        }
+        result.level = level;
+    }
+    else
+    {
+        const Core::ImageData& source = *request.source;
+        uint32_t level = request.level;
+        if (level == UINT32_MAX)
+        {
+            level = GetTailLevel(source.width, source.height);
+        }
+
+        // Same box filter and rounding as the mip chain built on the GPU.
+        if (level == 0)
+        {
+            result.pixels = source;
+        }
+        else
+        {
+            Core::HalveImage(source, result.pixels);
+            for (uint32_t i = 1; i < level; ++i)
+            {
+                Core::HalveImage(result.pixels, result.pixels);
+            }
+        }
+        result.level = level;
+    }
+
+    result.format = request.format;
+    result.source = std::move(request.source);
+    result.ktx = std::move(request.ktx);
+
+    std::lock_guard<std::mutex> lock(resultMutex_);
+    results_.push_back(std::move(result));
+}
+
+//----------------------------------------------------------------------------//
+
+void TextureManager::Update(VkCommandBuffer commandBuffer)
+{
+    PROFILE_SCOPE("TextureManager::Update");
+    frame_++;
+
+    FinishUploads(commandBuffer);
+    EvictLevels(commandBuffer);
+    StartUploads();
+    StreamLevels();
+}
+
+void TextureManager::StartUploads()
+{
+    std::vector<LoadResult> results;
+    {
+        std::lock_guard<std::mutex> lock(resultMutex_);
+        results.swap(results_);
+    }
+
+    TransferQueue* transferQueue = deviceInst_->GetTransferQueue();
+
+    for (LoadResult& result : results)
+    {
+        Texture& texture = textures_[result.textureId];
+        texture.loading = false;
+        texture.reservedSize = 0;
+
+        if (result.failed)
+        {
+            texture.failed = true;
+            LOG_ERROR("Texture Manager: Failed to load {}", texture.filePath);
+            continue;
+        }
+
+        if (texture.mipCount == 0)
+        {
+            texture.format = result.format;
+            if (result.ktx != nullptr)
+            {
+                texture.width = result.ktx->image.width;
+                texture.height = result.ktx->image.height;
+                texture.mipCount = static_cast<uint32_t>(result.ktx->image.levels.size());
+            }
+            else
+            {
+                texture.width = result.source->width;
+                texture.height = result.source->height;
+                texture.mipCount = Core::GetMipLevelCount(texture.width, texture.height);
+            }
+            texture.tailLevel = result.level;
+        }
+
+        // Evicted below this level while it was decoded, its source is gone as well.
+        if ((texture.resident.image != VK_NULL_HANDLE) && (result.level >= texture.resident.baseLevel))
+        {
+            continue;
+        }
+
+        GpuImage incoming;
+        VkExtent2D extent = GetLevelExtent({texture.width, texture.height}, result.level);
+        if (!CreateGpuImage(extent, result.level, texture.mipCount - result.level, result.format, incoming))
+        {
+            continue;
+        }
+
+        if (result.ktx != nullptr)
+        {
+            // Every level comes from the file, straight from the mapping into staging.
+            std::vector<ImageLevelData> levels;
+            for (uint32_t level = result.level; level < texture.mipCount; ++level)
+            {
+                const Core::Ktx2Level& ktxLevel = result.ktx->image.levels[level];
+                levels.push_back({ktxLevel.data, ktxLevel.size, {ktxLevel.width, ktxLevel.height, 1}});
+            }
+
+            texture.ticket = transferQueue->UploadImageLevels(
+                incoming.image,
+                levels,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_ACCESS_SHADER_READ_BIT);
+        }
+        else
+        {
+            // Only the finest level is uploaded, RecordMipGeneration builds the rest from it.
+            texture.ticket = transferQueue->UploadImage(
+                incoming.image,
+                result.pixels.rgba.data(),
+                result.pixels.GetByteSize(),
+                {extent.width, extent.height, 1},
+                1,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_ACCESS_TRANSFER_READ_BIT);
+            incoming.mipsPending = true;
+        }
+
+        // Nothing was written to the image (staging exhausted, upload rejected), a zero
+        // ticket would read as done and the mips would be built from undefined contents.
+        if (texture.ticket.value == 0)
+        {
+            ReleaseGpuImage(incoming);
+            texture.failed = true;
+            LOG_ERROR("Texture Manager: Failed to upload level {} of {}", result.level, texture.filePath);
+            continue;
+        }
+        texture.incoming = incoming;
+
+        // Kept for the finer steps, level 0 is the last one.
+        texture.source = (result.level == 0) ? nullptr : std::move(result.source);
+        texture.ktx = (result.level == 0) ? nullptr : std::move(result.ktx);
+    }
+}
+
+void TextureManager::FinishUploads(VkCommandBuffer commandBuffer)
+{
+    TransferQueue* transferQueue = deviceInst_->GetTransferQueue();
+
+    for (Texture& texture : textures_)
+    {
+        if ((texture.incoming.image == VK_NULL_HANDLE) || !transferQueue->IsReady(texture.ticket))
+        {
+            continue;
+        }
+
+        if (texture.incoming.mipsPending)
+        {
+            RecordMipGeneration(commandBuffer, texture.incoming);
+            texture.incoming.mipsPending = false;
+        }
+
+        if (!CreateView(texture.incoming))
+        {
+            ReleaseGpuImage(texture.incoming);
+            continue;
+        }
+
+        // Draws recorded from now on sample the new image, the old one goes with this frame.
+        ReleaseGpuImage(texture.resident);
+        texture.resident = texture.incoming;
+        texture.incoming = GpuImage{};
+    }
+}
+
+void TextureManager::EvictLevels(VkCommandBuffer commandBuffer)
+{
+    VkDeviceSize residentBytes = GetResidentBytes();
+    if (residentBytes <= budget_)
+    {
+        return;
+    }
+
+    std::vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < textures_.size(); ++i)
+    {
+        const Texture& texture = textures_[i];
+        if ((texture.resident.image != VK_NULL_HANDLE) && (texture.incoming.image == VK_NULL_HANDLE) &&
+            !texture.loading && (texture.resident.baseLevel < texture.tailLevel) && !IsRecentlyUsed(texture))
+        {
+            candidates.push_back(i);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [this](uint32_t lhs, uint32_t rhs) {
+        return textures_[lhs].lastUsedFrame < textures_[rhs].lastUsedFrame;
+    });
+
+    // One level per texture and frame, the next Update continues while over budget.
+    for (uint32_t textureId : candidates)
+    {
+        if (residentBytes <= budget_)
+        {
+            break;
+        }
+
+        Texture& texture = textures_[textureId];
+        uint32_t baseLevel = texture.resident.baseLevel + 1;
+
+        GpuImage smaller;
+        VkExtent2D extent = GetLevelExtent(texture.resident.extent, 1);
+        if (!CreateGpuImage(extent, baseLevel, texture.mipCount - baseLevel, texture.format, smaller))
+        {
+            break;
+        }
+
+        RecordLevelCopy(commandBuffer, texture.resident, smaller);
+        if (!CreateView(smaller))
+        {
+            ReleaseGpuImage(smaller);
+            break;
+        }
+
+        residentBytes -= std::min(residentBytes, texture.resident.size - std::min(texture.resident.size, smaller.size));
+        ReleaseGpuImage(texture.resident);
+        texture.resident = smaller;
+
+        // Decoded (or mapped) again if the texture streams back in.
+        texture.source = nullptr;
+        texture.ktx = nullptr;
+    }
+}
+
+void TextureManager::StreamLevels()
+{
+    std::vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < textures_.size(); ++i)
+    {
+        const Texture& texture = textures_[i];
+        if (texture.failed || texture.loading || (texture.incoming.image != VK_NULL_HANDLE))
+        {
+            continue;
+        }
+
+        // Nothing resident : a previous step couldn't create its image, start over.
+        if ((texture.resident.image == VK_NULL_HANDLE) ||
+            ((texture.resident.baseLevel > 0) && IsRecentlyUsed(texture)))
+        {
+            candidates.push_back(i);
+        }
+    }
+
+    // Coarsest resident level first, every texture gets usable before any gets sharp.
+    auto residentLevel = [this](uint32_t textureId) {
+        const Texture& texture = textures_[textureId];
+        return (texture.resident.image == VK_NULL_HANDLE) ? UINT32_MAX : texture.resident.baseLevel;
+    };
+    std::sort(candidates.begin(), candidates.end(), [&](uint32_t lhs, uint32_t rhs) {
+        if (residentLevel(lhs) != residentLevel(rhs))
+        {
+            return residentLevel(lhs) > residentLevel(rhs);
+        }
+        return textures_[lhs].lastUsedFrame > textures_[rhs].lastUsedFrame;
+    });
+
+    VkDeviceSize residentBytes = GetResidentBytes();
+    uint32_t started = 0;
+
+    for (uint32_t textureId : candidates)
+    {
+        if (started >= TEXTURE_UPLOADS_PER_FRAME)
+        {
+            break;
+        }
+
+        Texture& texture = textures_[textureId];
+        if (texture.resident.image == VK_NULL_HANDLE)
+        {
+            QueueLoad(textureId, UINT32_MAX);
+            started++;
+            continue;
+        }
+
+        // The old image stays alive next to the new one until the swap.
+        uint32_t level = texture.resident.baseLevel - 1;
+        VkDeviceSize size = EstimateSize(texture, level);
+        if ((residentBytes + size) > budget_)
+        {
+            continue;
+        }
+
+        QueueLoad(textureId, level);
+        residentBytes += size;
+        started++;
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+bool TextureManager::CreateGpuImage(
+    VkExtent2D extent,
+    uint32_t baseLevel,
+    uint32_t levelCount,
+    VkFormat format,
+    GpuImage& gpuImage)
+{
+    VkImageCreateInfo imageInfo = {};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = format;
+    imageInfo.extent = {extent.width, extent.height, 1};
+    imageInfo.mipLevels = levelCount;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    deviceInst_->CreateImageWithInfo(
+        imageInfo,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        gpuImage.image,
+        gpuImage.memory,
+        MemoryCategory::Texture);
+
+    if ((gpuImage.image == VK_NULL_HANDLE) || (gpuImage.memory == VK_NULL_HANDLE))
+    {
+        LOG_ERROR("Texture Manager: Failed to create a {}x{} texture image", extent.width, extent.height);
+        ReleaseGpuImage(gpuImage);
+        return false;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(deviceInst_->GetLogicalDevice(), gpuImage.image, &memRequirements);
+
+    gpuImage.format = format;
+    gpuImage.extent = extent;
+    gpuImage.baseLevel = baseLevel;
+    gpuImage.levelCount = levelCount;
+    gpuImage.size = memRequirements.size;
+    return true;
+}
+
+bool TextureManager::CreateView(GpuImage& gpuImage)
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    VkImageViewCreateInfo viewInfo = {};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = gpuImage.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = gpuImage.format;
+    viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, gpuImage.levelCount, 0, 1};
+
+    VK_CHECK(
+        vkCreateImageView(device, &viewInfo, deviceInst_->GetAllocator(), &gpuImage.view),
+        "Texture Manager: Failed to create image view !!"
+    )
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool_;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &setLayout_;
+
+    if (vkAllocateDescriptorSets(device, &allocInfo, &gpuImage.descriptorSet) != VK_SUCCESS)
+    {
+        LOG_ERROR("Texture Manager: Out of descriptor sets, raise TEXTURE_MAX_DESCRIPTOR_SETS");
+        gpuImage.descriptorSet = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.sampler = sampler_;
+    imageInfo.imageView = gpuImage.view;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = gpuImage.descriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    return true;
+}
+
+void TextureManager::ReleaseGpuImage(GpuImage& gpuImage)
+{
+    if ((gpuImage.image == VK_NULL_HANDLE) && (gpuImage.memory == VK_NULL_HANDLE))
+    {
+        return;
+    }
+
+    VkDeviceInstance* deviceInst = deviceInst_;
+    VkDescriptorPool descriptorPool = descriptorPool_;
+    GpuImage released = gpuImage;
+
+    renderer_->DeferDeletion([deviceInst, descriptorPool, released]() {
+        VkDevice device = deviceInst->GetLogicalDevice();
+        if (released.descriptorSet != VK_NULL_HANDLE)
+        {
+            vkFreeDescriptorSets(device, descriptorPool, 1, &released.descriptorSet);
+        }
+        vkDestroyImageView(device, released.view, deviceInst->GetAllocator());
+        vkDestroyImage(device, released.image, deviceInst->GetAllocator());
+        deviceInst->FreeMemory(released.memory);
+    });
+
+    gpuImage = GpuImage{};
+}
+
+//----------------------------------------------------------------------------//
+
+void TextureManager::RecordMipGeneration(VkCommandBuffer commandBuffer, const GpuImage& gpuImage)
+{
+    if (gpuImage.levelCount > 1)
+    {
+        VkImageMemoryBarrier toTransfer = MakeImageBarrier(
+            gpuImage.image, 1, gpuImage.levelCount - 1,
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            0, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+    }
+
+    // Each level is blitted from the previous one, then becomes the next source.
+    for (uint32_t level = 1; level < gpuImage.levelCount; ++level)
+    {
+        VkExtent2D srcExtent = GetLevelExtent(gpuImage.extent, level - 1);
+        VkExtent2D dstExtent = GetLevelExtent(gpuImage.extent, level);
+
+        VkImageBlit blit = {};
+        blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1};
+        blit.srcOffsets[1] = {static_cast<int32_t>(srcExtent.width), static_cast<int32_t>(srcExtent.height), 1};
+        blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+        blit.dstOffsets[1] = {static_cast<int32_t>(dstExtent.width), static_cast<int32_t>(dstExtent.height), 1};
+
+        vkCmdBlitImage(
+            commandBuffer,
+            gpuImage.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            gpuImage.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1, &blit, blitFilter_);
+
+        VkImageMemoryBarrier toSource = MakeImageBarrier(
+            gpuImage.image, level, 1,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &toSource);
+    }
+
+    VkImageMemoryBarrier toShader = MakeImageBarrier(
+        gpuImage.image, 0, gpuImage.levelCount,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &toShader);
+}
+
+void TextureManager::RecordLevelCopy(VkCommandBuffer commandBuffer, const GpuImage& src, const GpuImage& dst)
+{
+    uint32_t skippedLevels = dst.baseLevel - src.baseLevel;
+
+    // Earlier frames may still be sampling 'src', the barrier waits for them.
+    VkImageMemoryBarrier toTransfer[2] = {
+        MakeImageBarrier(
+            src.image, skippedLevels, dst.levelCount,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            0, VK_ACCESS_TRANSFER_READ_BIT),
+        MakeImageBarrier(
+            dst.image, 0, dst.levelCount,
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            0, VK_ACCESS_TRANSFER_WRITE_BIT)
+    };
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, 2, toTransfer);
+
+    std::vector<VkImageCopy> regions(dst.levelCount);
+    for (uint32_t level = 0; level < dst.levelCount; ++level)
+    {
+        VkExtent2D extent = GetLevelExtent(dst.extent, level);
+
+        VkImageCopy& region = regions[level];
+        region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, skippedLevels + level, 0, 1};
+        region.srcOffset = {0, 0, 0};
+        region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+        region.dstOffset = {0, 0, 0};
+        region.extent = {extent.width, extent.height, 1};
+    }
+
+    vkCmdCopyImage(
+        commandBuffer,
+        src.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        dst.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        static_cast<uint32_t>(regions.size()), regions.data());
+
+    // 'src' is released with this frame, it stays in TRANSFER_SRC.
+    VkImageMemoryBarrier toShader = MakeImageBarrier(
+        dst.image, 0, dst.levelCount,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &toShader);
+}
+
+//----------------------------------------------------------------------------//
+
+VkDeviceSize TextureManager::GetResidentBytes() const
+{
+    VkDeviceSize bytes = 0;
+    for (const Texture& texture : textures_)
+    {
+        bytes += texture.resident.size + texture.incoming.size + texture.reservedSize;
+    }
+    return bytes;
+}
+
+VkDeviceSize TextureManager::EstimateSize(const Texture& texture, uint32_t baseLevel)
+{
+    const FormatInfo* info = FindFormatInfo(texture.format);
+    if (info == nullptr)
+    {
+        info = FindFormatInfo(TEXTURE_FORMAT);
+    }
+
+    VkDeviceSize size = 0;
+    for (uint32_t level = baseLevel; level < texture.mipCount; ++level)
+    {
+        VkExtent2D extent = GetLevelExtent({texture.width, texture.height}, level);
+        size += GetLevelByteSize(*info, extent.width, extent.height);
+    }
+    return size;
+}
+
+TextureStats TextureManager::GetStats() const
+{
+    TextureStats stats;
+    stats.textureCount = static_cast<uint32_t>(textures_.size());
+    stats.budget = budget_;
+
+    for (const Texture& texture : textures_)
+    {
+        stats.residentCount += (texture.resident.image != VK_NULL_HANDLE) ? 1 : 0;
+        stats.streamingCount += (texture.loading || (texture.incoming.image != VK_NULL_HANDLE)) ? 1 : 0;
+        stats.residentBytes += texture.resident.size;
+    }
+    return stats;
+}
+
+} // namespace Graphic
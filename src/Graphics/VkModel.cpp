@@ -3,48 +3,191 @@
 
 #include <Logging.hpp>
 
+// STD Lib
+#include <algorithm>
+#include <cstring>
+
 namespace Graphic
 {
 
 VkModel::VkModel(
     VkDeviceInstance* vkInstance,
-    std::vector<Vertex>& vertices) : vkInstance_(vkInstance)
+    std::vector<Vertex>& vertices)
+    : VkModel(vkInstance, vertices.data(), static_cast<uint32_t>(vertices.size()), nullptr, 0)
+{
+}
+
+VkModel::VkModel(
+    VkDeviceInstance* vkInstance,
+    const std::vector<Vertex>& vertices,
+    const std::vector<uint32_t>& indices)
+    : VkModel(
+        vkInstance,
+        vertices.data(),
+        static_cast<uint32_t>(vertices.size()),
+        indices.data(),
+        static_cast<uint32_t>(indices.size()))
+{
+}
+
+VkModel::VkModel(
+    VkDeviceInstance* vkInstance,
+    const Vertex* vertices,
+    uint32_t vertexCount,
+    const uint32_t* indices,
+    uint32_t indexCount) : vkInstance_(vkInstance)
 {
-    CreateVertexBuffers(vertices);
+    CreateVertexBuffers(vertices, vertexCount);
+    if (indices != nullptr)
+    {
+        CreateIndexBuffer(indices, indexCount);
+    }
 }
 
 VkModel::~VkModel()
 {
-    vkDestroyBuffer(vkInstance_->GetLogicalDevice(), vertexBuffer_, nullptr);
-    vkFreeMemory(vkInstance_->GetLogicalDevice(), vertexBufferMem_, nullptr);
+    // The copy may still be writing into the buffers.
+    vkInstance_->GetTransferQueue()->GetTimeline()->Wait(uploadTicket_.value);
+    vkDestroyBuffer(vkInstance_->GetLogicalDevice(), vertexBuffer_, vkInstance_->GetAllocator());
+    vkInstance_->FreeMemory(vertexBufferMem_);
+
+    if (indexBuffer_ != VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(vkInstance_->GetLogicalDevice(), indexBuffer_, vkInstance_->GetAllocator());
+        vkInstance_->FreeMemory(indexBufferMem_);
+    }
 }
 
-void VkModel::CreateVertexBuffers(const std::vector<Vertex>& vertices)
+void VkModel::CreateVertexBuffers(const Vertex* vertices, uint32_t vertexCount)
 {
-    vertexCount_ = static_cast<uint32_t>(vertices.size());
+    vertexCount_ = vertexCount;
 
     if (vertexCount_ < 3)
     {
         LOG_ERROR("Model Binding: Vertex count is less than 3 !");
     }
 
-    VkDeviceSize bufferSize = (sizeof(vertices[0]) * vertexCount_);
+    VkDeviceSize bufferSize = (sizeof(Vertex) * vertexCount_);
 
-    vkInstance_->CreateBuffer(
+    CreateGeometryBuffer(
+        vertices,
         bufferSize,
         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
         vertexBuffer_,
-        vertexBufferMem_
-    );
+        vertexBufferMem_);
+}
+
+void VkModel::CreateIndexBuffer(const uint32_t* indices, uint32_t indexCount)
+{
+    indexCount_ = indexCount;
+
+    if ((indexCount_ < 3) || ((indexCount_ % 3) != 0))
+    {
+        LOG_ERROR("Model Binding: Index count {} is not a triangle list !", indexCount_);
+    }
 
-    void* data;
-    VK_CHECK(
-        vkMapMemory(vkInstance_->GetLogicalDevice(), vertexBufferMem_, 0, bufferSize, 0, &data),
-        "Failed to map memory !"
+    if (indexCount_ == 0)
+    {
+        return;
+    }
+
+    VkDeviceSize bufferSize = (sizeof(uint32_t) * indexCount_);
+
+    CreateGeometryBuffer(
+        indices,
+        bufferSize,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        VK_ACCESS_INDEX_READ_BIT,
+        indexBuffer_,
+        indexBufferMem_);
+}
+
+void VkModel::CreateGeometryBuffer(
+    const void* data,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkAccessFlags dstAccess,
+    VkBuffer& buffer,
+    VkDeviceMemory& bufferMem)
+{
+    constexpr VkMemoryPropertyFlags UMA_PROPERTIES =
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    // Device local, host visible when the memory is shared so the staging copy can be
+    // skipped. Integrated GPUs without such a memory type get plain device local memory.
+    VkMemoryPropertyFlags usedProperties = vkInstance_->CreateBuffer(
+        size,
+        usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        vkInstance_->IsUnifiedMemory() ? UMA_PROPERTIES : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        buffer,
+        bufferMem,
+        MemoryCategory::Geometry,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
     );
-    memcpy(data, vertices.data(), static_cast<size_t>(bufferSize));
-    vkUnmapMemory(vkInstance_->GetLogicalDevice(), vertexBufferMem_);
+
+    if ((usedProperties & UMA_PROPERTIES) == UMA_PROPERTIES)
+    {
+        // Same memory either way, a staging copy would only double the traffic. Host
+        // writes are visible to the next queue submission.
+        void* mapped = nullptr;
+        VK_CHECK(
+            vkMapMemory(vkInstance_->GetLogicalDevice(), bufferMem, 0, size, 0, &mapped),
+            "Model Binding: Failed to map geometry buffer !!"
+        )
+        if (mapped != nullptr)
+        {
+            std::memcpy(mapped, data, static_cast<size_t>(size));
+            vkUnmapMemory(vkInstance_->GetLogicalDevice(), bufferMem);
+        }
+        return;
+    }
+
+    // Filled from a staging buffer on the transfer queue.
+    UploadInBatches(buffer, data, size, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, dstAccess);
+}
+
+void VkModel::SetLods(const std::vector<ModelLod>& lods)
+{
+    lods_.clear();
+    for (const ModelLod& lod : lods)
+    {
+        if ((lod.indexCount == 0) || (lod.firstIndex > indexCount_) || (lod.indexCount > (indexCount_ - lod.firstIndex)))
+        {
+            LOG_WARN("Model Binding: Dropping LOD {} out of the index buffer !", lods_.size());
+            continue;
+        }
+        lods_.push_back(lod);
+    }
+}
+
+void VkModel::UploadInBatches(
+    VkBuffer dstBuffer,
+    const void* data,
+    VkDeviceSize size,
+    VkPipelineStageFlags dstStage,
+    VkAccessFlags dstAccess)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (VkDeviceSize offset = 0; offset < size; offset += MODEL_UPLOAD_BATCH_SIZE)
+    {
+        TransferTicket ticket = vkInstance_->GetTransferQueue()->UploadBuffer(
+            dstBuffer,
+            bytes + offset,
+            std::min<VkDeviceSize>(MODEL_UPLOAD_BATCH_SIZE, size - offset),
+            dstStage,
+            dstAccess,
+            offset);
+
+        if (ticket.value == 0)
+        {
+            // The earlier batches are still in flight, keep their ticket for the destructor.
+            LOG_ERROR("Model Binding: Failed to upload {} bytes at offset {}, the model won't be drawn !", size, offset);
+            uploadFailed_ = true;
+            return;
+        }
+        uploadTicket_ = ticket;
+    }
 }
 
 void VkModel::Bind(VkCommandBuffer cmdBuffer)
@@ -52,11 +195,28 @@ void VkModel::Bind(VkCommandBuffer cmdBuffer)
     VkBuffer buffers[] = {vertexBuffer_};
     VkDeviceSize offsets[] = {0};
     vkCmdBindVertexBuffers(cmdBuffer, 0, 1, buffers, offsets);
+
+    if (indexBuffer_ != VK_NULL_HANDLE)
+    {
+        vkCmdBindIndexBuffer(cmdBuffer, indexBuffer_, 0, VK_INDEX_TYPE_UINT32);
+    }
 }
 
-void VkModel::Draw(VkCommandBuffer cmdBuffer)
+void VkModel::Draw(VkCommandBuffer cmdBuffer, uint32_t lod, uint32_t instanceCount)
 {
-    vkCmdDraw(cmdBuffer, vertexCount_, 1, 0, 0);
+    if (!lods_.empty())
+    {
+        const ModelLod& range = lods_[std::min<size_t>(lod, lods_.size() - 1)];
+        vkCmdDrawIndexed(cmdBuffer, range.indexCount, instanceCount, range.firstIndex, 0, 0);
+        return;
+    }
+
+    if (indexBuffer_ != VK_NULL_HANDLE)
+    {
+        vkCmdDrawIndexed(cmdBuffer, indexCount_, instanceCount, 0, 0, 0);
+        return;
+    }
+    vkCmdDraw(cmdBuffer, vertexCount_, instanceCount, 0, 0);
 }
 
 std::vector<VkVertexInputBindingDescription> Vertex::GetBindingDescriptions()
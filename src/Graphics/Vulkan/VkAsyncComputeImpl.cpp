@@ -0,0 +1,142 @@
+#include <Graphics/Vulkan/VkAsyncComputeImpl.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <cassert>
+
+namespace Graphic
+{
+
+AsyncCompute::AsyncCompute(VkDeviceInstance* deviceInst)
+    : deviceInst_(deviceInst)
+{
+    uint32_t computeFamily = deviceInst_->GetComputeFamilyIdx();
+    uint32_t graphicsFamily = deviceInst_->GetGraphicsFamilyIdx();
+
+    async_ = (computeFamily != graphicsFamily);
+    timeline_ = async_ ? deviceInst_->GetComputeTimeline() : deviceInst_->GetGraphicsTimeline();
+
+    queueFamilies_.push_back(graphicsFamily);
+    if (async_)
+    {
+        queueFamilies_.push_back(computeFamily);
+    }
+
+    LOG_INFO("Async Compute: {} (family {})", async_ ? "dedicated compute queue" : "graphics queue", computeFamily);
+}
+
+AsyncCompute::~AsyncCompute()
+{
+    timeline_->Wait(timeline_->GetSubmittedValue());
+
+    for (VkCommandPool pool : commandPools_)
+    {
+        // Frees the command buffers allocated from it as well.
+        vkDestroyCommandPool(deviceInst_->GetLogicalDevice(), pool, deviceInst_->GetAllocator());
+    }
+}
+
+void AsyncCompute::CreateSlot()
+{
+    VkCommandPool pool = VK_NULL_HANDLE;
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = deviceInst_->GetComputeFamilyIdx();
+
+    VK_CHECK(
+        vkCreateCommandPool(deviceInst_->GetLogicalDevice(), &poolInfo, deviceInst_->GetAllocator(), &pool),
+        "Async Compute: Failed to create command pool !!"
+    )
+
+    VkCommandBufferAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandPool = pool;
+    allocInfo.commandBufferCount = 1;
+
+    VK_CHECK(
+        vkAllocateCommandBuffers(deviceInst_->GetLogicalDevice(), &allocInfo, &commandBuffer),
+        "Async Compute: Failed to allocate command buffer !!"
+    )
+
+    commandPools_.push_back(pool);
+    commandBuffers_.push_back(commandBuffer);
+    slotValue_.push_back(0);
+}
+
+VkCommandBuffer AsyncCompute::Begin(size_t frameSlot)
+{
+    assert((recordingSlot_ == SIZE_MAX) && "Async Compute: Begin called twice without Submit");
+    PROFILE_SCOPE("AsyncCompute::Begin");
+
+    while (frameSlot >= commandPools_.size())
+    {
+        CreateSlot();
+    }
+
+    // Usually long done, the slot was last used a full round of frames ago.
+    timeline_->Wait(slotValue_[frameSlot]);
+
+    vkResetCommandPool(deviceInst_->GetLogicalDevice(), commandPools_[frameSlot], 0);
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VK_CHECK(
+        vkBeginCommandBuffer(commandBuffers_[frameSlot], &beginInfo),
+        "Async Compute: Failed to begin command buffer !!"
+    )
+
+    recordingSlot_ = frameSlot;
+    return commandBuffers_[frameSlot];
+}
+
+uint64_t AsyncCompute::Submit(uint64_t graphicsWait)
+{
+    assert((recordingSlot_ != SIZE_MAX) && "Async Compute: Submit called without Begin");
+
+    VkCommandBuffer commandBuffer = commandBuffers_[recordingSlot_];
+    VK_CHECK(
+        vkEndCommandBuffer(commandBuffer),
+        "Async Compute: Failed to record command buffer !!"
+    )
+
+    // Also needed on the graphics queue : submission order alone doesn't order the
+    // compute writes after the frame still reading the slot's resources.
+    std::vector<SemaphoreSubmit> waits;
+    if (graphicsWait != 0)
+    {
+        waits.push_back({
+            deviceInst_->GetGraphicsTimeline()->GetSemaphore(),
+            graphicsWait,
+            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT});
+    }
+
+    uint64_t value = timeline_->Submit(&commandBuffer, 1, waits);
+    slotValue_[recordingSlot_] = value;
+    pendingGraphicsWait_ = value;
+    recordingSlot_ = SIZE_MAX;
+
+    return value;
+}
+
+bool AsyncCompute::TakeGraphicsWait(VkPipelineStageFlags2 stageMask, SemaphoreSubmit& wait)
+{
+    if (pendingGraphicsWait_ == 0) { return false; }
+
+    // On the graphics queue this waits on its own timeline, an earlier submit. Still
+    // needed, submission order alone doesn't make the compute writes visible.
+    wait = {timeline_->GetSemaphore(), pendingGraphicsWait_, stageMask};
+    pendingGraphicsWait_ = 0;
+    return true;
+}
+
+} // namespace Graphic
@@ -0,0 +1,324 @@
+#include <Graphics/Vulkan/VkFrameCaptureImpl.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace Graphic
+{
+
+static bool IsBgraFormat(VkFormat format)
+{
+    return (format == VK_FORMAT_B8G8R8A8_SRGB) || (format == VK_FORMAT_B8G8R8A8_UNORM);
+}
+
+static bool IsRgbaFormat(VkFormat format)
+{
+    return (format == VK_FORMAT_R8G8B8A8_SRGB) || (format == VK_FORMAT_R8G8B8A8_UNORM);
+}
+
+FrameCapture::FrameCapture(VkDeviceInstance* deviceInst, const FrameCaptureConfig& config)
+    : deviceInst_(deviceInst), config_(config)
+{
+    if (config_.outputDir.empty())
+    {
+        // Note : PROJECT_DIRECTORY macro is added by CMakeList.txt
+        config_.outputDir = (std::string)PROJECT_DIRECTORY + FRAME_CAPTURE_DIR;
+    }
+    config_.frameStride = std::max(config_.frameStride, 1u);
+
+    std::error_code errCode;
+    std::filesystem::create_directories(config_.outputDir, errCode);
+    if (errCode)
+    {
+        LOG_ERROR("Frame Capture: Unable to create {} ({})", config_.outputDir, errCode.message());
+    }
+
+    writerThread_ = std::thread(&FrameCapture::WriterLoop, this);
+    LOG_INFO("Frame Capture: Writing {} frames to {}",
+             Core::ImageFileExtension(config_.format), config_.outputDir);
+}
+
+FrameCapture::~FrameCapture()
+{
+    Flush();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    jobCondition_.notify_all();
+
+    if (writerThread_.joinable())
+    {
+        writerThread_.join();
+    }
+
+    for (auto& slot : slots_)
+    {
+        DestroySlotBuffer(slot);
+    }
+
+    LOG_INFO("Frame Capture: {} frames written, {} dropped", GetWrittenCount(), GetDroppedCount());
+}
+
+//----------------------------------------------------------------------------//
+
+void FrameCapture::EnsureSlotBuffer(ReadbackSlot& slot, VkDeviceSize size)
+{
+    if (slot.size >= size) { return; }
+
+    // Only reached on the first capture or after the swapchain grew, the slot is idle.
+    DestroySlotBuffer(slot);
+
+    deviceInst_->CreateBuffer(
+        size,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        slot.buffer,
+        slot.memory,
+        MemoryCategory::Readback);
+
+    VK_CHECK(
+        vkMapMemory(deviceInst_->GetLogicalDevice(), slot.memory, 0, size, 0, &slot.mapped),
+        "Frame Capture: Failed to map readback buffer !!"
+    )
+    slot.size = size;
+}
+
+void FrameCapture::DestroySlotBuffer(ReadbackSlot& slot)
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    if (slot.memory != VK_NULL_HANDLE)
+    {
+        vkUnmapMemory(device, slot.memory);
+        deviceInst_->FreeMemory(slot.memory);
+    }
+    if (slot.buffer != VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(device, slot.buffer, deviceInst_->GetAllocator());
+    }
+
+    slot.buffer = VK_NULL_HANDLE;
+    slot.memory = VK_NULL_HANDLE;
+    slot.mapped = nullptr;
+    slot.size = 0;
+}
+
+//----------------------------------------------------------------------------//
+
+bool FrameCapture::RecordCopy(
+    VkCommandBuffer commandBuffer,
+    uint32_t frameSlot,
+    VkImage image,
+    VkFormat format,
+    VkExtent2D extent,
+    VkImageLayout layout)
+{
+    assert(frameSlot < MAX_FRAMES_IN_FLIGHT);
+    ReadbackSlot& slot = slots_[frameSlot];
+    assert(!slot.pending && "CollectSlot must run before the slot records again");
+
+    uint64_t frameIndex = frameCounter_++;
+    if (IsFinished() || ((frameIndex % config_.frameStride) != 0)) { return false; }
+
+    if (!IsBgraFormat(format) && !IsRgbaFormat(format))
+    {
+        LOG_WARN("Frame Capture: Unsupported color format {}, frame skipped", static_cast<int32_t>(format));
+        droppedCount_++;
+        return false;
+    }
+
+    EnsureSlotBuffer(slot, static_cast<VkDeviceSize>(extent.width) * extent.height * 4);
+
+    // Render pass writes -> transfer read, moving the image into TRANSFER_SRC if needed.
+    VkImageMemoryBarrier toTransfer = {};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransfer.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toTransfer.oldLayout = layout;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = image;
+    toTransfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+    VkBufferImageCopy region = {};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0; // Tightly packed
+    region.bufferImageHeight = 0;
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = {extent.width, extent.height, 1};
+
+    vkCmdCopyImageToBuffer(
+        commandBuffer,
+        image,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        slot.buffer,
+        1, &region);
+
+    // Make the copy visible to the host once the frame fence signals.
+    VkBufferMemoryBarrier toHost = {};
+    toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.buffer = slot.buffer;
+    toHost.offset = 0;
+    toHost.size = VK_WHOLE_SIZE;
+
+    uint32_t imageBarrierCount = 0;
+    VkImageMemoryBarrier toOriginal = toTransfer;
+    if (layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
+    {
+        // Presentation waits on a semaphore, no access needs to be made available.
+        toOriginal.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        toOriginal.dstAccessMask = 0;
+        toOriginal.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toOriginal.newLayout = layout;
+        imageBarrierCount = 1;
+    }
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        0, 0, nullptr, 1, &toHost, imageBarrierCount, &toOriginal);
+
+    slot.pending = true;
+    slot.captureIndex = captureCounter_++;
+    slot.extent = extent;
+    slot.format = format;
+    return true;
+}
+
+void FrameCapture::CollectSlot(uint32_t frameSlot)
+{
+    assert(frameSlot < MAX_FRAMES_IN_FLIGHT);
+    ReadbackSlot& slot = slots_[frameSlot];
+    if (!slot.pending) { return; }
+    slot.pending = false;
+
+    PROFILE_SCOPE("FrameCapture::CollectSlot");
+
+    std::vector<uint8_t> pixels;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if (jobs_.size() >= FRAME_CAPTURE_QUEUE_DEPTH)
+        {
+            if (config_.dropWhenBusy)
+            {
+                droppedCount_++;
+                return;
+            }
+
+            // Back-pressure, only hit when the disk can't keep up with the GPU.
+            spaceCondition_.wait(lock, [this]() { return jobs_.size() < FRAME_CAPTURE_QUEUE_DEPTH; });
+        }
+
+        if (!freePixelBuffers_.empty())
+        {
+            pixels = std::move(freePixelBuffers_.back());
+            freePixelBuffers_.pop_back();
+        }
+    }
+
+    // Host coherent memory, the fence wait already made the copy visible.
+    size_t size = static_cast<size_t>(slot.extent.width) * slot.extent.height * 4;
+    pixels.resize(size);
+    memcpy(pixels.data(), slot.mapped, size);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back({slot.captureIndex, slot.extent, slot.format, std::move(pixels)});
+    }
+    jobCondition_.notify_one();
+}
+
+void FrameCapture::Flush()
+{
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        CollectSlot(i);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    spaceCondition_.wait(lock, [this]() { return jobs_.empty() && !writing_; });
+}
+
+//----------------------------------------------------------------------------//
+
+void FrameCapture::WriterLoop()
+{
+    PROFILE_THREAD_NAME("FrameWriter");
+
+    while (true)
+    {
+        WriteJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobCondition_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+
+            if (jobs_.empty()) { return; } // Stopping with nothing left
+
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            writing_ = true;
+        }
+        spaceCondition_.notify_all();
+
+        {
+            PROFILE_SCOPE("FrameCapture::Write");
+
+            if (IsBgraFormat(job.format))
+            {
+                for (size_t i = 0; i < job.pixels.size(); i += 4)
+                {
+                    std::swap(job.pixels[i], job.pixels[i + 2]);
+                }
+            }
+
+            char fileName[32];
+            snprintf(fileName, sizeof(fileName), "frame_%06llu",
+                     static_cast<unsigned long long>(job.captureIndex));
+            std::string filePath = config_.outputDir + "/" + fileName + Core::ImageFileExtension(config_.format);
+
+            if (Core::WriteImageFile(filePath, config_.format, job.extent.width, job.extent.height, job.pixels.data()))
+            {
+                writtenCount_++;
+            }
+            else
+            {
+                droppedCount_++;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            freePixelBuffers_.push_back(std::move(job.pixels));
+            writing_ = false;
+        }
+        spaceCondition_.notify_all();
+    }
+}
+
+} // namespace Graphic
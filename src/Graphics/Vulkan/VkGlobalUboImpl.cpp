@@ -0,0 +1,164 @@
+#include <Graphics/Vulkan/VkGlobalUboImpl.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <cassert>
+#include <cstring>
+
+namespace Graphic
+{
+
+GlobalUniformBuffer::GlobalUniformBuffer(VkDeviceInstance* deviceInst, uint32_t frameCount)
+    : deviceInst_(deviceInst), frameCount_(frameCount)
+{
+    CreateBuffer();
+    CreateDescriptors();
+    WriteDescriptor();
+}
+
+GlobalUniformBuffer::~GlobalUniformBuffer()
+{
+    // Caller is expected to have waited for the device to go idle.
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    // Frees the set as well.
+    vkDestroyDescriptorPool(device, descriptorPool_, deviceInst_->GetAllocator());
+    vkDestroyDescriptorSetLayout(device, setLayout_, deviceInst_->GetAllocator());
+
+    DestroyBuffer();
+}
+
+void GlobalUniformBuffer::SetFrameCount(uint32_t frameCount)
+{
+    if (frameCount == frameCount_) { return; }
+
+    DestroyBuffer();
+    frameCount_ = frameCount;
+    CreateBuffer();
+    WriteDescriptor();
+    currentOffset_ = 0;
+}
+
+void GlobalUniformBuffer::DestroyBuffer()
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    if (memory_ != VK_NULL_HANDLE)
+    {
+        vkUnmapMemory(device, memory_);
+        deviceInst_->FreeMemory(memory_);
+    }
+    vkDestroyBuffer(device, buffer_, deviceInst_->GetAllocator());
+
+    buffer_ = VK_NULL_HANDLE;
+    memory_ = VK_NULL_HANDLE;
+    mapped_ = nullptr;
+}
+
+void GlobalUniformBuffer::CreateBuffer()
+{
+    VkDeviceSize alignment = deviceInst_->GetPhyDeviceProperties().limits.minUniformBufferOffsetAlignment;
+    slotStride_ = sizeof(GlobalUbo);
+    if (alignment > 0)
+    {
+        slotStride_ = (slotStride_ + alignment - 1) & ~(alignment - 1);
+    }
+
+    VkDeviceSize size = slotStride_ * frameCount_;
+    deviceInst_->CreateBuffer(
+        size,
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        buffer_,
+        memory_,
+        MemoryCategory::Uniform);
+
+    VK_CHECK(
+        vkMapMemory(deviceInst_->GetLogicalDevice(), memory_, 0, size, 0, &mapped_),
+        "Global UBO: Failed to map uniform buffer !!"
+    )
+    std::memset(mapped_, 0, static_cast<size_t>(size));
+}
+
+void GlobalUniformBuffer::CreateDescriptors()
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &binding;
+
+    VK_CHECK(
+        vkCreateDescriptorSetLayout(device, &layoutInfo, deviceInst_->GetAllocator(), &setLayout_),
+        "Global UBO: Failed to create descriptor set layout !!"
+    )
+
+    VkDescriptorPoolSize poolSize = {};
+    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSize.descriptorCount = 1;
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    VK_CHECK(
+        vkCreateDescriptorPool(device, &poolInfo, deviceInst_->GetAllocator(), &descriptorPool_),
+        "Global UBO: Failed to create descriptor pool !!"
+    )
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool_;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &setLayout_;
+
+    VK_CHECK(
+        vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet_),
+        "Global UBO: Failed to allocate descriptor set !!"
+    )
+}
+
+void GlobalUniformBuffer::WriteDescriptor()
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+
+    // One slot wide, the dynamic offset picks the slot.
+    VkDescriptorBufferInfo bufferInfo = {};
+    bufferInfo.buffer = buffer_;
+    bufferInfo.offset = 0;
+    bufferInfo.range = sizeof(GlobalUbo);
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = descriptorSet_;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    write.pBufferInfo = &bufferInfo;
+
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+}
+
+void GlobalUniformBuffer::Update(size_t frameSlot, const GlobalUbo& ubo)
+{
+    assert((frameSlot < frameCount_) && "Global UBO: Invalid frame slot");
+
+    VkDeviceSize offset = slotStride_ * frameSlot;
+    std::memcpy(static_cast<uint8_t*>(mapped_) + offset, &ubo, sizeof(GlobalUbo));
+    currentOffset_ = static_cast<uint32_t>(offset);
+}
+
+} // namespace Graphic
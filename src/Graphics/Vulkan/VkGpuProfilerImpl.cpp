@@ -0,0 +1,256 @@
+#include <Graphics/Vulkan/VkGpuProfilerImpl.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <cassert>
+
+namespace Graphic
+{
+
+// Query 0/1 are the frame begin/end, each scope then takes two consecutive queries.
+constexpr uint32_t FRAME_BEGIN_QUERY = 0;
+constexpr uint32_t FRAME_END_QUERY = 1;
+constexpr uint32_t FIRST_SCOPE_QUERY = 2;
+constexpr uint32_t TIMESTAMP_QUERY_COUNT = FIRST_SCOPE_QUERY + (GPU_PROFILER_MAX_SCOPES * 2);
+
+// Results are written in bit order, vertex invocations come before fragment invocations.
+constexpr VkQueryPipelineStatisticFlags PROFILER_STATISTICS =
+    VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+constexpr uint32_t STATISTICS_VALUE_COUNT = 2;
+
+GpuProfiler::GpuProfiler(VkDeviceInstance* deviceInst)
+    : device_(deviceInst->GetLogicalDevice()), allocator_(deviceInst->GetAllocator())
+{
+#if ENABLE_GPU_PROFILER
+    QueueFamilyIndices indices = FindQueueFamilies(deviceInst->GetPhyDevice(), deviceInst->GetSurface());
+    std::vector<VkQueueFamilyProperties> families = GetDeviceQueueFamilyProperties(deviceInst->GetPhyDevice());
+    uint32_t validBits = families[indices.graphicsFamilyIdx].timestampValidBits;
+
+    if (validBits == 0)
+    {
+        LOG_WARN("GPU Profiler: Graphics queue does not support timestamps, profiler disabled");
+        return;
+    }
+
+    timestampMask_ = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1);
+    timestampPeriodNs_ = static_cast<double>(deviceInst->GetPhyDeviceProperties().limits.timestampPeriod);
+    statisticsEnabled_ = deviceInst->IsPipelineStatisticsEnabled();
+    enabled_ = true;
+
+    CreateQueryPools();
+    LOG_INFO("GPU Profiler: Enabled (pipeline statistics {})", statisticsEnabled_ ? "on" : "off");
+#endif
+}
+
+GpuProfiler::~GpuProfiler()
+{
+    for (auto& frame : frames_)
+    {
+        if (frame.timestampPool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(device_, frame.timestampPool, allocator_);
+        }
+        if (frame.statisticsPool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(device_, frame.statisticsPool, allocator_);
+        }
+    }
+}
+
+void GpuProfiler::CreateQueryPools()
+{
+    for (auto& frame : frames_)
+    {
+        VkQueryPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        poolInfo.queryCount = TIMESTAMP_QUERY_COUNT;
+
+        VK_CHECK(
+            vkCreateQueryPool(device_, &poolInfo, allocator_, &frame.timestampPool),
+            "GPU Profiler: Failed to create timestamp query pool !!"
+        )
+
+        if (statisticsEnabled_)
+        {
+            poolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            poolInfo.queryCount = GPU_PROFILER_MAX_SCOPES;
+            poolInfo.pipelineStatistics = PROFILER_STATISTICS;
+
+            VK_CHECK(
+                vkCreateQueryPool(device_, &poolInfo, allocator_, &frame.statisticsPool),
+                "GPU Profiler: Failed to create pipeline statistics query pool !!"
+            )
+        }
+
+        frame.scopes.reserve(GPU_PROFILER_MAX_SCOPES);
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+void GpuProfiler::BeginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+{
+    if (!enabled_) { return; }
+
+    assert(frameIndex < MAX_FRAMES_IN_FLIGHT);
+    FrameQueries& frame = frames_[frameIndex];
+
+    // The slot's fence was waited on before it was reused, its queries are available.
+    ReadBack(frame);
+
+    vkCmdResetQueryPool(commandBuffer, frame.timestampPool, 0, TIMESTAMP_QUERY_COUNT);
+    if (frame.statisticsPool != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(commandBuffer, frame.statisticsPool, 0, GPU_PROFILER_MAX_SCOPES);
+    }
+
+    frame.scopes.clear();
+    frame.statisticsCount = 0;
+    frame.recorded = true;
+
+    currentFrame_ = &frame;
+    openDepth_ = 0;
+    statisticsActive_ = false;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.timestampPool, FRAME_BEGIN_QUERY);
+}
+
+void GpuProfiler::EndFrame(VkCommandBuffer commandBuffer)
+{
+    if (!enabled_ || (currentFrame_ == nullptr)) { return; }
+
+    if (openDepth_ != 0)
+    {
+        LOG_WARN("GPU Profiler: {} scope(s) still open at the end of the frame", openDepth_);
+
+        // Write their end queries anyway so the readback of the frame is not blocked,
+        // they stay marked as open and are left out of the results.
+        for (const ScopeRecord& scope : currentFrame_->scopes)
+        {
+            if (scope.closed) { continue; }
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                currentFrame_->timestampPool, scope.beginQuery + 1);
+        }
+    }
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, currentFrame_->timestampPool, FRAME_END_QUERY);
+    currentFrame_ = nullptr;
+}
+
+uint32_t GpuProfiler::BeginScope(VkCommandBuffer commandBuffer, const char* name, bool pipelineStatistics)
+{
+    if (!enabled_ || (currentFrame_ == nullptr)) { return UINT32_MAX; }
+
+    FrameQueries& frame = *currentFrame_;
+    if (frame.scopes.size() >= GPU_PROFILER_MAX_SCOPES) { return UINT32_MAX; }
+
+    uint32_t scopeIndex = static_cast<uint32_t>(frame.scopes.size());
+
+    ScopeRecord scope = {};
+    scope.name = name;
+    scope.depth = openDepth_++;
+    scope.beginQuery = FIRST_SCOPE_QUERY + (scopeIndex * 2);
+    scope.statisticsQuery = UINT32_MAX;
+    scope.closed = false;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.timestampPool, scope.beginQuery);
+
+    if (pipelineStatistics && statisticsEnabled_ && !statisticsActive_)
+    {
+        scope.statisticsQuery = frame.statisticsCount++;
+        vkCmdBeginQuery(commandBuffer, frame.statisticsPool, scope.statisticsQuery, 0);
+        statisticsActive_ = true;
+    }
+
+    frame.scopes.push_back(scope);
+    return scopeIndex;
+}
+
+void GpuProfiler::EndScope(VkCommandBuffer commandBuffer, uint32_t scopeIndex)
+{
+    if (!enabled_ || (currentFrame_ == nullptr) || (scopeIndex == UINT32_MAX)) { return; }
+
+    FrameQueries& frame = *currentFrame_;
+    assert(scopeIndex < frame.scopes.size());
+
+    ScopeRecord& scope = frame.scopes[scopeIndex];
+    assert(!scope.closed && "GPU scope closed twice");
+
+    if (scope.statisticsQuery != UINT32_MAX)
+    {
+        vkCmdEndQuery(commandBuffer, frame.statisticsPool, scope.statisticsQuery);
+        statisticsActive_ = false;
+    }
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.timestampPool, scope.beginQuery + 1);
+
+    scope.closed = true;
+    openDepth_--;
+}
+
+//----------------------------------------------------------------------------//
+
+void GpuProfiler::ReadBack(FrameQueries& frame)
+{
+    if (!frame.recorded) { return; }
+    frame.recorded = false;
+
+    uint32_t queryCount = FIRST_SCOPE_QUERY + static_cast<uint32_t>(frame.scopes.size() * 2);
+    std::array<uint64_t, TIMESTAMP_QUERY_COUNT> timestamps = {};
+
+    // No WAIT flag, a frame that is somehow not finished is skipped instead of stalling.
+    VkResult result = vkGetQueryPoolResults(
+        device_, frame.timestampPool,
+        0, queryCount,
+        sizeof(timestamps), timestamps.data(), sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) { return; }
+
+    std::array<uint64_t, GPU_PROFILER_MAX_SCOPES * STATISTICS_VALUE_COUNT> statistics = {};
+    bool hasStatistics = false;
+    if ((frame.statisticsPool != VK_NULL_HANDLE) && (frame.statisticsCount > 0))
+    {
+        hasStatistics = (vkGetQueryPoolResults(
+            device_, frame.statisticsPool,
+            0, frame.statisticsCount,
+            sizeof(statistics), statistics.data(), sizeof(uint64_t) * STATISTICS_VALUE_COUNT,
+            VK_QUERY_RESULT_64_BIT) == VK_SUCCESS);
+    }
+
+    lastFrameGpuMs_ = TicksToMs(timestamps[FRAME_BEGIN_QUERY], timestamps[FRAME_END_QUERY]);
+
+    lastResults_.clear();
+    for (const ScopeRecord& scope : frame.scopes)
+    {
+        if (!scope.closed) { continue; }
+
+        GpuScopeResult scopeResult = {};
+        scopeResult.name = scope.name;
+        scopeResult.depth = scope.depth;
+        scopeResult.gpuMs = TicksToMs(timestamps[scope.beginQuery], timestamps[scope.beginQuery + 1]);
+
+        if (hasStatistics && (scope.statisticsQuery != UINT32_MAX))
+        {
+            const uint64_t* values = &statistics[scope.statisticsQuery * STATISTICS_VALUE_COUNT];
+            scopeResult.hasStatistics = true;
+            scopeResult.vertexInvocations = values[0];
+            scopeResult.fragmentInvocations = values[1];
+        }
+
+        lastResults_.push_back(std::move(scopeResult));
+    }
+}
+
+double GpuProfiler::TicksToMs(uint64_t begin, uint64_t end) const
+{
+    uint64_t ticks = ((end & timestampMask_) - (begin & timestampMask_)) & timestampMask_;
+    return (static_cast<double>(ticks) * timestampPeriodNs_) / 1000000.0;
+}
+
+} // namespace Graphic
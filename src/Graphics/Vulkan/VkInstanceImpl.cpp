@@ -8,6 +8,8 @@
 
 // std
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <set>
 #include <iostream>
 
@@ -152,12 +154,31 @@ inline std::vector<VkPhysicalDevice> GetAvailableDevices(VkInstance instance)
     return availPhysicalDevices;
 }
 
+// Name substring or UUID (dashes and braces ignored), both case insensitive.
+inline bool MatchesGpuOverride(const std::string& gpuOverride, const char* deviceName, const std::string& uuid)
+{
+    auto toLower = [](std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    };
+
+    std::string request = toLower(gpuOverride);
+    if (toLower(deviceName).find(request) != std::string::npos) { return true; }
+
+    request.erase(std::remove_if(request.begin(), request.end(),
+        [](char c) { return (c == '-') || (c == '{') || (c == '}'); }), request.end());
+    return request == uuid;
+}
+
 //----------------------------------------------------------------------------//
 
 
-VkDeviceInstance::VkDeviceInstance(WindowHandler* window)
+VkDeviceInstance::VkDeviceInstance(WindowHandler* window, const std::string& gpuOverride)
 {
     window_ = window;
+    gpuOverride_ = gpuOverride;
     InitVulkan();
 }
 
@@ -165,32 +186,40 @@ VkDeviceInstance::~VkDeviceInstance()
 {
     if (logicalDevice_ != VK_NULL_HANDLE)
     {
+        // Flushes the cache to disk before the device goes away.
+        pipelineCache_.reset();
+        asyncComputeInst_.reset();
+        transferQueueInst_.reset();
+        computeTimelineInst_.reset();
+        transferTimeline_.reset();
+        graphicsTimeline_.reset();
+
         if (commandPool_ != VK_NULL_HANDLE)
         {
-            vkDestroyCommandPool(logicalDevice_, commandPool_, nullptr);
+            vkDestroyCommandPool(logicalDevice_, commandPool_, GetAllocator());
             LOG_INFO("VK Instance: Terminate CommandPool");
         }
 
         LOG_INFO("VK Instance: Terminate Logical Device");
-        vkDestroyDevice(logicalDevice_, nullptr);
+        vkDestroyDevice(logicalDevice_, GetAllocator());
     }
 
     if (instance_ != VK_NULL_HANDLE)
     {
         if (surfaceKHR_ != VK_NULL_HANDLE)
         {
-            vkDestroySurfaceKHR(instance_, surfaceKHR_, nullptr);            
+            vkDestroySurfaceKHR(instance_, surfaceKHR_, GetAllocator());            
             LOG_INFO("VK Instance: Terminate Surface KHR");
         }
 
         if ((debugMessenger_ != VK_NULL_HANDLE) || debuggingEnabled_)
         {
             LOG_INFO("VK Instance: Terminate DebugMessenger");
-            DestroyDebugUtilsMessengerEXT(instance_, debugMessenger_, nullptr);
+            DestroyDebugUtilsMessengerEXT(instance_, debugMessenger_, GetAllocator());
         }
 
         LOG_INFO("VK Instance: Terminate VkInstance");
-        vkDestroyInstance(instance_, nullptr);
+        vkDestroyInstance(instance_, GetAllocator());
     }
 }
 
@@ -202,6 +231,9 @@ void VkDeviceInstance::InitVulkan()
     PickPhysicalDevice();
     CreateLogicalDeviceAndQueue();
     CreateCommandPool();
+    CreateTransferQueue();
+    CreateAsyncCompute();
+    CreatePipelineCache();
 }
 
 //----------------------------------------------------------------------------//
@@ -236,16 +268,35 @@ void VkDeviceInstance::CreateInstance()
 #endif
 
     VK_CHECK(
-        vkCreateInstance(&instanceCreationInfo, nullptr, &instance_),
+        vkCreateInstance(&instanceCreationInfo, GetAllocator(), &instance_),
         "VK Instance: Failed to initialize instance"
     )
 }
 
 std::vector<const char*> VkDeviceInstance::GetSupportedInstanceExtensions()
 {
-    std::vector<const char*> reqInstExt = GetGLFWRequiredExtensions();
     std::vector<VkExtensionProperties> availInstExt = GetAvailableInstanceExtensions();
     std::vector<const char*> supInstExt;
+    std::vector<const char*> reqInstExt;
+
+    if (window_ != nullptr)
+    {
+        reqInstExt = GetGLFWRequiredExtensions();
+    }
+    else if (HEADLESS_SURFACE_EXT)
+    {
+        // Headless surface is optional, without it we render offscreen.
+        headlessSurfaceExt_ = std::any_of(availInstExt.begin(), availInstExt.end(),
+            [](const VkExtensionProperties& ext) {
+                return strcmp(ext.extensionName, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME) == 0;
+            });
+
+        if (headlessSurfaceExt_)
+        {
+            reqInstExt.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+            reqInstExt.push_back(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME);
+        }
+    }
 
 #ifdef __APPLE__
     reqInstExt.push_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
@@ -303,10 +354,36 @@ bool VkDeviceInstance::CheckSupportedValidationLayers()
 
 void VkDeviceInstance::CreateSurface()
 {
-    VK_CHECK(
-        glfwCreateWindowSurface(instance_, window_->GetWindowHandlerPointer(), nullptr, &surfaceKHR_),
-        "VK Instance: Failed to create surface."
-    )
+    if (window_ != nullptr)
+    {
+        VK_CHECK(
+            glfwCreateWindowSurface(instance_, window_->GetWindowHandlerPointer(), GetAllocator(), &surfaceKHR_),
+            "VK Instance: Failed to create surface."
+        )
+        return;
+    }
+
+    if (!headlessSurfaceExt_)
+    {
+        LOG_INFO("VK Instance: Headless without surface, rendering offscreen");
+        return;
+    }
+
+    auto createHeadlessSurface = reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(
+        vkGetInstanceProcAddr(instance_, "vkCreateHeadlessSurfaceEXT"));
+
+    VkHeadlessSurfaceCreateInfoEXT surfaceInfo = {};
+    surfaceInfo.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+
+    if ((createHeadlessSurface == nullptr) ||
+        (createHeadlessSurface(instance_, &surfaceInfo, GetAllocator(), &surfaceKHR_) != VK_SUCCESS))
+    {
+        LOG_WARN("VK Instance: Failed to create headless surface, rendering offscreen");
+        surfaceKHR_ = VK_NULL_HANDLE;
+        return;
+    }
+
+    LOG_INFO("VK Instance: Headless surface created");
 }
 
 //----------------------------------------------------------------------------//
@@ -318,7 +395,7 @@ void VkDeviceInstance::SetupDebugMessenger()
     VkDebugUtilsMessengerCreateInfoEXT msgCreationInfo = GetDebugMessengerCreateInfo();
 
     VK_CHECK(
-        CreateDebugUtilsMessengerEXT(instance_, &msgCreationInfo, nullptr, &debugMessenger_),
+        CreateDebugUtilsMessengerEXT(instance_, &msgCreationInfo, GetAllocator(), &debugMessenger_),
         "VK Instance: Debug Messenger setup failed .."
     )
 }
@@ -329,29 +406,130 @@ void VkDeviceInstance::PickPhysicalDevice()
 {
     std::vector<VkPhysicalDevice> availPhysicalDevices = GetAvailableDevices(instance_);
 
-    // Filter out non compatible devices.
-    for (uint32_t index = 0; index < availPhysicalDevices.size(); ++index)
+    std::string gpuOverride = gpuOverride_;
+    if (gpuOverride.empty())
+    {
+        const char* envOverride = std::getenv(GPU_SELECT_ENV);
+        gpuOverride = (envOverride != nullptr) ? envOverride : "";
+    }
+
+    // Score the compatible devices, the enumeration order decides ties.
+    VkPhysicalDevice bestDevice = VK_NULL_HANDLE;
+    VkPhysicalDevice overrideDevice = VK_NULL_HANDLE;
+    uint64_t bestScore = 0;
+
+    for (VkPhysicalDevice device : availPhysicalDevices)
     {
-        if (!IsDeviceCompatible(availPhysicalDevices[index]))
+        VkPhysicalDeviceProperties properties = {};
+        vkGetPhysicalDeviceProperties(device, &properties);
+        std::string uuid = GetDeviceUUIDString(device);
+
+        if (!IsDeviceCompatible(device))
+        {
+            LOG_INFO("VK Instance: GPU {} ({}, uuid {}) -> incompatible",
+                properties.deviceName, GetDeviceTypeName(properties.deviceType), uuid);
+            continue;
+        }
+
+        uint64_t score = ScorePhysicalDevice(device);
+        LOG_INFO("VK Instance: GPU {} ({}, {} MiB, uuid {}) -> score {}",
+            properties.deviceName, GetDeviceTypeName(properties.deviceType),
+            GetDeviceLocalHeapSize(device) >> 20, uuid, score);
+
+        if ((bestDevice == VK_NULL_HANDLE) || (score > bestScore))
+        {
+            bestDevice = device;
+            bestScore = score;
+        }
+
+        if (!gpuOverride.empty() && (overrideDevice == VK_NULL_HANDLE) &&
+            MatchesGpuOverride(gpuOverride, properties.deviceName, uuid))
         {
-            availPhysicalDevices.erase(availPhysicalDevices.begin() + index);
+            overrideDevice = device;
         }
     }
 
-    if (availPhysicalDevices.empty())
+    if (bestDevice == VK_NULL_HANDLE)
     {
         LOG_CRITICAL_EXIT("VK Instance: No available GPU to be binded.");
     }
 
-    // Future logic for choosing with GPU
+    if (!gpuOverride.empty() && (overrideDevice == VK_NULL_HANDLE))
+    {
+        LOG_WARN("VK Instance: GPU override '{}' matches no compatible GPU, using the highest score", gpuOverride);
+    }
 
-    physicalDevice_ = availPhysicalDevices[0];
+    physicalDevice_ = (overrideDevice != VK_NULL_HANDLE) ? overrideDevice : bestDevice;
     vkGetPhysicalDeviceProperties(physicalDevice_, &phyDevProperties_);
-    LOG_INFO("Vk Instance: Acquired {}",phyDevProperties_.deviceName);
+    LOG_INFO("Vk Instance: Acquired {} ({})", phyDevProperties_.deviceName,
+        (overrideDevice != VK_NULL_HANDLE) ? "override" : "highest score");
+}
+
+uint64_t VkDeviceInstance::ScorePhysicalDevice(VkPhysicalDevice device)
+{
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(device, &properties);
+
+    // The device type dominates, the rest only orders GPUs of the same type.
+    uint64_t score = 0;
+    switch (properties.deviceType)
+    {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: score = 1000000; break;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: score = 100000; break;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: score = 10000; break;
+        default: break;
+    }
+
+    // One point per 64 MiB of device local memory.
+    score += GetDeviceLocalHeapSize(device) / (64ull << 20);
+
+    // Queues used by the transfer queue and async compute, and a single queue for
+    // graphics and present.
+    if (FindTransferQueueFamily(device, UINT32_MAX) != UINT32_MAX) { score += 200; }
+    if (FindComputeQueueFamily(device, UINT32_MAX) != UINT32_MAX) { score += 200; }
+    if (surfaceKHR_ != VK_NULL_HANDLE)
+    {
+        QueueFamilyIndices families = FindQueueFamilies(device, surfaceKHR_);
+        if (families.graphicsFamilyIdx == families.presentFamilyIdx) { score += 100; }
+    }
+
+    // Optional features enabled by CreateLogicalDeviceAndQueue.
+    VkPhysicalDeviceVulkan13Features vulkan13Features = {};
+    vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    VkPhysicalDeviceFeatures2 features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = (properties.apiVersion >= VK_API_VERSION_1_3) ? &vulkan13Features : nullptr;
+    vkGetPhysicalDeviceFeatures2(device, &features);
+
+    if (vulkan13Features.synchronization2) { score += 300; }
+    if (vulkan13Features.dynamicRendering) { score += 300; }
+    if (features.features.pipelineStatisticsQuery) { score += 50; }
+    if (GetSupportedOptionalDeviceExtensions(device).size() == optionalDevExt.size()) { score += 100; }
+
+    return score;
 }
 
 bool VkDeviceInstance::IsDeviceCompatible(VkPhysicalDevice device)
 {
+    // Frame completion is tracked with timeline semaphores (core in 1.2).
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(device, &properties);
+    if (properties.apiVersion < VK_API_VERSION_1_2) { return false; }
+
+    VkPhysicalDeviceVulkan12Features vulkan12Features = {};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &vulkan12Features;
+    vkGetPhysicalDeviceFeatures2(device, &features);
+    if (!vulkan12Features.timelineSemaphore) { return false; }
+
+    // Offscreen rendering only needs a graphics queue.
+    if (surfaceKHR_ == VK_NULL_HANDLE)
+    {
+        return FindQueueFamilies(device, surfaceKHR_).IsComplete();
+    }
+
     return (FindQueueFamilies(device, surfaceKHR_).IsComplete() &&
             !GetSupportedDeviceExtensions(device).empty() &&
             GetSwapChainSupport(device, surfaceKHR_).IsValid());
@@ -366,46 +544,201 @@ std::vector<const char*> VkDeviceInstance::GetSupportedDeviceExtensions(VkPhysic
     return supportedDevExt;
 }
 
+std::vector<const char*> VkDeviceInstance::GetSupportedOptionalDeviceExtensions(VkPhysicalDevice device)
+{
+    std::vector<VkExtensionProperties> availDevExt = GetAvailableDeviceExtensions(device);
+    std::vector<const char*> supportedDevExt;
+
+    for (const char* optional : optionalDevExt)
+    {
+        for (const auto& extension : availDevExt)
+        {
+            if (strcmp(optional, extension.extensionName) == 0)
+            {
+                supportedDevExt.push_back(optional);
+                break;
+            }
+        }
+    }
+    return supportedDevExt;
+}
+
 //----------------------------------------------------------------------------//
 
 void VkDeviceInstance::CreateLogicalDeviceAndQueue()
 {
     QueueFamilyIndices familyIndices = FindQueueFamilies(physicalDevice_, surfaceKHR_);
     std::vector<const char*> availableDevExt = GetSupportedDeviceExtensions(physicalDevice_);
-    std::set<uint32_t> queueFamilyIndex = {familyIndices.graphicsFamilyIdx, familyIndices.presentFamilyIdx};
+    graphicsFamilyIdx_ = familyIndices.graphicsFamilyIdx;
+    transferFamilyIdx_ = USE_TRANSFER_QUEUE ?
+        FindTransferQueueFamily(physicalDevice_, familyIndices.graphicsFamilyIdx) : familyIndices.graphicsFamilyIdx;
+    computeFamilyIdx_ = USE_ASYNC_COMPUTE ?
+        FindComputeQueueFamily(physicalDevice_, familyIndices.graphicsFamilyIdx) : familyIndices.graphicsFamilyIdx;
+    std::set<uint32_t> queueFamilyIndex = {
+        familyIndices.graphicsFamilyIdx, familyIndices.presentFamilyIdx, transferFamilyIdx_, computeFamilyIdx_};
     std::vector<VkDeviceQueueCreateInfo> queueCreateList;
-    float queuePriority = 1.0f;
+    float queuePriority[2] = {1.0f, 1.0f};
+
+    // Without a transfer-only family, uploads land on the compute family as well. A second
+    // queue keeps them apart, otherwise both share queue 0 and its timeline.
+    uint32_t computeQueueIdx = 0;
+    if (HasAsyncCompute() && (computeFamilyIdx_ == transferFamilyIdx_) &&
+        (GetQueueFamilyQueueCount(physicalDevice_, computeFamilyIdx_) > 1))
+    {
+        computeQueueIdx = 1;
+    }
 
-    LOG_INFO("Vk Instance: GraphicIdx {} - PresentIdx {}",familyIndices.graphicsFamilyIdx ,familyIndices.presentFamilyIdx);
+    LOG_INFO("Vk Instance: GraphicIdx {} - PresentIdx {} - TransferIdx {} - ComputeIdx {}",
+             familyIndices.graphicsFamilyIdx, familyIndices.presentFamilyIdx, transferFamilyIdx_, computeFamilyIdx_);
 
     for (uint32_t index : queueFamilyIndex)
     {
         VkDeviceQueueCreateInfo queueCreateInfo = {};
         queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
         queueCreateInfo.queueFamilyIndex = index;
-        queueCreateInfo.queueCount = 1;
-        queueCreateInfo.pQueuePriorities = &queuePriority;
+        queueCreateInfo.queueCount = ((index == computeFamilyIdx_) && (computeQueueIdx == 1)) ? 2 : 1;
+        queueCreateInfo.pQueuePriorities = queuePriority;
         queueCreateInfo.pNext = nullptr;
         queueCreateList.push_back(queueCreateInfo);
     }
 
-    VkPhysicalDeviceFeatures phyDevFeatures = {};
+    // Optional features are queried first and only enabled when fully supported.
+    std::vector<const char*> optionalExt = GetSupportedOptionalDeviceExtensions(physicalDevice_);
+    auto hasOptionalExt = [&optionalExt](const char* name) {
+        return std::find_if(optionalExt.begin(), optionalExt.end(),
+            [name](const char* ext) { return strcmp(ext, name) == 0; }) != optionalExt.end();
+    };
+
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {};
+    presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {};
+    presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+    VkPhysicalDeviceFeatures2 supportedFeatures = {};
+    supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+
+    bool presentTimingAvail = ENABLE_PRESENT_TIMING && (surfaceKHR_ != VK_NULL_HANDLE) &&
+                              hasOptionalExt(VK_KHR_PRESENT_ID_EXTENSION_NAME) &&
+                              hasOptionalExt(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+    if (presentTimingAvail)
+    {
+        presentIdFeatures.pNext = &presentWaitFeatures;
+        supportedFeatures.pNext = &presentIdFeatures;
+    }
+
+    // Core 1.3 features, only queryable when the device itself reports 1.3.
+    VkPhysicalDeviceVulkan13Features vulkan13Features = {};
+    vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    bool vulkan13Avail = (phyDevProperties_.apiVersion >= VK_API_VERSION_1_3);
+    if (vulkan13Avail)
+    {
+        vulkan13Features.pNext = supportedFeatures.pNext;
+        supportedFeatures.pNext = &vulkan13Features;
+    }
+    vkGetPhysicalDeviceFeatures2(physicalDevice_, &supportedFeatures);
+
+    // Chain of features to enable, built front to back.
+    VkPhysicalDeviceFeatures2 enabledFeatures = {};
+    enabledFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    void** featureChainTail = &enabledFeatures.pNext;
+
+    presentWaitEnabled_ = presentTimingAvail && presentIdFeatures.presentId && presentWaitFeatures.presentWait;
+    if (presentWaitEnabled_)
+    {
+        presentIdFeatures.pNext = nullptr;
+        presentWaitFeatures.pNext = nullptr;
+        *featureChainTail = &presentIdFeatures;
+        presentIdFeatures.pNext = &presentWaitFeatures;
+        featureChainTail = &presentWaitFeatures.pNext;
+
+        availableDevExt.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        availableDevExt.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+        LOG_INFO("Vk Instance: Present timing enabled (present_id/present_wait)");
+    }
+
+    // Heap budget and usage for the memory stats, no feature to enable
+    memoryBudgetEnabled_ = hasOptionalExt(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    if (memoryBudgetEnabled_)
+    {
+        availableDevExt.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
+    // Vertex/fragment invocation counters for the GPU profiler
+    pipelineStatsEnabled_ = GPU_PROFILER_PIPELINE_STATS && supportedFeatures.features.pipelineStatisticsQuery;
+    enabledFeatures.features.pipelineStatisticsQuery = pipelineStatsEnabled_ ? VK_TRUE : VK_FALSE;
+
+    // Block compressed texture formats, the texture manager transcodes BCn on the CPU
+    // when missing and rejects the others
+    enabledFeatures.features.textureCompressionBC = supportedFeatures.features.textureCompressionBC;
+    enabledFeatures.features.textureCompressionETC2 = supportedFeatures.features.textureCompressionETC2;
+    enabledFeatures.features.textureCompressionASTC_LDR = supportedFeatures.features.textureCompressionASTC_LDR;
+    enabledCoreFeatures_ = enabledFeatures.features;
+
+    synchronization2Enabled_ = vulkan13Avail && vulkan13Features.synchronization2;
+    dynamicRenderingEnabled_ = USE_DYNAMIC_RENDERING && synchronization2Enabled_ && vulkan13Features.dynamicRendering;
+
+    VkPhysicalDeviceVulkan13Features enabledVulkan13 = {};
+    enabledVulkan13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    if (synchronization2Enabled_)
+    {
+        enabledVulkan13.synchronization2 = VK_TRUE;
+        enabledVulkan13.dynamicRendering = dynamicRenderingEnabled_ ? VK_TRUE : VK_FALSE;
+        *featureChainTail = &enabledVulkan13;
+        featureChainTail = &enabledVulkan13.pNext;
+    }
+    LOG_INFO("Vk Instance: Rendering path {}", dynamicRenderingEnabled_ ? "dynamic rendering" : "render pass");
+
+    // Checked by IsDeviceCompatible()
+    VkPhysicalDeviceVulkan12Features enabledVulkan12 = {};
+    enabledVulkan12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    enabledVulkan12.timelineSemaphore = VK_TRUE;
+    *featureChainTail = &enabledVulkan12;
+    featureChainTail = &enabledVulkan12.pNext;
+
+    enabledDevExt_ = availableDevExt;
 
     VkDeviceCreateInfo deviceCreateInfo = {};
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceCreateInfo.pNext = &enabledFeatures;
     deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateList.size());
     deviceCreateInfo.pQueueCreateInfos = queueCreateList.data();
-    deviceCreateInfo.pEnabledFeatures = &phyDevFeatures;
+    deviceCreateInfo.pEnabledFeatures = nullptr; // Provided through VkPhysicalDeviceFeatures2
     deviceCreateInfo.enabledExtensionCount = availableDevExt.size();
     deviceCreateInfo.ppEnabledExtensionNames = availableDevExt.data();
 
     VK_CHECK(
-        vkCreateDevice(physicalDevice_, &deviceCreateInfo, nullptr, &logicalDevice_),
+        vkCreateDevice(physicalDevice_, &deviceCreateInfo, GetAllocator(), &logicalDevice_),
         "VK Instance: Logical Device creation failed."
     )
 
+    memoryStats_.Init(physicalDevice_, memoryBudgetEnabled_);
+
     vkGetDeviceQueue(logicalDevice_, familyIndices.graphicsFamilyIdx, 0, &graphicsQueue_);
     vkGetDeviceQueue(logicalDevice_, familyIndices.presentFamilyIdx, 0, &presentQueue_);
+
+    vkGetDeviceQueue(logicalDevice_, transferFamilyIdx_, 0, &transferQueue_);
+
+    graphicsTimeline_ = std::make_unique<QueueTimeline>(logicalDevice_, GetAllocator(), graphicsQueue_, synchronization2Enabled_);
+    if (transferFamilyIdx_ != graphicsFamilyIdx_)
+    {
+        transferTimeline_ = std::make_unique<QueueTimeline>(logicalDevice_, GetAllocator(), transferQueue_, synchronization2Enabled_);
+    }
+
+    vkGetDeviceQueue(logicalDevice_, computeFamilyIdx_, computeQueueIdx, &computeQueue_);
+    if (!HasAsyncCompute())
+    {
+        computeTimeline_ = nullptr;
+    }
+    else if (computeQueue_ == transferQueue_)
+    {
+        // Same VkQueue, submissions have to go through one timeline (and its mutex).
+        computeTimeline_ = transferTimeline_.get();
+    }
+    else
+    {
+        computeTimelineInst_ = std::make_unique<QueueTimeline>(logicalDevice_, GetAllocator(), computeQueue_, synchronization2Enabled_);
+        computeTimeline_ = computeTimelineInst_.get();
+    }
 }
 
 //----------------------------------------------------------------------------//
@@ -420,11 +753,26 @@ void VkDeviceInstance::CreateCommandPool()
     poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 
     VK_CHECK(
-        vkCreateCommandPool(logicalDevice_, &poolInfo, nullptr, &commandPool_),
+        vkCreateCommandPool(logicalDevice_, &poolInfo, GetAllocator(), &commandPool_),
         "VK Instance: Failed to create comamnd pool"
     )
 }
 
+void VkDeviceInstance::CreateTransferQueue()
+{
+    transferQueueInst_ = std::make_unique<TransferQueue>(this);
+}
+
+void VkDeviceInstance::CreateAsyncCompute()
+{
+    asyncComputeInst_ = std::make_unique<AsyncCompute>(this);
+}
+
+void VkDeviceInstance::CreatePipelineCache()
+{
+    pipelineCache_ = std::make_unique<PipelineCacheInstance>(logicalDevice_, GetAllocator(), phyDevProperties_);
+}
+
 //----------------------------------------------------------------------------//
 
 VkFormat VkDeviceInstance::FindSupportedFormat(
@@ -453,6 +801,18 @@ VkFormat VkDeviceInstance::FindSupportedFormat(
 }
 
 uint32_t VkDeviceInstance::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
+{
+    uint32_t typeIndex = 0;
+    if (!TryFindMemoryType(typeFilter, properties, typeIndex))
+    {
+        LOG_WARN("Vk Instance: Failed to find suitable memory type !!");
+    }
+
+    // @todo Need default fallback here
+    return typeIndex;
+}
+
+bool VkDeviceInstance::TryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties, uint32_t& typeIndex)
 {
     VkPhysicalDeviceMemoryProperties memProperties;
     vkGetPhysicalDeviceMemoryProperties(physicalDevice_, &memProperties);
@@ -461,23 +821,24 @@ uint32_t VkDeviceInstance::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyF
     {
         if ((typeFilter & (1 << i)) && ((memProperties.memoryTypes[i].propertyFlags & properties) == properties))
         {
-            return i;
+            typeIndex = i;
+            return true;
         }
     }
 
-    LOG_WARN("Vk Instance: Failed to find suitable memory type !!");
-
-    // @todo Need default fallback here
+    return false;
 }
 
 //----------------------------------------------------------------------------//
 
-void VkDeviceInstance::CreateBuffer(
+VkMemoryPropertyFlags VkDeviceInstance::CreateBuffer(
     VkDeviceSize devSize,
     VkBufferUsageFlags usage,
     VkMemoryPropertyFlags properties,
     VkBuffer& buffer,
-    VkDeviceMemory& bufferMem)
+    VkDeviceMemory& bufferMem,
+    MemoryCategory category,
+    VkMemoryPropertyFlags fallbackProperties)
 {
     VkBufferCreateInfo bufferInfo = {};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -486,7 +847,7 @@ void VkDeviceInstance::CreateBuffer(
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
     VK_CHECK(
-        vkCreateBuffer(logicalDevice_, &bufferInfo, nullptr, &buffer),
+        vkCreateBuffer(logicalDevice_, &bufferInfo, GetAllocator(), &buffer),
         "VK Instace: Failed to create vertex buffer !!"
     )
 
@@ -496,16 +857,21 @@ void VkDeviceInstance::CreateBuffer(
     VkMemoryAllocateInfo memAllocInfo = {};
     memAllocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     memAllocInfo.allocationSize = memRequirements.size;
-    memAllocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
+
+    VkMemoryPropertyFlags usedProperties = properties;
+    if (!TryFindMemoryType(memRequirements.memoryTypeBits, properties, memAllocInfo.memoryTypeIndex))
+    {
+        usedProperties = (fallbackProperties != 0) ? fallbackProperties : properties;
+        memAllocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, usedProperties);
+    }
 
     VK_CHECK(
-        vkAllocateMemory(logicalDevice_, &memAllocInfo, nullptr, &bufferMem),
+        AllocateMemory(memAllocInfo, category, bufferMem),
         "VK Instace: Failed to allocate vertex buffer memory !!"
     )
 
-    
-
     vkBindBufferMemory(logicalDevice_, buffer, bufferMem, 0);
+    return usedProperties;
 }
     
 VkCommandBuffer VkDeviceInstance::BeginSingleTimeCommands()
@@ -531,75 +897,35 @@ void VkDeviceInstance::EndSingleTimeCommands(VkCommandBuffer cmdBuffer)
 {
     vkEndCommandBuffer(cmdBuffer);
 
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmdBuffer;
-
-    vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(graphicsQueue_);
+    // Waits for this submit only, not for the frames already queued.
+    uint64_t value = graphicsTimeline_->Submit(&cmdBuffer, 1);
+    graphicsTimeline_->Wait(value);
 
     vkFreeCommandBuffers(logicalDevice_, commandPool_, 1, &cmdBuffer);
 }
 
 //----------------------------------------------------------------------------//
 
-void VkDeviceInstance::CopyBuffer(
+TransferTicket VkDeviceInstance::CopyBuffer(
     VkBuffer srcBuffer,
     VkBuffer dstBuffer,
     VkDeviceSize devSize)
 {
-    VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
-
-    VkBufferCopy copyRegion{};
-    copyRegion.srcOffset = 0;  // Optional
-    copyRegion.dstOffset = 0;  // Optional
-    copyRegion.size = devSize;
-    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
-
-    EndSingleTimeCommands(commandBuffer);
+    return transferQueueInst_->CopyBuffer(
+        srcBuffer, dstBuffer, devSize,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_READ_BIT);
 }
 
-void VkDeviceInstance::CopyBufferToImage(
-    VkBuffer buffer,
-    VkImage image,
-    uint32_t width,
-    uint32_t height,
-    uint32_t layerCount)
-{
-    VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
-
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = layerCount;
-
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {width, height, 1};
-
-    vkCmdCopyBufferToImage(
-        commandBuffer,
-        buffer,
-        image,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        1,
-        &region);
-    EndSingleTimeCommands(commandBuffer);
-}
-
-void VkDeviceInstance::CreateImageWithInfo(
+VkMemoryPropertyFlags VkDeviceInstance::CreateImageWithInfo(
     const VkImageCreateInfo& imageInfo,
     VkMemoryPropertyFlags properties,
     VkImage& image,
-    VkDeviceMemory& imageMem)
+    VkDeviceMemory& imageMem,
+    MemoryCategory category,
+    VkMemoryPropertyFlags fallbackProperties)
 {
     VK_CHECK(
-        vkCreateImage(logicalDevice_, &imageInfo, nullptr, &image),
+        vkCreateImage(logicalDevice_, &imageInfo, GetAllocator(), &image),
         "Failed to create image!"
     )
     
@@ -609,10 +935,16 @@ void VkDeviceInstance::CreateImageWithInfo(
     VkMemoryAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
+
+    VkMemoryPropertyFlags usedProperties = properties;
+    if (!TryFindMemoryType(memRequirements.memoryTypeBits, properties, allocInfo.memoryTypeIndex))
+    {
+        usedProperties = (fallbackProperties != 0) ? fallbackProperties : properties;
+        allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, usedProperties);
+    }
 
     VK_CHECK(
-        vkAllocateMemory(logicalDevice_, &allocInfo, nullptr, &imageMem),
+        AllocateMemory(allocInfo, category, imageMem),
         "Failed to allocate image memory!"
     )
 
@@ -620,6 +952,36 @@ void VkDeviceInstance::CreateImageWithInfo(
         vkBindImageMemory(logicalDevice_, image, imageMem, 0),
         "Failed to bind image memory!"
     )
+
+    return usedProperties;
+}
+
+VkResult VkDeviceInstance::AllocateMemory(
+    const VkMemoryAllocateInfo& allocInfo,
+    MemoryCategory category,
+    VkDeviceMemory& memory)
+{
+    VkResult result = vkAllocateMemory(logicalDevice_, &allocInfo, GetAllocator(), &memory);
+    if (result == VK_SUCCESS)
+    {
+        memoryStats_.TrackAllocation(memory, allocInfo.allocationSize, allocInfo.memoryTypeIndex, category);
+    }
+    else
+    {
+        LOG_WARN("VK Instance: {} KiB {} allocation failed", allocInfo.allocationSize / 1024,
+            GetMemoryCategoryName(category));
+        memoryStats_.LogStats();
+    }
+
+    return result;
+}
+
+void VkDeviceInstance::FreeMemory(VkDeviceMemory memory)
+{
+    if (memory == VK_NULL_HANDLE) { return; }
+
+    memoryStats_.TrackFree(memory);
+    vkFreeMemory(logicalDevice_, memory, GetAllocator());
 }
 
 } // namespace Graphic
\ No newline at end of file
@@ -0,0 +1,333 @@
+#include <Graphics/Vulkan/VkMemoryStatsImpl.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace Graphic
+{
+
+// Stored right before every host allocation handed to the driver, Vulkan frees and
+// reallocates without giving the size back.
+struct HostAllocationHeader
+{
+    void* base = nullptr;
+    size_t size = 0;
+    size_t scope = 0;
+};
+
+// Keeps the header itself aligned when it sits right before an aligned pointer.
+constexpr size_t HOST_HEADER_SIZE =
+    ((sizeof(HostAllocationHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t)) *
+    alignof(std::max_align_t);
+
+// Heaps above this share of their budget get a warning in the periodic log.
+constexpr double BUDGET_WARNING_RATIO = 0.9;
+
+constexpr VkDeviceSize MIB = 1024 * 1024;
+
+const char* GetMemoryCategoryName(MemoryCategory category)
+{
+    switch (category)
+    {
+        case MemoryCategory::Geometry: return "geometry";
+        case MemoryCategory::Uniform: return "uniform";
+        case MemoryCategory::Staging: return "staging";
+        case MemoryCategory::Readback: return "readback";
+        case MemoryCategory::Texture: return "texture";
+        case MemoryCategory::RenderTarget: return "render target";
+        case MemoryCategory::Transient: return "transient";
+        default: return "unknown";
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+MemoryStats::MemoryStats()
+{
+    hostCallbacks_.pUserData = this;
+    hostCallbacks_.pfnAllocation = &MemoryStats::HostAllocate;
+    hostCallbacks_.pfnReallocation = &MemoryStats::HostReallocate;
+    hostCallbacks_.pfnFree = &MemoryStats::HostFree;
+    hostCallbacks_.pfnInternalAllocation = &MemoryStats::HostInternalAllocation;
+    hostCallbacks_.pfnInternalFree = &MemoryStats::HostInternalFree;
+}
+
+void MemoryStats::Init(VkPhysicalDevice physicalDevice, bool budgetExt)
+{
+    VkPhysicalDeviceMemoryProperties memProperties = {};
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    physicalDevice_ = physicalDevice;
+    budgetExt_ = budgetExt;
+
+    heaps_.assign(memProperties.memoryHeapCount, {});
+    for (uint32_t i = 0; i < memProperties.memoryHeapCount; ++i)
+    {
+        heaps_[i].size = memProperties.memoryHeaps[i].size;
+        heaps_[i].budget = memProperties.memoryHeaps[i].size;
+        heaps_[i].deviceLocal = (memProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    }
+
+    typeToHeap_.assign(memProperties.memoryTypeCount, 0);
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; ++i)
+    {
+        typeToHeap_[i] = memProperties.memoryTypes[i].heapIndex;
+    }
+
+    LOG_INFO("Memory Stats: {} heaps, budget {}", heaps_.size(), budgetExt_ ? "VK_EXT_memory_budget" : "heap size");
+}
+
+//----------------------------------------------------------------------------//
+
+void MemoryStats::TrackAllocation(
+    VkDeviceMemory memory,
+    VkDeviceSize size,
+    uint32_t memoryTypeIndex,
+    MemoryCategory category)
+{
+    if (memory == VK_NULL_HANDLE) { return; }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Allocation allocation = {};
+    allocation.size = size;
+    allocation.heapIndex = (memoryTypeIndex < typeToHeap_.size()) ? typeToHeap_[memoryTypeIndex] : 0;
+    allocation.category = category;
+    allocations_[memory] = allocation;
+
+    MemoryCategoryStats& stats = categories_[static_cast<size_t>(category)];
+    stats.bytes += size;
+    stats.peakBytes = std::max(stats.peakBytes, stats.bytes);
+    stats.allocations++;
+
+    if (allocation.heapIndex < heaps_.size())
+    {
+        heaps_[allocation.heapIndex].allocated += size;
+    }
+}
+
+void MemoryStats::TrackFree(VkDeviceMemory memory)
+{
+    if (memory == VK_NULL_HANDLE) { return; }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = allocations_.find(memory);
+    if (it == allocations_.end()) { return; }
+
+    MemoryCategoryStats& stats = categories_[static_cast<size_t>(it->second.category)];
+    stats.bytes -= it->second.size;
+    stats.allocations--;
+
+    if (it->second.heapIndex < heaps_.size())
+    {
+        heaps_[it->second.heapIndex].allocated -= it->second.size;
+    }
+
+    allocations_.erase(it);
+}
+
+//----------------------------------------------------------------------------//
+
+void MemoryStats::Tick()
+{
+    UpdateBudgets();
+
+    tickCount_++;
+    if ((MEMORY_STATS_LOG_INTERVAL > 0) && ((tickCount_ % MEMORY_STATS_LOG_INTERVAL) == 0))
+    {
+        LogStats();
+    }
+}
+
+void MemoryStats::UpdateBudgets()
+{
+    if (physicalDevice_ == VK_NULL_HANDLE) { return; }
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties = {};
+    budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    if (budgetExt_)
+    {
+        VkPhysicalDeviceMemoryProperties2 memProperties = {};
+        memProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memProperties.pNext = &budgetProperties;
+        vkGetPhysicalDeviceMemoryProperties2(physicalDevice_, &memProperties);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < heaps_.size(); ++i)
+    {
+        // Without the extension the tracked allocations are the best usage estimate.
+        heaps_[i].budget = budgetExt_ ? budgetProperties.heapBudget[i] : heaps_[i].size;
+        heaps_[i].usage = budgetExt_ ? budgetProperties.heapUsage[i] : heaps_[i].allocated;
+    }
+}
+
+void MemoryStats::LogStats() const
+{
+    std::vector<MemoryHeapStats> heaps = GetHeapStats();
+    for (size_t i = 0; i < heaps.size(); ++i)
+    {
+        LOG_INFO("Memory Stats: Heap {}{} usage {} / {} MiB, tracked {} MiB, size {} MiB",
+            i, heaps[i].deviceLocal ? " (device local)" : "",
+            heaps[i].usage / MIB, heaps[i].budget / MIB, heaps[i].allocated / MIB, heaps[i].size / MIB);
+
+        if (static_cast<double>(heaps[i].usage) > (static_cast<double>(heaps[i].budget) * BUDGET_WARNING_RATIO))
+        {
+            LOG_WARN("Memory Stats: Heap {} is above {}% of its budget", i,
+                static_cast<uint32_t>(BUDGET_WARNING_RATIO * 100.0));
+        }
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(MemoryCategory::Count); ++i)
+    {
+        MemoryCategoryStats stats = GetCategoryStats(static_cast<MemoryCategory>(i));
+        if (stats.peakBytes == 0) { continue; }
+
+        LOG_INFO("Memory Stats: {} -> {} allocations, {} KiB (peak {} KiB)",
+            GetMemoryCategoryName(static_cast<MemoryCategory>(i)),
+            stats.allocations, stats.bytes / 1024, stats.peakBytes / 1024);
+    }
+
+#if TRACK_HOST_ALLOCATIONS
+    HostMemoryStats host = GetHostStats();
+    LOG_INFO("Memory Stats: Host {} allocations, {} KiB (peak {} KiB), internal {} KiB, {} allocations total",
+        host.allocations, host.bytes / 1024, host.peakBytes / 1024, host.internalBytes / 1024,
+        host.totalAllocations);
+#endif
+}
+
+//----------------------------------------------------------------------------//
+
+std::vector<MemoryHeapStats> MemoryStats::GetHeapStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return heaps_;
+}
+
+MemoryCategoryStats MemoryStats::GetCategoryStats(MemoryCategory category) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return categories_[static_cast<size_t>(category)];
+}
+
+HostMemoryStats MemoryStats::GetHostStats() const
+{
+    HostMemoryStats stats = {};
+    stats.bytes = hostBytes_.load(std::memory_order_relaxed);
+    stats.peakBytes = hostPeakBytes_.load(std::memory_order_relaxed);
+    stats.internalBytes = hostInternalBytes_.load(std::memory_order_relaxed);
+    stats.allocations = hostAllocations_.load(std::memory_order_relaxed);
+    stats.totalAllocations = hostTotalAllocations_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < stats.scopeBytes.size(); ++i)
+    {
+        stats.scopeBytes[i] = hostScopeBytes_[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+//----------------------------------------------------------------------------//
+
+VKAPI_ATTR void* VKAPI_CALL MemoryStats::HostAllocate(
+    void* userData,
+    size_t size,
+    size_t alignment,
+    VkSystemAllocationScope scope)
+{
+    if (size == 0) { return nullptr; }
+
+    MemoryStats* stats = static_cast<MemoryStats*>(userData);
+    alignment = std::max(alignment, alignof(std::max_align_t));
+
+    void* base = std::malloc(size + alignment + HOST_HEADER_SIZE);
+    if (base == nullptr) { return nullptr; }
+
+    uintptr_t address = reinterpret_cast<uintptr_t>(base) + HOST_HEADER_SIZE;
+    address = (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+
+    HostAllocationHeader* header = reinterpret_cast<HostAllocationHeader*>(address - HOST_HEADER_SIZE);
+    header->base = base;
+    header->size = size;
+    header->scope = std::min<size_t>(static_cast<size_t>(scope), stats->hostScopeBytes_.size() - 1);
+
+    size_t bytes = stats->hostBytes_.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = stats->hostPeakBytes_.load(std::memory_order_relaxed);
+    while ((bytes > peak) && !stats->hostPeakBytes_.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {}
+
+    stats->hostScopeBytes_[header->scope].fetch_add(size, std::memory_order_relaxed);
+    stats->hostAllocations_.fetch_add(1, std::memory_order_relaxed);
+    stats->hostTotalAllocations_.fetch_add(1, std::memory_order_relaxed);
+
+    return reinterpret_cast<void*>(address);
+}
+
+VKAPI_ATTR void* VKAPI_CALL MemoryStats::HostReallocate(
+    void* userData,
+    void* original,
+    size_t size,
+    size_t alignment,
+    VkSystemAllocationScope scope)
+{
+    if (original == nullptr) { return HostAllocate(userData, size, alignment, scope); }
+
+    if (size == 0)
+    {
+        HostFree(userData, original);
+        return nullptr;
+    }
+
+    // Alignment must stay the same across reallocations, a fresh block keeps it simple.
+    void* memory = HostAllocate(userData, size, alignment, scope);
+    if (memory == nullptr) { return nullptr; }
+
+    const HostAllocationHeader* header = reinterpret_cast<const HostAllocationHeader*>(
+        static_cast<char*>(original) - HOST_HEADER_SIZE);
+    std::memcpy(memory, original, std::min(size, header->size));
+
+    HostFree(userData, original);
+    return memory;
+}
+
+VKAPI_ATTR void VKAPI_CALL MemoryStats::HostFree(void* userData, void* memory)
+{
+    if (memory == nullptr) { return; }
+
+    MemoryStats* stats = static_cast<MemoryStats*>(userData);
+    HostAllocationHeader* header = reinterpret_cast<HostAllocationHeader*>(
+        static_cast<char*>(memory) - HOST_HEADER_SIZE);
+
+    stats->hostBytes_.fetch_sub(header->size, std::memory_order_relaxed);
+    stats->hostScopeBytes_[header->scope].fetch_sub(header->size, std::memory_order_relaxed);
+    stats->hostAllocations_.fetch_sub(1, std::memory_order_relaxed);
+
+    std::free(header->base);
+}
+
+VKAPI_ATTR void VKAPI_CALL MemoryStats::HostInternalAllocation(
+    void* userData,
+    size_t size,
+    VkInternalAllocationType,
+    VkSystemAllocationScope)
+{
+    static_cast<MemoryStats*>(userData)->hostInternalBytes_.fetch_add(size, std::memory_order_relaxed);
+}
+
+VKAPI_ATTR void VKAPI_CALL MemoryStats::HostInternalFree(
+    void* userData,
+    size_t size,
+    VkInternalAllocationType,
+    VkSystemAllocationScope)
+{
+    static_cast<MemoryStats*>(userData)->hostInternalBytes_.fetch_sub(size, std::memory_order_relaxed);
+}
+
+} // namespace Graphic
@@ -0,0 +1,101 @@
+#include <Graphics/Vulkan/VkPipelineBuilderImpl.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Core/ThreadPool.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+
+namespace Graphic
+{
+
+AsyncPipelineBuilder::AsyncPipelineBuilder(VkDeviceInstance* deviceInst, uint32_t threadCount)
+    : deviceInst_(deviceInst), threadPool_(threadCount)
+{
+    LOG_INFO("Pipeline Builder: Started with {} worker(s)", threadPool_.GetThreadCount());
+}
+
+AsyncPipelineBuilder::~AsyncPipelineBuilder()
+{
+    WaitIdle();
+    deviceInst_ = nullptr;
+}
+
+PipelineHandle AsyncPipelineBuilder::Submit(const GraphicPipelineDesc& desc)
+{
+    PendingRequest request;
+    request.desc = desc;
+    PipelineFuture future = request.promise.get_future().share();
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.push_back(std::move(request));
+    }
+
+    // Each submit schedules one drain job. Jobs that wake up after an earlier job
+    // already took their request simply find the queue empty.
+    threadPool_.Enqueue([this]() { CompilePendingBatch(); });
+
+    return PipelineHandle(std::move(future));
+}
+
+PipelineHandle AsyncPipelineBuilder::Submit(
+    const std::string& vertFilePath,
+    const std::string& fragFilePath,
+    const PipelineConfigInfo& configInfo)
+{
+    GraphicPipelineDesc desc;
+    desc.vertFilePath = vertFilePath;
+    desc.fragFilePath = fragFilePath;
+    desc.configInfo = configInfo;
+    return Submit(desc);
+}
+
+void AsyncPipelineBuilder::WaitIdle()
+{
+    threadPool_.WaitIdle();
+}
+
+void AsyncPipelineBuilder::CompilePendingBatch()
+{
+    std::vector<PendingRequest> batch;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        size_t batchSize = std::min<size_t>(pending_.size(), PIPELINE_BATCH_SIZE);
+
+        batch.reserve(batchSize);
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            batch.push_back(std::move(pending_[i]));
+        }
+        pending_.erase(pending_.begin(), pending_.begin() + batchSize);
+    }
+
+    if (batch.empty()) { return; }
+
+    std::vector<GraphicPipelineDesc> descs;
+    descs.reserve(batch.size());
+    for (auto& request : batch)
+    {
+        descs.push_back(request.desc);
+    }
+
+    auto pipelines = GraphicPipeline::CreateBatch(deviceInst_, descs);
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        if (pipelines[i] == nullptr)
+        {
+            LOG_ERROR("Pipeline Builder: Failed to compile {} / {}",
+                      batch[i].desc.vertFilePath, batch[i].desc.fragFilePath);
+        }
+        batch[i].promise.set_value(std::shared_ptr<GraphicPipeline>(std::move(pipelines[i])));
+    }
+
+    LOG_INFO("Pipeline Builder: Compiled batch of {} pipeline(s)", batch.size());
+}
+
+} // namespace Graphic
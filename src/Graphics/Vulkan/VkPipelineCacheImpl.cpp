@@ -0,0 +1,254 @@
+#include <Graphics/Vulkan/VkPipelineCacheImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Core/Hash.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Graphic
+{
+
+PipelineCacheInstance::PipelineCacheInstance(
+    VkDevice device, const VkAllocationCallbacks* allocator, const VkPhysicalDeviceProperties& properties)
+    : device_(device), allocator_(allocator), properties_(properties)
+{
+    cacheFilePath_ = BuildCacheFilePath();
+
+    std::vector<char> fileData = LoadCacheFile();
+    bool cacheValid = IsCacheDataValid(fileData);
+
+    VkPipelineCacheCreateInfo cacheInfo = {};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.pNext = nullptr;
+    cacheInfo.flags = 0;
+
+    if (cacheValid)
+    {
+        cacheInfo.initialDataSize = fileData.size() - sizeof(PipelineCacheFileHeader);
+        cacheInfo.pInitialData = fileData.data() + sizeof(PipelineCacheFileHeader);
+        loadedDataHash_ = reinterpret_cast<const PipelineCacheFileHeader*>(fileData.data())->dataHash;
+        LOG_INFO("Pipeline Cache: Loaded {} bytes from {}", cacheInfo.initialDataSize, cacheFilePath_);
+    }
+    else
+    {
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+    }
+
+    if (vkCreatePipelineCache(device_, &cacheInfo, allocator_, &pipelineCache_) != VK_SUCCESS)
+    {
+        // Driver refused the blob, start from an empty cache instead.
+        LOG_WARN("Pipeline Cache: Driver rejected cache data, starting empty");
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+        loadedDataHash_ = 0;
+
+        VK_CHECK(
+            vkCreatePipelineCache(device_, &cacheInfo, allocator_, &pipelineCache_),
+            "Pipeline Cache: Failed to create pipeline cache !!"
+        )
+    }
+}
+
+PipelineCacheInstance::~PipelineCacheInstance()
+{
+    if (pipelineCache_ != VK_NULL_HANDLE)
+    {
+        Save();
+        vkDestroyPipelineCache(device_, pipelineCache_, allocator_);
+        pipelineCache_ = VK_NULL_HANDLE;
+        LOG_INFO("Pipeline Cache: Terminated !!");
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+std::string PipelineCacheInstance::BuildCacheFilePath() const
+{
+    // Cache blobs are only valid for the exact device and driver that produced them,
+    // so all identifying fields are part of the file name.
+    std::ostringstream fileName;
+    fileName << std::hex << std::setfill('0')
+             << "pipeline_"
+             << std::setw(4) << properties_.vendorID << "_"
+             << std::setw(4) << properties_.deviceID << "_"
+             << std::setw(8) << properties_.driverVersion << "_";
+
+    for (uint32_t i = 0; i < VK_UUID_SIZE; ++i)
+    {
+        fileName << std::setw(2) << static_cast<uint32_t>(properties_.pipelineCacheUUID[i]);
+    }
+    fileName << ".bin";
+
+    // Note : PROJECT_DIRECTORY macro is added by CMakeList.txt
+    return (std::string)PROJECT_DIRECTORY + PIPELINE_CACHE_DIR + fileName.str();
+}
+
+std::vector<char> PipelineCacheInstance::LoadCacheFile() const
+{
+    std::ifstream file(cacheFilePath_, std::ios::ate | std::ios::binary);
+
+    if (!file.is_open())
+    {
+        LOG_INFO("Pipeline Cache: No cache file found, pipelines will be compiled");
+        return {};
+    }
+
+    size_t fileSize = static_cast<size_t>(file.tellg());
+    std::vector<char> buffer(fileSize);
+
+    file.seekg(0);
+    file.read(buffer.data(), fileSize);
+
+    if (!file)
+    {
+        LOG_WARN("Pipeline Cache: Failed to read {}", cacheFilePath_);
+        return {};
+    }
+
+    return buffer;
+}
+
+bool PipelineCacheInstance::IsCacheDataValid(const std::vector<char>& fileData) const
+{
+    if (fileData.size() < sizeof(PipelineCacheFileHeader) + sizeof(VkPipelineCacheHeaderVersionOne))
+    {
+        return false;
+    }
+
+    PipelineCacheFileHeader header = {};
+    memcpy(&header, fileData.data(), sizeof(header));
+
+    const char* cacheData = fileData.data() + sizeof(header);
+    const size_t cacheSize = fileData.size() - sizeof(header);
+
+    if ((header.magic != PIPELINE_CACHE_FILE_MAGIC) || (header.version != PIPELINE_CACHE_FILE_VERSION))
+    {
+        LOG_WARN("Pipeline Cache: Unknown file format, ignoring cache");
+        return false;
+    }
+
+    if ((header.vendorID != properties_.vendorID) ||
+        (header.deviceID != properties_.deviceID) ||
+        (header.driverVersion != properties_.driverVersion) ||
+        (memcmp(header.pipelineCacheUUID, properties_.pipelineCacheUUID, VK_UUID_SIZE) != 0))
+    {
+        LOG_WARN("Pipeline Cache: Cache was built for another device/driver, ignoring cache");
+        return false;
+    }
+
+    if ((header.dataSize != cacheSize) || (header.dataHash != Core::HashFnv1a(cacheData, cacheSize)))
+    {
+        LOG_WARN("Pipeline Cache: Cache file is truncated or corrupted, ignoring cache");
+        return false;
+    }
+
+    // The driver blob carries its own header, double check it against the device.
+    VkPipelineCacheHeaderVersionOne driverHeader = {};
+    memcpy(&driverHeader, cacheData, sizeof(driverHeader));
+
+    if ((driverHeader.headerSize < sizeof(driverHeader)) ||
+        (driverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) ||
+        (driverHeader.vendorID != properties_.vendorID) ||
+        (driverHeader.deviceID != properties_.deviceID) ||
+        (memcmp(driverHeader.pipelineCacheUUID, properties_.pipelineCacheUUID, VK_UUID_SIZE) != 0))
+    {
+        LOG_WARN("Pipeline Cache: Driver header mismatch, ignoring cache");
+        return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------//
+
+bool PipelineCacheInstance::Save()
+{
+    if (pipelineCache_ == VK_NULL_HANDLE) { return false; }
+
+    size_t dataSize = 0;
+    VK_CHECK(
+        vkGetPipelineCacheData(device_, pipelineCache_, &dataSize, nullptr),
+        "Pipeline Cache: Failed to query cache size !!"
+    )
+
+    if (dataSize == 0) { return false; }
+
+    std::vector<char> cacheData(dataSize);
+    if (vkGetPipelineCacheData(device_, pipelineCache_, &dataSize, cacheData.data()) != VK_SUCCESS)
+    {
+        LOG_WARN("Pipeline Cache: Failed to retrieve cache data");
+        return false;
+    }
+    cacheData.resize(dataSize);
+
+    // Nothing new was compiled since load, leave the file untouched.
+    if (Core::HashFnv1a(cacheData.data(), cacheData.size()) == loadedDataHash_)
+    {
+        return true;
+    }
+
+    return WriteCacheFile(cacheData);
+}
+
+bool PipelineCacheInstance::WriteCacheFile(const std::vector<char>& cacheData) const
+{
+    namespace fs = std::filesystem;
+
+    std::error_code errCode;
+    fs::create_directories(fs::path(cacheFilePath_).parent_path(), errCode);
+
+    PipelineCacheFileHeader header = {};
+    header.magic = PIPELINE_CACHE_FILE_MAGIC;
+    header.version = PIPELINE_CACHE_FILE_VERSION;
+    header.vendorID = properties_.vendorID;
+    header.deviceID = properties_.deviceID;
+    header.driverVersion = properties_.driverVersion;
+    memcpy(header.pipelineCacheUUID, properties_.pipelineCacheUUID, VK_UUID_SIZE);
+    header.dataSize = cacheData.size();
+    header.dataHash = Core::HashFnv1a(cacheData.data(), cacheData.size());
+
+    // Write into a temporary file first and swap it in, so a crash mid-write
+    // never leaves a half written cache behind.
+    const std::string tempPath = cacheFilePath_ + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            LOG_WARN("Pipeline Cache: Unable to open {} for writing", tempPath);
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(cacheData.data(), cacheData.size());
+        file.flush();
+
+        if (!file)
+        {
+            LOG_WARN("Pipeline Cache: Failed to write {}", tempPath);
+            file.close();
+            fs::remove(tempPath, errCode);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, cacheFilePath_, errCode);
+    if (errCode)
+    {
+        LOG_WARN("Pipeline Cache: Failed to replace cache file : {}", errCode.message());
+        fs::remove(tempPath, errCode);
+        return false;
+    }
+
+    LOG_INFO("Pipeline Cache: Saved {} bytes to {}", cacheData.size(), cacheFilePath_);
+    return true;
+}
+
+} // namespace Graphic
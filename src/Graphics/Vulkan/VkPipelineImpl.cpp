@@ -1,127 +1,276 @@
 #include <Graphics/Vulkan/VkPipelineImpl.ipp>
 #include <Graphics/Vulkan/VkUtil.ipp>
 #include <Graphics/VkModel.ipp>
-
-// STD Lib
-#include <fstream>
+#include <Core/VirtualFileSystem.ipp>
 
 // External Lib
 #include <Logging.hpp>
 
 namespace Graphic
 {
-    
+
+// Create info and everything it points to, kept together so the pointers stay valid
+// until vkCreateGraphicsPipelines returns. Must not be moved once prepared.
+struct PipelineCreateState
+{
+    VkShaderModule vertShaderModule = VK_NULL_HANDLE;
+    VkShaderModule fragShaderModule = VK_NULL_HANDLE;
+    VkPipelineShaderStageCreateInfo shaderStages[2] = {};
+    VkSpecializationInfo specializationInfo = {};
+
+    std::vector<VkVertexInputBindingDescription> bindingDesc;
+    std::vector<VkVertexInputAttributeDescription> attributeDesc;
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
+
+    // Local copies so the config's self references do not dangle after a copy
+    VkPipelineColorBlendStateCreateInfo colorBlendInfo = {};
+    VkPipelineDynamicStateCreateInfo dynamicStateInfo = {};
+
+    // Attachment formats, only chained when there is no render pass
+    VkPipelineRenderingCreateInfo renderingInfo = {};
+
+    VkGraphicsPipelineCreateInfo pipelineInfo = {};
+};
+
+//----------------------------------------------------------------------------//
+
 GraphicPipeline::GraphicPipeline(
     VkDeviceInstance* instance,
     const std::string& vertFilePath,
     const std::string& fragFilePath,
-    const PipelineConfigInfo& configInfo) : device_(instance->GetLogicalDevice())
+    const PipelineConfigInfo& configInfo)
+    : device_(instance->GetLogicalDevice()), allocator_(instance->GetAllocator()),
+      pipelineCache_(instance->GetPipelineCache())
+{
+    CreateGraphicsPipeline(vertFilePath, fragFilePath, configInfo);
+}
+
+GraphicPipeline::GraphicPipeline(VkDevice device, const VkAllocationCallbacks* allocator, VkPipeline pipeline)
+    : device_(device), allocator_(allocator), renderPipeline_(pipeline)
 {
-    // Note : PROJECT_DIRECTORY macro is added by CMakeList.txt
-    auto const vertPath = (std::string)PROJECT_DIRECTORY + vertFilePath;
-    auto const fragPath = (std::string)PROJECT_DIRECTORY + fragFilePath; 
-    CreateGraphicsPipeline(vertPath, fragPath, configInfo);
 }
 
 GraphicPipeline::~GraphicPipeline()
 {
-    vkDestroyShaderModule(device_, vertShaderModule_, nullptr);
-    vkDestroyShaderModule(device_, fragShaderModule_, nullptr);
-    vkDestroyPipeline(device_, renderPipeline_, nullptr);
+    vkDestroyShaderModule(device_, vertShaderModule_, allocator_);
+    vkDestroyShaderModule(device_, fragShaderModule_, allocator_);
+    vkDestroyPipeline(device_, renderPipeline_, allocator_);
     device_ = VK_NULL_HANDLE;
 }
 
 std::vector<char> GraphicPipeline::ReadFile(const std::string& filePath)
 {
-    std::ifstream file(filePath, std::ios::ate | std::ios::binary);
-
-    if (!file.is_open())
+    std::vector<char> buffer;
+    if (!Core::VirtualFileSystem::Get().ReadFile(filePath, buffer))
     {
         LOG_WARN("Failed to load shader binary : {}",filePath);
+        return {};
     }
-
-    // Initialize buffer for the binary.
-    size_t fileSize = static_cast<size_t>(file.tellg());
-    std::vector<char> buffer(fileSize);
-
-    file.seekg(0); // Reset reader to first char
-    file.read(buffer.data(), fileSize);
-
-    file.close();
     return buffer;
 }
 
-void GraphicPipeline::CreateGraphicsPipeline(const std::string& vertFilePath, const std::string& fragFilePath, const PipelineConfigInfo& configInfo)
+static void PreparePipelineCreateState(
+    VkShaderModule vertShaderModule,
+    VkShaderModule fragShaderModule,
+    const PipelineConfigInfo& configInfo,
+    PipelineCreateState& state)
 {
-    auto vertBin = ReadFile(vertFilePath);
-    auto fragBin = ReadFile(fragFilePath);
+    state.vertShaderModule = vertShaderModule;
+    state.fragShaderModule = fragShaderModule;
 
-    CreateShaderModule(vertBin, &vertShaderModule_);
-    CreateShaderModule(fragBin, &fragShaderModule_);
-
-    VkPipelineShaderStageCreateInfo shaderStages[2];
-    shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-    shaderStages[0].module = vertShaderModule_;
-    shaderStages[0].pName = "main";
-    shaderStages[0].flags = 0;
-    shaderStages[0].pNext = nullptr;
-    shaderStages[0].pSpecializationInfo = nullptr;
-    shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    shaderStages[1].module = fragShaderModule_;
-    shaderStages[1].pName = "main";
-    shaderStages[1].flags = 0;
-    shaderStages[1].pNext = nullptr;
-    shaderStages[1].pSpecializationInfo = nullptr;
-
-    auto bindingDesc = Vertex::GetBindingDescriptions();
-    auto attributeDesc = Vertex::GetAttributeDescriptions();
-    VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
-    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDesc.size());
-    vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDesc.size());
-    vertexInputInfo.pVertexAttributeDescriptions = attributeDesc.data();
-    vertexInputInfo.pVertexBindingDescriptions = bindingDesc.data();
+    state.shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    state.shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    state.shaderStages[0].module = vertShaderModule;
+    state.shaderStages[0].pName = "main";
+    state.shaderStages[0].flags = 0;
+    state.shaderStages[0].pNext = nullptr;
+    state.shaderStages[0].pSpecializationInfo = nullptr;
+    state.shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    state.shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    state.shaderStages[1].module = fragShaderModule;
+    state.shaderStages[1].pName = "main";
+    state.shaderStages[1].flags = 0;
+    state.shaderStages[1].pNext = nullptr;
+    state.shaderStages[1].pSpecializationInfo = nullptr;
 
-    VkGraphicsPipelineCreateInfo pipelineInfo = {};
+    if (!configInfo.specializationEntries.empty())
+    {
+        state.specializationInfo.mapEntryCount = static_cast<uint32_t>(configInfo.specializationEntries.size());
+        state.specializationInfo.pMapEntries = configInfo.specializationEntries.data();
+        state.specializationInfo.dataSize = configInfo.specializationData.size();
+        state.specializationInfo.pData = configInfo.specializationData.data();
+
+        state.shaderStages[0].pSpecializationInfo = &state.specializationInfo;
+        state.shaderStages[1].pSpecializationInfo = &state.specializationInfo;
+    }
+
+    state.bindingDesc = Vertex::GetBindingDescriptions();
+    state.attributeDesc = Vertex::GetAttributeDescriptions();
+    state.vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    state.vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(state.attributeDesc.size());
+    state.vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(state.bindingDesc.size());
+    state.vertexInputInfo.pVertexAttributeDescriptions = state.attributeDesc.data();
+    state.vertexInputInfo.pVertexBindingDescriptions = state.bindingDesc.data();
+
+    state.colorBlendInfo = configInfo.colorBlendInfo;
+    state.colorBlendInfo.pAttachments = &configInfo.colorBlendAttachment;
+
+    state.dynamicStateInfo = configInfo.dynamicStateInfo;
+    state.dynamicStateInfo.pDynamicStates = configInfo.dynamicStateEnable.data();
+    state.dynamicStateInfo.dynamicStateCount = static_cast<uint32_t>(configInfo.dynamicStateEnable.size());
+
+    VkGraphicsPipelineCreateInfo& pipelineInfo = state.pipelineInfo;
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     pipelineInfo.stageCount = 2;
-    pipelineInfo.pStages = shaderStages;
-    pipelineInfo.pVertexInputState = &vertexInputInfo;
+    pipelineInfo.pStages = state.shaderStages;
+    pipelineInfo.pVertexInputState = &state.vertexInputInfo;
     pipelineInfo.pInputAssemblyState = &configInfo.inputAssemblyInfo;
     pipelineInfo.pViewportState = &configInfo.viewportInfo;
     pipelineInfo.pRasterizationState = &configInfo.rasterizationInfo;
     pipelineInfo.pMultisampleState = &configInfo.multisampleInfo;
-    pipelineInfo.pColorBlendState = &configInfo.colorBlendInfo;
+    pipelineInfo.pColorBlendState = &state.colorBlendInfo;
     pipelineInfo.pDepthStencilState = &configInfo.depthStencilInfo;
-    pipelineInfo.pDynamicState = &configInfo.dynamicStateInfo;
+    pipelineInfo.pDynamicState = &state.dynamicStateInfo;
 
     pipelineInfo.layout = configInfo.pipelineLayout;
-    pipelineInfo.renderPass = configInfo.renderPass;
+    pipelineInfo.renderPass = configInfo.renderTarget.renderPass;
     pipelineInfo.subpass = configInfo.subpass;
 
+    if (configInfo.renderTarget.renderPass == VK_NULL_HANDLE)
+    {
+        const RenderTargetInfo& target = configInfo.renderTarget;
+        state.renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        state.renderingInfo.colorAttachmentCount = 1;
+        state.renderingInfo.pColorAttachmentFormats = &target.colorFormat;
+        state.renderingInfo.depthAttachmentFormat = target.depthFormat;
+        state.renderingInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+        pipelineInfo.pNext = &state.renderingInfo;
+        pipelineInfo.subpass = 0;
+    }
+
     pipelineInfo.basePipelineIndex = -1;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+}
+
+void GraphicPipeline::CreateGraphicsPipeline(const std::string& vertFilePath, const std::string& fragFilePath, const PipelineConfigInfo& configInfo)
+{
+    auto vertBin = ReadFile(vertFilePath);
+    auto fragBin = ReadFile(fragFilePath);
+
+    if (!CreateShaderModule(device_, allocator_, vertBin, &vertShaderModule_) ||
+        !CreateShaderModule(device_, allocator_, fragBin, &fragShaderModule_))
+    {
+        LOG_ERROR("Pipeline: Skipping {} / {}, shader modules unavailable", vertFilePath, fragFilePath);
+        return;
+    }
+
+    PipelineCreateState createState;
+    PreparePipelineCreateState(vertShaderModule_, fragShaderModule_, configInfo, createState);
 
     VK_CHECK(
-        vkCreateGraphicsPipelines(device_, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &renderPipeline_),
+        vkCreateGraphicsPipelines(device_, pipelineCache_, 1, &createState.pipelineInfo, allocator_, &renderPipeline_),
         "Pipeline: Unable to create Graphics Pipeline"
     )
 }
 
-void GraphicPipeline::CreateShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule)
+std::vector<std::unique_ptr<GraphicPipeline>> GraphicPipeline::CreateBatch(
+    VkDeviceInstance* instance,
+    const std::vector<GraphicPipelineDesc>& descs)
 {
+    VkDevice device = instance->GetLogicalDevice();
+    const VkAllocationCallbacks* allocator = instance->GetAllocator();
+    std::vector<std::unique_ptr<GraphicPipeline>> pipelines(descs.size());
+
+    if (descs.empty()) { return pipelines; }
+
+    // Allocated up front, the create infos point into these.
+    std::vector<PipelineCreateState> createStates(descs.size());
+    std::vector<VkGraphicsPipelineCreateInfo> pipelineInfos;
+    std::vector<size_t> descIndices; // pipelineInfos[i] belongs to descs[descIndices[i]]
+    pipelineInfos.reserve(descs.size());
+    descIndices.reserve(descs.size());
+
+    for (size_t i = 0; i < descs.size(); ++i)
+    {
+        auto vertBin = ReadFile(descs[i].vertFilePath);
+        auto fragBin = ReadFile(descs[i].fragFilePath);
+
+        // A single invalid create info would fail the whole call, so broken entries
+        // are left out and returned as nullptr.
+        VkShaderModule vertModule = VK_NULL_HANDLE;
+        VkShaderModule fragModule = VK_NULL_HANDLE;
+        if (!CreateShaderModule(device, allocator, vertBin, &vertModule) ||
+            !CreateShaderModule(device, allocator, fragBin, &fragModule))
+        {
+            LOG_ERROR("Pipeline: Skipping {} / {}, shader modules unavailable",
+                descs[i].vertFilePath, descs[i].fragFilePath);
+            vkDestroyShaderModule(device, vertModule, allocator);
+            vkDestroyShaderModule(device, fragModule, allocator);
+            continue;
+        }
+
+        PreparePipelineCreateState(vertModule, fragModule, descs[i].configInfo, createStates[i]);
+        pipelineInfos.push_back(createStates[i].pipelineInfo);
+        descIndices.push_back(i);
+    }
+
+    std::vector<VkPipeline> vkPipelines(pipelineInfos.size(), VK_NULL_HANDLE);
+    if (!pipelineInfos.empty())
+    {
+        VK_CHECK(
+            vkCreateGraphicsPipelines(
+                device,
+                instance->GetPipelineCache(),
+                static_cast<uint32_t>(pipelineInfos.size()),
+                pipelineInfos.data(),
+                allocator,
+                vkPipelines.data()),
+            "Pipeline: Unable to create Graphics Pipeline batch"
+        )
+    }
+
+    for (size_t i = 0; i < pipelineInfos.size(); ++i)
+    {
+        const PipelineCreateState& createState = createStates[descIndices[i]];
+
+        // Shader modules are no longer needed once the pipeline exists.
+        vkDestroyShaderModule(device, createState.vertShaderModule, allocator);
+        vkDestroyShaderModule(device, createState.fragShaderModule, allocator);
+
+        if (vkPipelines[i] != VK_NULL_HANDLE)
+        {
+            pipelines[descIndices[i]].reset(new GraphicPipeline(device, allocator, vkPipelines[i]));
+        }
+    }
+
+    return pipelines;
+}
+
+bool GraphicPipeline::CreateShaderModule(
+    VkDevice device,
+    const VkAllocationCallbacks* allocator,
+    const std::vector<char>& code,
+    VkShaderModule* shaderModule)
+{
+    // SPIR-V is a stream of 32 bit words, anything else is a missing or truncated file.
+    if (code.empty() || ((code.size() % sizeof(uint32_t)) != 0))
+    {
+        return false;
+    }
+
     VkShaderModuleCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
     createInfo.codeSize = code.size();
     createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
 
-    VK_CHECK(
-        vkCreateShaderModule(device_, &createInfo, nullptr, shaderModule),
-        "Pipeline: Failed to create shader module"
-    )
-    
+    VkResult result = vkCreateShaderModule(device, &createInfo, allocator, shaderModule);
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("Pipeline: Failed to create shader module ({})", static_cast<int>(result));
+        *shaderModule = VK_NULL_HANDLE;
+        return false;
+    }
+    return true;
 }
 
 void GraphicPipeline::DefaultPipelineConfigInfo(PipelineConfigInfo& configInfo) {
@@ -200,5 +349,51 @@ void GraphicPipeline::BindPipeline(VkCommandBuffer commandBuffer)
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, renderPipeline_);
 }
 
+//----------------------------------------------------------------------------//
+
+ComputePipeline::ComputePipeline(
+    VkDeviceInstance* instance,
+    const std::string& compFilePath,
+    VkPipelineLayout pipelineLayout)
+    : device_(instance->GetLogicalDevice()), allocator_(instance->GetAllocator())
+{
+    VkShaderModule compModule = VK_NULL_HANDLE;
+    if (!GraphicPipeline::CreateShaderModule(device_, allocator_, GraphicPipeline::ReadFile(compFilePath), &compModule))
+    {
+        LOG_ERROR("Pipeline: Skipping {}, shader module unavailable", compFilePath);
+        return;
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = compModule;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = pipelineLayout;
+    pipelineInfo.basePipelineIndex = -1;
+
+    VkResult result = vkCreateComputePipelines(
+        device_, instance->GetPipelineCache(), 1, &pipelineInfo, allocator_, &pipeline_);
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("Pipeline: Unable to create Compute Pipeline {}", compFilePath);
+        pipeline_ = VK_NULL_HANDLE;
+    }
+
+    // Not needed once the pipeline exists.
+    vkDestroyShaderModule(device_, compModule, allocator_);
+}
+
+ComputePipeline::~ComputePipeline()
+{
+    vkDestroyPipeline(device_, pipeline_, allocator_);
+}
+
+void ComputePipeline::BindPipeline(VkCommandBuffer commandBuffer)
+{
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_);
+}
+
 } // namespace Graphic
 
@@ -0,0 +1,103 @@
+#include <Graphics/Vulkan/VkPipelineVariantImpl.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <cstring>
+
+namespace Graphic
+{
+
+void ShaderPermutation::Apply(PipelineConfigInfo& configInfo) const
+{
+    const uint32_t constants[] = {
+        static_cast<uint32_t>(colorSource),
+        static_cast<uint32_t>(shapeMode),
+    };
+    const uint32_t constantIds[] = {
+        SHADER_CONST_COLOR_SOURCE,
+        SHADER_CONST_SHAPE_MODE,
+    };
+
+    configInfo.specializationEntries.clear();
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        VkSpecializationMapEntry entry = {};
+        entry.constantID = constantIds[i];
+        entry.offset = i * sizeof(uint32_t);
+        entry.size = sizeof(uint32_t);
+        configInfo.specializationEntries.push_back(entry);
+    }
+
+    configInfo.specializationData.resize(sizeof(constants));
+    memcpy(configInfo.specializationData.data(), constants, sizeof(constants));
+}
+
+//----------------------------------------------------------------------------//
+
+PipelineVariantCache::PipelineVariantCache(
+    VkDeviceInstance* deviceInst,
+    const std::string& vertFilePath,
+    const std::string& fragFilePath,
+    const PipelineConfigInfo& baseConfig,
+    AsyncPipelineBuilder* pipelineBuilder)
+    : deviceInst_(deviceInst), pipelineBuilder_(pipelineBuilder),
+      vertFilePath_(vertFilePath), fragFilePath_(fragFilePath), baseConfig_(baseConfig)
+{
+}
+
+PipelineVariantCache::~PipelineVariantCache()
+{
+    WaitIdle();
+}
+
+PipelineHandle PipelineVariantCache::GetOrCreate(const ShaderPermutation& permutation)
+{
+    const uint64_t key = permutation.GetKey();
+
+    std::lock_guard<std::mutex> lock(variantMutex_);
+
+    auto found = variants_.find(key);
+    if (found != variants_.end())
+    {
+        return found->second;
+    }
+
+    GraphicPipelineDesc desc;
+    desc.vertFilePath = vertFilePath_;
+    desc.fragFilePath = fragFilePath_;
+    desc.configInfo = baseConfig_;
+    permutation.Apply(desc.configInfo);
+
+    PipelineHandle handle;
+    if (pipelineBuilder_ != nullptr)
+    {
+        handle = pipelineBuilder_->Submit(desc);
+    }
+    else
+    {
+        auto pipelines = GraphicPipeline::CreateBatch(deviceInst_, {desc});
+
+        std::promise<std::shared_ptr<GraphicPipeline>> promise;
+        promise.set_value(std::shared_ptr<GraphicPipeline>(std::move(pipelines[0])));
+        handle = PipelineHandle(promise.get_future().share());
+    }
+
+    LOG_INFO("Pipeline Variant: Created variant {:#x} for {}", key, fragFilePath_);
+    variants_.emplace(key, handle);
+    return handle;
+}
+
+void PipelineVariantCache::WaitIdle()
+{
+    std::lock_guard<std::mutex> lock(variantMutex_);
+    for (auto& [key, handle] : variants_)
+    {
+        handle.Wait();
+    }
+}
+
+} // namespace Graphic
@@ -0,0 +1,246 @@
+#include <Graphics/Vulkan/VkPresentTimingImpl.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+
+namespace Graphic
+{
+
+// Longest a present or a swapchain recreation can wait for the helper thread. A wait
+// still returns as soon as the image is displayed, so this doesn't limit precision.
+constexpr uint64_t PRESENT_WAIT_SLICE_NS = 1000000;
+
+static double ElapsedMs(PresentClock::time_point from, PresentClock::time_point to)
+{
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+PresentTimingTracker::PresentTimingTracker(VkDeviceInstance* deviceInst)
+    : device_(deviceInst->GetLogicalDevice())
+{
+    if (deviceInst->IsPresentWaitEnabled())
+    {
+        waitForPresent_ = reinterpret_cast<PFN_vkWaitForPresentKHR>(
+            vkGetDeviceProcAddr(device_, "vkWaitForPresentKHR"));
+    }
+
+    presentWaitSupported_ = (waitForPresent_ != nullptr);
+
+    if (presentWaitSupported_)
+    {
+        waitThread_ = std::thread(&PresentTimingTracker::WaitLoop, this);
+        LOG_INFO("Present Timing: Tracking display latency with present wait");
+    }
+    else
+    {
+        LOG_WARN("Present Timing: present_wait unavailable, only submit -> present is tracked");
+    }
+}
+
+PresentTimingTracker::~PresentTimingTracker()
+{
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        stopping_ = true;
+    }
+    pendingCondition_.notify_all();
+
+    if (waitThread_.joinable())
+    {
+        waitThread_.join();
+    }
+}
+
+uint64_t PresentTimingTracker::AcquirePresentId()
+{
+    // Also used as the history index when present ID is not supported.
+    return nextPresentId_++;
+}
+
+void PresentTimingTracker::OnPresented(
+    VkSwapchainKHR swapChain,
+    uint64_t presentId,
+    PresentClock::time_point submitTime,
+    PresentClock::time_point presentTime)
+{
+    {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+
+        FrameTiming& timing = history_[presentId % PRESENT_TIMING_HISTORY];
+        timing = {};
+        timing.presentId = presentId;
+        timing.submitTime = submitTime;
+        timing.presentTime = presentTime;
+        timing.submitToPresentMs = ElapsedMs(submitTime, presentTime);
+        latestPresentId_ = presentId;
+    }
+
+    if (!presentWaitSupported_) { return; }
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.push_back({swapChain, presentId});
+    }
+    pendingCondition_.notify_one();
+}
+
+std::unique_lock<std::mutex> PresentTimingTracker::LockSwapChain()
+{
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        swapChainRequests_++;
+    }
+
+    std::unique_lock<std::mutex> swapChainLock(swapChainMutex_);
+
+    // Ours now, the helper thread can queue its next wait behind us.
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        swapChainRequests_--;
+    }
+    pendingCondition_.notify_all();
+
+    return swapChainLock;
+}
+
+void PresentTimingTracker::ForgetSwapChain(VkSwapchainKHR swapChain)
+{
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    pending_.erase(
+        std::remove_if(pending_.begin(), pending_.end(),
+            [swapChain](const PendingPresent& pending) { return pending.swapChain == swapChain; }),
+        pending_.end());
+}
+
+//----------------------------------------------------------------------------//
+
+void PresentTimingTracker::WaitLoop()
+{
+    PROFILE_THREAD_NAME("PresentWait");
+    while (true)
+    {
+        PendingPresent next = {};
+        {
+            // Sleeps while the render thread is queued for the swapchain, so it never
+            // waits for more than the slice already in flight.
+            std::unique_lock<std::mutex> lock(pendingMutex_);
+            pendingCondition_.wait(lock, [this]() {
+                return stopping_ || (!pending_.empty() && (swapChainRequests_ == 0));
+            });
+
+            if (stopping_) { return; }
+            next = pending_.front();
+        }
+
+        VkResult result = VK_TIMEOUT;
+        PresentClock::time_point displayTime;
+        {
+            std::lock_guard<std::mutex> swapChainLock(swapChainMutex_);
+
+            // The swapchain may have been forgotten while we were not holding the lock.
+            {
+                std::lock_guard<std::mutex> lock(pendingMutex_);
+                if (pending_.empty() || (pending_.front().presentId != next.presentId))
+                {
+                    continue;
+                }
+            }
+
+            result = waitForPresent_(device_, next.swapChain, next.presentId, PRESENT_WAIT_SLICE_NS);
+            displayTime = PresentClock::now();
+        }
+
+        if (result == VK_TIMEOUT) { continue; }
+
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            if (!pending_.empty() && (pending_.front().presentId == next.presentId))
+            {
+                pending_.pop_front();
+            }
+        }
+
+        if ((result == VK_SUCCESS) || (result == VK_SUBOPTIMAL_KHR))
+        {
+            RecordDisplay(next.presentId, displayTime);
+        }
+    }
+}
+
+void PresentTimingTracker::RecordDisplay(uint64_t presentId, PresentClock::time_point displayTime)
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+
+    FrameTiming& timing = history_[presentId % PRESENT_TIMING_HISTORY];
+    if (timing.presentId != presentId) { return; } // Already overwritten
+
+    timing.displayTime = displayTime;
+    timing.presentToDisplayMs = ElapsedMs(timing.presentTime, displayTime);
+    timing.submitToDisplayMs = ElapsedMs(timing.submitTime, displayTime);
+    timing.displayed = true;
+}
+
+//----------------------------------------------------------------------------//
+
+std::vector<FrameTiming> PresentTimingTracker::GetRecentTimings() const
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+
+    std::vector<FrameTiming> timings;
+    if (latestPresentId_ == 0) { return timings; }
+
+    uint64_t firstId = (latestPresentId_ >= PRESENT_TIMING_HISTORY) ?
+                       (latestPresentId_ - PRESENT_TIMING_HISTORY + 1) : 1;
+
+    timings.reserve(static_cast<size_t>(latestPresentId_ - firstId + 1));
+    for (uint64_t id = firstId; id <= latestPresentId_; ++id)
+    {
+        const FrameTiming& timing = history_[id % PRESENT_TIMING_HISTORY];
+        if (timing.presentId == id)
+        {
+            timings.push_back(timing);
+        }
+    }
+
+    return timings;
+}
+
+PresentStats PresentTimingTracker::GetStats() const
+{
+    PresentStats stats = {};
+    stats.presentWaitSupported = presentWaitSupported_;
+
+    std::vector<FrameTiming> timings = GetRecentTimings();
+    for (const FrameTiming& timing : timings)
+    {
+        stats.frameCount++;
+        stats.avgSubmitToPresentMs += timing.submitToPresentMs;
+
+        if (timing.displayed)
+        {
+            stats.displayedCount++;
+            stats.avgPresentToDisplayMs += timing.presentToDisplayMs;
+            stats.avgSubmitToDisplayMs += timing.submitToDisplayMs;
+            stats.maxSubmitToDisplayMs = std::max(stats.maxSubmitToDisplayMs, timing.submitToDisplayMs);
+        }
+    }
+
+    if (stats.frameCount > 0)
+    {
+        stats.avgSubmitToPresentMs /= stats.frameCount;
+    }
+    if (stats.displayedCount > 0)
+    {
+        stats.avgPresentToDisplayMs /= stats.displayedCount;
+        stats.avgSubmitToDisplayMs /= stats.displayedCount;
+    }
+
+    return stats;
+}
+
+} // namespace Graphic
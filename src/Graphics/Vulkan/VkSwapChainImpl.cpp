@@ -1,4 +1,6 @@
 #include <Graphics/Vulkan/VkSwapChainImpl.ipp>
+#include <Graphics/Vulkan/VkPresentTimingImpl.ipp>
+#include <Core/Profiler.ipp>
 #include <Graphics/Vulkan/VkUtil.ipp>
 #include <Settings.hpp>
 
@@ -6,64 +8,166 @@
 #include <Logging.hpp>
 
 // STD Lib
+#include <algorithm>
 #include <limits>
 #include <set>
 
 namespace Graphic
 {
-    
+
+static VkPresentModeKHR ToVkPresentMode(PresentMode mode)
+{
+    switch (mode)
+    {
+        case PresentMode::FifoRelaxed: return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+        case PresentMode::Mailbox: return VK_PRESENT_MODE_MAILBOX_KHR;
+        case PresentMode::Immediate: return VK_PRESENT_MODE_IMMEDIATE_KHR;
+        case PresentMode::Fifo:
+        default: return VK_PRESENT_MODE_FIFO_KHR;
+    }
+}
+
+static PresentMode FromVkPresentMode(VkPresentModeKHR mode)
+{
+    switch (mode)
+    {
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return PresentMode::FifoRelaxed;
+        case VK_PRESENT_MODE_MAILBOX_KHR: return PresentMode::Mailbox;
+        case VK_PRESENT_MODE_IMMEDIATE_KHR: return PresentMode::Immediate;
+        default: return PresentMode::Fifo;
+    }
+}
+
+const char* PresentModeToString(PresentMode mode)
+{
+    switch (mode)
+    {
+        case PresentMode::FifoRelaxed: return "FIFO Relaxed";
+        case PresentMode::Mailbox: return "Mailbox";
+        case PresentMode::Immediate: return "Immediate";
+        case PresentMode::Fifo:
+        default: return "FIFO (V-Sync)";
+    }
+}
+
+//----------------------------------------------------------------------------//
+
 SwapChainInstance::SwapChainInstance(
-    VkDeviceInstance* instance, VkExtent2D windowExtent)
-    : instance_(instance), windowExtent_(windowExtent)
+    VkDeviceInstance* instance,
+    VkExtent2D windowExtent,
+    const SwapChainConfig& config,
+    SwapChainInstance* previous)
+    : instance_(instance), windowExtent_(windowExtent), config_(config),
+      offscreen_(instance->GetSurface() == VK_NULL_HANDLE),
+      dynamicRendering_(instance->IsDynamicRenderingEnabled()),
+      framesInFlight_(std::clamp<uint32_t>(config.framesInFlight, 1, MAX_FRAMES_IN_FLIGHT)),
+      timeline_(instance->GetGraphicsTimeline())
 {
-    CreateSwapChain();
+    CreateSwapChain((previous != nullptr) ? previous->swapChainInst_ : VK_NULL_HANDLE);
     CreateImageView();
-    CreateRenderPass();
+
+    if (!dynamicRendering_)
+    {
+        VkFormat depthFormat = HasDepth() ? FindDepthFormat() : VK_FORMAT_UNDEFINED;
+        if ((previous != nullptr) && previous->CompareSwapFormats(swapChainImageFormat_, depthFormat))
+        {
+            AdoptRenderPass(previous);
+        }
+        else
+        {
+            CreateRenderPass();
+        }
+    }
+
     CreateDepthResources();
-    CreateFrameBuffers();
-    CreateSyncObjects();
+
+    // Dynamic rendering only needs the image views, nothing to rebuild per image on resize.
+    if (!dynamicRendering_)
+    {
+        CreateFrameBuffers();
+    }
+
+    if (previous != nullptr)
+    {
+        AdoptSyncObjects(previous);
+    }
+    else
+    {
+        CreateSyncObjects();
+    }
+    CreateRenderCompleteSemaphores();
 }
 
 SwapChainInstance::~SwapChainInstance()
 {
     for (auto imageView : swapChainImgViews_)
     {
-        vkDestroyImageView(instance_->GetLogicalDevice(), imageView, nullptr);
+        vkDestroyImageView(instance_->GetLogicalDevice(), imageView, instance_->GetAllocator());
     }
     swapChainImgViews_.clear();
 
     if (swapChainInst_ != VK_NULL_HANDLE)
     {
-        vkDestroySwapchainKHR(instance_->GetLogicalDevice(), swapChainInst_, nullptr);
+        std::unique_lock<std::mutex> presentLock;
+        if (config_.presentTracker != nullptr)
+        {
+            presentLock = config_.presentTracker->LockSwapChain();
+            config_.presentTracker->ForgetSwapChain(swapChainInst_);
+        }
+
+        vkDestroySwapchainKHR(instance_->GetLogicalDevice(), swapChainInst_, instance_->GetAllocator());
         swapChainInst_ = VK_NULL_HANDLE;
         LOG_INFO("SwapChain: Terminated !!");
     }
 
+    if (offscreen_)
+    {
+        for (size_t i = 0; i < swapChainImages_.size(); i++)
+        {
+            vkDestroyImage(instance_->GetLogicalDevice(), swapChainImages_[i], instance_->GetAllocator());
+            instance_->FreeMemory(offscreenImgMem_[i]);
+        }
+        swapChainImages_.clear();
+        offscreenImgMem_.clear();
+    }
+
     for (int i = 0; i < depthImages_.size(); i++)
     {
-        vkDestroyImageView(instance_->GetLogicalDevice(), depthImgViews_[i], nullptr);
-        vkDestroyImage(instance_->GetLogicalDevice(), depthImages_[i], nullptr);
-        vkFreeMemory(instance_->GetLogicalDevice(), depthImgMem_[i], nullptr);
+        vkDestroyImageView(instance_->GetLogicalDevice(), depthImgViews_[i], instance_->GetAllocator());
+        vkDestroyImage(instance_->GetLogicalDevice(), depthImages_[i], instance_->GetAllocator());
+        instance_->FreeMemory(depthImgMem_[i]);
     }
 
     for (auto framebuffer : frameBuffer_)
     {
-        vkDestroyFramebuffer(instance_->GetLogicalDevice(), framebuffer, nullptr);
+        vkDestroyFramebuffer(instance_->GetLogicalDevice(), framebuffer, instance_->GetAllocator());
     }
 
-    vkDestroyRenderPass(instance_->GetLogicalDevice(), renderPass_, nullptr);
+    if (renderPass_ != VK_NULL_HANDLE)
+    {
+        vkDestroyRenderPass(instance_->GetLogicalDevice(), renderPass_, instance_->GetAllocator());
+    }
 
-    // cleanup synchronization objects
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    // cleanup synchronization objects, acquire semaphores are empty when handed over
+    // to a newer swapchain
+    for (VkSemaphore semaphore : renderCompSemaphores_)
     {
-        vkDestroySemaphore(instance_->GetLogicalDevice(), renderCompSemaphores_[i], nullptr);
-        vkDestroySemaphore(instance_->GetLogicalDevice(), imgAvailSemaphores_[i], nullptr);
-        vkDestroyFence(instance_->GetLogicalDevice(), inFlightFences_[i], nullptr);
+        vkDestroySemaphore(instance_->GetLogicalDevice(), semaphore, instance_->GetAllocator());
+    }
+    for (VkSemaphore semaphore : imgAvailSemaphores_)
+    {
+        vkDestroySemaphore(instance_->GetLogicalDevice(), semaphore, instance_->GetAllocator());
     }
 }
 
-void SwapChainInstance::CreateSwapChain()
+void SwapChainInstance::CreateSwapChain(VkSwapchainKHR oldSwapChain)
 {
+    if (offscreen_)
+    {
+        CreateOffscreenImages();
+        return;
+    }
+
     SwapChainCapabilities swapChainSupport = GetSwapChainSupport(
                                                 instance_->GetPhyDevice(),
                                                 instance_->GetSurface());
@@ -73,6 +177,10 @@ void SwapChainInstance::CreateSwapChain()
     VkExtent2D extent = ChooseSwapExtent(swapChainSupport.capabilities);
 
     uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
+    if (config_.imageCount != 0)
+    {
+        imageCount = std::max(config_.imageCount, swapChainSupport.capabilities.minImageCount);
+    }
     if (swapChainSupport.capabilities.maxImageCount > 0 &&
         imageCount > swapChainSupport.capabilities.maxImageCount)
     {
@@ -89,6 +197,13 @@ void SwapChainInstance::CreateSwapChain()
     createInfo.imageArrayLayers = 1;
     createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 
+    // Needed to read frames back for capture, most surfaces support it.
+    readbackSupported_ = (swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0;
+    if (readbackSupported_)
+    {
+        createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+
     QueueFamilyIndices indices = FindQueueFamilies(instance_->GetPhyDevice(),
                                                   instance_->GetSurface());
     uint32_t queueFamilyIndices[] = {indices.graphicsFamilyIdx, indices.presentFamilyIdx};
@@ -109,15 +224,31 @@ void SwapChainInstance::CreateSwapChain()
     createInfo.preTransform = swapChainSupport.capabilities.currentTransform;
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode = presentMode;
+    presentMode_ = FromVkPresentMode(presentMode);
     createInfo.clipped = VK_TRUE;
 
-    createInfo.oldSwapchain = VK_NULL_HANDLE;
+    // Lets the driver reuse resources and keeps presenting the old images until
+    // the new ones are ready. The old swapchain is retired but still destroyed later.
+    createInfo.oldSwapchain = oldSwapChain;
+
+    // oldSwapchain is externally synchronized, keep the present tracker off it.
+    std::unique_lock<std::mutex> presentLock;
+    if ((config_.presentTracker != nullptr) && (oldSwapChain != VK_NULL_HANDLE))
+    {
+        presentLock = config_.presentTracker->LockSwapChain();
+        config_.presentTracker->ForgetSwapChain(oldSwapChain);
+    }
 
     VK_CHECK(
-        vkCreateSwapchainKHR(instance_->GetLogicalDevice(), &createInfo, nullptr, &swapChainInst_),
+        vkCreateSwapchainKHR(instance_->GetLogicalDevice(), &createInfo, instance_->GetAllocator(), &swapChainInst_),
         "SwapChain: Failed to initialize swap chain !!"
     )
 
+    if (presentLock.owns_lock())
+    {
+        presentLock.unlock();
+    }
+
     // we only specified a minimum number of images in the swap chain, so the implementation is
     // allowed to create a swap chain with more. That's why we'll first query the final number of
     // images with vkGetSwapchainImagesKHR, then resize the container and finally call it again to
@@ -129,6 +260,54 @@ void SwapChainInstance::CreateSwapChain()
 
     swapChainImageFormat_ = surfaceFormat.format;
     swapChainExtent_ = extent;
+
+    LOG_INFO("SwapChain: {} images, {} frames in flight", imageCount, framesInFlight_);
+}
+
+void SwapChainInstance::CreateOffscreenImages()
+{
+    swapChainImageFormat_ = instance_->FindSupportedFormat(
+        {VK_FORMAT_B8G8R8A8_SRGB, VK_FORMAT_R8G8B8A8_SRGB},
+        VK_IMAGE_TILING_OPTIMAL,
+        VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_TRANSFER_SRC_BIT);
+    swapChainExtent_ = windowExtent_;
+
+    // Nothing limits the frame rate without a display.
+    presentMode_ = PresentMode::Immediate;
+    readbackSupported_ = true;
+
+    // One image per frame in flight, the frame fence guards its reuse.
+    swapChainImages_.resize(framesInFlight_);
+    offscreenImgMem_.resize(framesInFlight_);
+
+    for (size_t i = 0; i < swapChainImages_.size(); i++)
+    {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = swapChainExtent_.width;
+        imageInfo.extent.height = swapChainExtent_.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = swapChainImageFormat_;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.flags = 0;
+
+        instance_->CreateImageWithInfo(
+            imageInfo,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            swapChainImages_[i],
+            offscreenImgMem_[i],
+            MemoryCategory::RenderTarget);
+    }
+
+    LOG_INFO("SwapChain: Offscreen ring of {} images ({}x{})",
+             swapChainImages_.size(), swapChainExtent_.width, swapChainExtent_.height);
 }
 
 void SwapChainInstance::CreateImageView()
@@ -148,7 +327,7 @@ void SwapChainInstance::CreateImageView()
         viewInfo.subresourceRange.layerCount = 1;
 
         VK_CHECK(
-            vkCreateImageView(instance_->GetLogicalDevice(), &viewInfo, nullptr, &swapChainImgViews_[i]),
+            vkCreateImageView(instance_->GetLogicalDevice(), &viewInfo, instance_->GetAllocator(), &swapChainImgViews_[i]),
             "SwapChain: Failed to create texture image view !!"
         )
     }
@@ -156,12 +335,30 @@ void SwapChainInstance::CreateImageView()
 
 void SwapChainInstance::CreateDepthResources()
 {
+    if (!HasDepth())
+    {
+        swapChainDepthFormat_ = VK_FORMAT_UNDEFINED;
+        return;
+    }
+
     swapChainDepthFormat_ = FindDepthFormat();
     VkExtent2D swapChainExtent = GetSwapChainExtent();
 
-    depthImages_.resize(GetImageCount());
-    depthImgMem_.resize(GetImageCount());
-    depthImgViews_.resize(GetImageCount());
+    // Only the frames in flight can use depth at the same time, not every swapchain image.
+    depthImages_.resize(framesInFlight_);
+    depthImgMem_.resize(framesInFlight_);
+    depthImgViews_.resize(framesInFlight_);
+
+    // Depth is cleared on load and never stored, on tile based GPUs it can live on chip only.
+    bool transient = (config_.depthMode == DepthMode::Transient);
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    VkMemoryPropertyFlags memProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    if (transient)
+    {
+        usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        memProperties |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+    }
+    bool lazilyAllocated = transient;
 
     for (int i = 0; i < depthImages_.size(); i++)
     {
@@ -176,16 +373,19 @@ void SwapChainInstance::CreateDepthResources()
         imageInfo.format = swapChainDepthFormat_;
         imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
         imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        imageInfo.usage = usage;
         imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
         imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         imageInfo.flags = 0;
 
-        instance_->CreateImageWithInfo(
+        VkMemoryPropertyFlags usedProperties = instance_->CreateImageWithInfo(
             imageInfo,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            memProperties,
             depthImages_[i],
-            depthImgMem_[i]);
+            depthImgMem_[i],
+            MemoryCategory::RenderTarget,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        lazilyAllocated &= (usedProperties & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0;
 
         VkImageViewCreateInfo viewInfo{};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -199,10 +399,15 @@ void SwapChainInstance::CreateDepthResources()
         viewInfo.subresourceRange.layerCount = 1;
 
         VK_CHECK(
-            vkCreateImageView(instance_->GetLogicalDevice(), &viewInfo, nullptr, &depthImgViews_[i]),
+            vkCreateImageView(instance_->GetLogicalDevice(), &viewInfo, instance_->GetAllocator(), &depthImgViews_[i]),
             "Depth Resource: Failed to create texture image view !!"
         )
     }
+
+    if (transient)
+    {
+        LOG_INFO("Depth Resource: Transient depth, {}", lazilyAllocated ? "lazily allocated" : "no lazy memory, device local");
+    }
 }
 
 void SwapChainInstance::CreateRenderPass()
@@ -229,7 +434,7 @@ void SwapChainInstance::CreateRenderPass()
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    colorAttachment.finalLayout = GetFinalColorLayout();
 
     VkAttachmentReference colorAttachmentRef = {};
     colorAttachmentRef.attachment = 0;
@@ -239,7 +444,7 @@ void SwapChainInstance::CreateRenderPass()
     subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
     subpass.colorAttachmentCount = 1;
     subpass.pColorAttachments = &colorAttachmentRef;
-    subpass.pDepthStencilAttachment = &depthAttachmentRef;
+    subpass.pDepthStencilAttachment = HasDepth() ? &depthAttachmentRef : nullptr;
 
     VkSubpassDependency dependency = {};
     dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
@@ -255,7 +460,7 @@ void SwapChainInstance::CreateRenderPass()
     VkAttachmentDescription attachments[2] = {colorAttachment, depthAttachment};
     VkRenderPassCreateInfo renderPassInfo = {};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = static_cast<uint32_t>(2);
+    renderPassInfo.attachmentCount = HasDepth() ? 2u : 1u;
     renderPassInfo.pAttachments = attachments;
     renderPassInfo.subpassCount = 1;
     renderPassInfo.pSubpasses = &subpass;
@@ -263,116 +468,180 @@ void SwapChainInstance::CreateRenderPass()
     renderPassInfo.pDependencies = &dependency;
 
     VK_CHECK(
-        vkCreateRenderPass(instance_->GetLogicalDevice(), &renderPassInfo, nullptr, &renderPass_),
+        vkCreateRenderPass(instance_->GetLogicalDevice(), &renderPassInfo, instance_->GetAllocator(), &renderPass_),
         "RenderPass: Failed to create render pass!"
     )
 }
 
 void SwapChainInstance::CreateFrameBuffers()
 {
-    frameBuffer_.resize(GetImageCount());
-    for (size_t i = 0; i < GetImageCount(); i++)
+    // One framebuffer per (frame slot, swapchain image) pair since depth follows the frame slot.
+    size_t slotCount = HasDepth() ? framesInFlight_ : 1;
+    frameBuffer_.resize(slotCount * GetImageCount());
+    for (size_t slot = 0; slot < slotCount; slot++)
     {
-        VkImageView attachments[2] = {swapChainImgViews_[i], depthImgViews_[i]};
+        for (size_t i = 0; i < GetImageCount(); i++)
+        {
+            VkImageView attachments[2] = {swapChainImgViews_[i], HasDepth() ? depthImgViews_[slot] : VK_NULL_HANDLE};
+
+            VkExtent2D swapChainExtent = swapChainExtent_;
+            VkFramebufferCreateInfo framebufferInfo = {};
+            framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+            framebufferInfo.renderPass = renderPass_;
+            framebufferInfo.attachmentCount = HasDepth() ? 2u : 1u;
+            framebufferInfo.pAttachments = attachments;
+            framebufferInfo.width = swapChainExtent.width;
+            framebufferInfo.height = swapChainExtent.height;
+            framebufferInfo.layers = 1;
+
+            VK_CHECK(
+                vkCreateFramebuffer(instance_->GetLogicalDevice(), &framebufferInfo, instance_->GetAllocator(),
+                                    &frameBuffer_[(slot * GetImageCount()) + i]),
+                "SwapChain: Failed to create framebuffer !!"
+            )
+        }
+    }
+}
 
-        VkExtent2D swapChainExtent = swapChainExtent_;
-        VkFramebufferCreateInfo framebufferInfo = {};
-        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-        framebufferInfo.renderPass = renderPass_;
-        framebufferInfo.attachmentCount = static_cast<uint32_t>(2);
-        framebufferInfo.pAttachments = attachments;
-        framebufferInfo.width = swapChainExtent.width;
-        framebufferInfo.height = swapChainExtent.height;
-        framebufferInfo.layers = 1;
+void SwapChainInstance::AdoptRenderPass(SwapChainInstance* previous)
+{
+    renderPass_ = previous->renderPass_;
+    previous->renderPass_ = VK_NULL_HANDLE;
+}
 
-        VK_CHECK(
-            vkCreateFramebuffer(instance_->GetLogicalDevice(), &framebufferInfo, nullptr, &frameBuffer_[i]),
-            "SwapChain: Failed to create framebuffer !!"
-        )
+void SwapChainInstance::AdoptSyncObjects(SwapChainInstance* previous)
+{
+    // Acquire semaphores and frame slots do not depend on the surface, frames that are
+    // still in flight keep being tracked through the same slots.
+    imgAvailSemaphores_ = std::move(previous->imgAvailSemaphores_);
+    frameSlotValue_ = std::move(previous->frameSlotValue_);
+    currentFrame_ = previous->currentFrame_;
+
+    previous->imgAvailSemaphores_.clear();
+    previous->frameSlotValue_.clear();
+
+    if (imgAvailSemaphores_.size() == framesInFlight_) { return; }
+
+    // Frame count changed, the slots can only be remapped once nothing uses them anymore.
+    // The Renderer drains the queue before such a change, this wait returns right away.
+    timeline_->Wait(*std::max_element(frameSlotValue_.begin(), frameSlotValue_.end()));
+
+    for (size_t i = framesInFlight_; i < imgAvailSemaphores_.size(); i++)
+    {
+        vkDestroySemaphore(instance_->GetLogicalDevice(), imgAvailSemaphores_[i], instance_->GetAllocator());
     }
+    imgAvailSemaphores_.resize(std::min<size_t>(imgAvailSemaphores_.size(), framesInFlight_));
+    CreateSyncObjects();
+    currentFrame_ = 0;
 }
 
 void SwapChainInstance::CreateSyncObjects()
 {
-    imgAvailSemaphores_.resize(MAX_FRAMES_IN_FLIGHT);
-    renderCompSemaphores_.resize(MAX_FRAMES_IN_FLIGHT);
-    inFlightFences_.resize(MAX_FRAMES_IN_FLIGHT);
-    imgInFlight_.resize(GetImageCount(), VK_NULL_HANDLE);
+    // Only the missing slots, adopted ones are kept.
+    size_t first = imgAvailSemaphores_.size();
+    imgAvailSemaphores_.resize(framesInFlight_);
+    frameSlotValue_.resize(framesInFlight_, 0);
 
     VkSemaphoreCreateInfo semaphoreInfo = {};
     semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    VkFenceCreateInfo fenceInfo = {};
-    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    for (size_t i = first; i < framesInFlight_; i++)
     {
-        if ((vkCreateSemaphore(instance_->GetLogicalDevice(), &semaphoreInfo, nullptr, &imgAvailSemaphores_[i]) !=
-                VK_SUCCESS) ||
-            (vkCreateSemaphore(instance_->GetLogicalDevice(), &semaphoreInfo, nullptr, &renderCompSemaphores_[i]) !=
-                VK_SUCCESS) ||
-            (vkCreateFence(instance_->GetLogicalDevice(), &fenceInfo, nullptr, &inFlightFences_[i]) != VK_SUCCESS))
-        {
-            LOG_ERROR("SyncObject: Failed to create synchronization objects for a frame !!");
-        }
+        VK_CHECK(
+            vkCreateSemaphore(instance_->GetLogicalDevice(), &semaphoreInfo, instance_->GetAllocator(), &imgAvailSemaphores_[i]),
+            "SyncObject: Failed to create synchronization objects for a frame !!"
+        )
     }
 }
 
-VkResult SwapChainInstance::SubmitCommandBuffers(const VkCommandBuffer* buffers, uint32_t* imageIndex)
+void SwapChainInstance::CreateRenderCompleteSemaphores()
 {
-    if (imgInFlight_[*imageIndex] != VK_NULL_HANDLE)
+    // Waited on by the present of that image, so it is only free again once the same
+    // image has been acquired. Per frame slot semaphores could still be pending.
+    renderCompSemaphores_.resize(offscreen_ ? 0 : GetImageCount());
+
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (size_t i = 0; i < renderCompSemaphores_.size(); i++)
     {
-        vkWaitForFences(
-            instance_->GetLogicalDevice(),
-            1,
-            &imgInFlight_[*imageIndex],
-            VK_TRUE,
-            UINT64_MAX);
+        VK_CHECK(
+            vkCreateSemaphore(instance_->GetLogicalDevice(), &semaphoreInfo, instance_->GetAllocator(), &renderCompSemaphores_[i]),
+            "SyncObject: Failed to create render complete semaphore !!"
+        )
     }
-    imgInFlight_[*imageIndex] = inFlightFences_[currentFrame_];
-
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+}
 
-    VkSemaphore waitSemaphores[] = {imgAvailSemaphores_[currentFrame_]};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
+VkResult SwapChainInstance::SubmitCommandBuffers(
+    const VkCommandBuffer* buffers,
+    uint32_t* imageIndex,
+    const std::vector<SemaphoreSubmit>& extraWaits)
+{
+    // No per image fence to wait on : the acquire semaphore orders this frame after the
+    // previous present of the image, and everything else is per frame slot.
+    std::vector<SemaphoreSubmit> waits = extraWaits;
+    std::vector<SemaphoreSubmit> signals;
 
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = buffers;
+    // Offscreen images are never acquired nor presented, the timeline is all we need.
+    if (!offscreen_)
+    {
+        waits.push_back({imgAvailSemaphores_[currentFrame_], 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT});
+        signals.push_back({renderCompSemaphores_[*imageIndex], 0, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT});
+    }
 
-    VkSemaphore signalSemaphores[] = {renderCompSemaphores_[currentFrame_]};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
+    VkResult submitResult = VK_SUCCESS;
+    uint64_t frameValue = timeline_->Submit(buffers, 1, waits, signals, &submitResult);
+    if (submitResult != VK_SUCCESS)
+    {
+        LOG_ERROR("SwapChain: Failed to submit draw command buffer !!");
+    }
+    PresentClock::time_point submitTime = PresentClock::now();
 
-    vkResetFences(
-        instance_->GetLogicalDevice(),
-        1,
-        &inFlightFences_[currentFrame_]);
+    frameSlotValue_[currentFrame_] = frameValue;
 
-    if (vkQueueSubmit(
-        instance_->GetGraphicsQ(),
-        1, &submitInfo,
-        inFlightFences_[currentFrame_]) != VK_SUCCESS)
+    if (offscreen_)
     {
-        LOG_ERROR("SwapChain: Failed to submit draw command buffer !!");
+        currentFrame_ = (currentFrame_ + 1) % framesInFlight_;
+        return VK_SUCCESS;
     }
 
+    VkSemaphore renderComplete = renderCompSemaphores_[*imageIndex];
     VkPresentInfoKHR presentInfo = {};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
     presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
+    presentInfo.pWaitSemaphores = &renderComplete;
     VkSwapchainKHR swapChains[] = {swapChainInst_};
     presentInfo.swapchainCount = 1;
     presentInfo.pSwapchains = swapChains;
     presentInfo.pImageIndices = imageIndex;
 
-    auto result = vkQueuePresentKHR(instance_->GetPresentQ() ,&presentInfo);
+    PresentTimingTracker* tracker = config_.presentTracker;
+    uint64_t presentId = (tracker != nullptr) ? tracker->AcquirePresentId() : 0;
 
-    currentFrame_ = (currentFrame_ + 1) % MAX_FRAMES_IN_FLIGHT;
+    VkPresentIdKHR presentIdInfo = {};
+    if ((tracker != nullptr) && tracker->IsPresentWaitSupported())
+    {
+        presentIdInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+        presentIdInfo.swapchainCount = 1;
+        presentIdInfo.pPresentIds = &presentId;
+        presentInfo.pNext = &presentIdInfo;
+    }
+
+    VkResult result = VK_SUCCESS;
+    if (tracker != nullptr)
+    {
+        {
+            std::unique_lock<std::mutex> presentLock = tracker->LockSwapChain();
+            result = vkQueuePresentKHR(instance_->GetPresentQ(), &presentInfo);
+        }
+        tracker->OnPresented(swapChainInst_, presentId, submitTime, PresentClock::now());
+    }
+    else
+    {
+        result = vkQueuePresentKHR(instance_->GetPresentQ(), &presentInfo);
+    }
+
+    currentFrame_ = (currentFrame_ + 1) % framesInFlight_;
 
     return result;
 }
@@ -395,17 +664,39 @@ VkSurfaceFormatKHR SwapChainInstance::ChooseSwapSurfaceFormat(
 VkPresentModeKHR SwapChainInstance::ChooseSwapPresentMode(
     const std::vector<VkPresentModeKHR>& availPresentMode)
 {
-    // More selecetive options in the future - Vsync off/on
-    // for (auto modes : availPresentMode)
-    // {
-    //     if (modes == VK_PRESENT_MODE_MAILBOX_KHR)
-    //     {
-    //         LOG_INFO("Present Mode -> Mailbox");
-    //         return modes;
-    //     }
-    // }
-    
-    LOG_INFO("Present Mode -> V-Sync");
+    // Fallback chains keep the intent of the request : low latency modes fall back to
+    // each other before V-Sync, tear free modes never fall back to a tearing one.
+    std::vector<PresentMode> candidates;
+    switch (config_.presentMode)
+    {
+        case PresentMode::Immediate:
+            candidates = {PresentMode::Immediate, PresentMode::Mailbox, PresentMode::FifoRelaxed};
+            break;
+        case PresentMode::Mailbox:
+            candidates = {PresentMode::Mailbox};
+            break;
+        case PresentMode::FifoRelaxed:
+            candidates = {PresentMode::FifoRelaxed};
+            break;
+        case PresentMode::Fifo:
+        default:
+            break;
+    }
+
+    for (PresentMode candidate : candidates)
+    {
+        VkPresentModeKHR vkMode = ToVkPresentMode(candidate);
+        if (std::find(availPresentMode.begin(), availPresentMode.end(), vkMode) != availPresentMode.end())
+        {
+            LOG_INFO("Present Mode -> {}", PresentModeToString(candidate));
+            return vkMode;
+        }
+
+        LOG_WARN("Present Mode: {} not supported, falling back", PresentModeToString(candidate));
+    }
+
+    // FIFO support is guaranteed by the spec.
+    LOG_INFO("Present Mode -> {}", PresentModeToString(PresentMode::Fifo));
     return VK_PRESENT_MODE_FIFO_KHR;
 }
 
@@ -438,14 +729,29 @@ VkFormat SwapChainInstance::FindDepthFormat()
         VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
 }
 
+void SwapChainInstance::WaitForFrame(uint64_t frameNumber)
+{
+    PROFILE_SCOPE("SwapChain::WaitForFrame");
+    timeline_->Wait(frameNumber);
+}
+
 VkResult SwapChainInstance::AcquireNextImage(uint32_t* imageIndex)
 {
-    vkWaitForFences(
-        instance_->GetLogicalDevice(),
-        1,
-        &inFlightFences_[currentFrame_],
-        VK_TRUE,
-        std::numeric_limits<uint64_t>::max());
+    {
+        // Frame slot resources (command buffer, depth, readback) are free once the
+        // frame last submitted from this slot has completed.
+        PROFILE_SCOPE("SwapChain::WaitFrameSlot");
+        timeline_->Wait(frameSlotValue_[currentFrame_]);
+    }
+
+    if (offscreen_)
+    {
+        // The ring has one image per frame slot, whose frame was just waited on.
+        *imageIndex = static_cast<uint32_t>(currentFrame_ % swapChainImages_.size());
+        return VK_SUCCESS;
+    }
+
+    PROFILE_SCOPE("SwapChain::AcquireNextImage");
 
     VkResult result = vkAcquireNextImageKHR(
         instance_->GetLogicalDevice(),
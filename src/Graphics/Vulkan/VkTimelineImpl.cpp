@@ -0,0 +1,203 @@
+#include <Graphics/Vulkan/VkTimelineImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+namespace Graphic
+{
+
+QueueTimeline::QueueTimeline(
+    VkDevice device,
+    const VkAllocationCallbacks* allocator,
+    VkQueue queue,
+    bool synchronization2)
+    : device_(device), allocator_(allocator), queue_(queue), synchronization2_(synchronization2)
+{
+    VkSemaphoreTypeCreateInfo typeInfo = {};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    VK_CHECK(
+        vkCreateSemaphore(device_, &semaphoreInfo, allocator_, &semaphore_),
+        "Timeline: Failed to create timeline semaphore !!"
+    )
+}
+
+QueueTimeline::~QueueTimeline()
+{
+    if (semaphore_ != VK_NULL_HANDLE)
+    {
+        vkDestroySemaphore(device_, semaphore_, allocator_);
+        semaphore_ = VK_NULL_HANDLE;
+    }
+}
+
+uint64_t QueueTimeline::GetCompletedValue()
+{
+    uint64_t value = 0;
+    if (vkGetSemaphoreCounterValue(device_, semaphore_, &value) != VK_SUCCESS)
+    {
+        return completedValue_.load(std::memory_order_acquire);
+    }
+
+    // Keep the cache monotonic when several threads query at once.
+    uint64_t cached = completedValue_.load(std::memory_order_relaxed);
+    while ((value > cached) &&
+           !completedValue_.compare_exchange_weak(cached, value, std::memory_order_acq_rel)) {}
+
+    return value;
+}
+
+bool QueueTimeline::Wait(uint64_t value, uint64_t timeoutNs)
+{
+    if (IsComplete(value)) { return true; }
+
+    PROFILE_SCOPE("QueueTimeline::Wait");
+
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &semaphore_;
+    waitInfo.pValues = &value;
+
+    VkResult result = vkWaitSemaphores(device_, &waitInfo, timeoutNs);
+    if (result == VK_SUCCESS)
+    {
+        uint64_t cached = completedValue_.load(std::memory_order_relaxed);
+        while ((value > cached) &&
+               !completedValue_.compare_exchange_weak(cached, value, std::memory_order_acq_rel)) {}
+        return true;
+    }
+
+    if (result != VK_TIMEOUT)
+    {
+        LOG_ERROR("Timeline: Wait for value {} failed ({})", value, static_cast<int32_t>(result));
+    }
+    return false;
+}
+
+uint64_t QueueTimeline::Submit(
+    const VkCommandBuffer* commandBuffers,
+    uint32_t commandBufferCount,
+    const std::vector<SemaphoreSubmit>& waits,
+    const std::vector<SemaphoreSubmit>& signals,
+    VkResult* result)
+{
+    // Timeline values must increase in submission order, reserve and submit together.
+    std::lock_guard<std::mutex> lock(submitMutex_);
+
+    uint64_t value = submittedValue_.load(std::memory_order_relaxed) + 1;
+
+    std::vector<SemaphoreSubmit> allSignals = signals;
+    allSignals.push_back({semaphore_, value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT});
+
+    VkResult submitResult = VK_SUCCESS;
+    if (synchronization2_)
+    {
+        std::vector<VkSemaphoreSubmitInfo> waitInfos(waits.size());
+        for (size_t i = 0; i < waits.size(); i++)
+        {
+            waitInfos[i].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            waitInfos[i].semaphore = waits[i].semaphore;
+            waitInfos[i].value = waits[i].value;
+            waitInfos[i].stageMask = waits[i].stageMask;
+        }
+
+        std::vector<VkSemaphoreSubmitInfo> signalInfos(allSignals.size());
+        for (size_t i = 0; i < allSignals.size(); i++)
+        {
+            signalInfos[i].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            signalInfos[i].semaphore = allSignals[i].semaphore;
+            signalInfos[i].value = allSignals[i].value;
+            signalInfos[i].stageMask = allSignals[i].stageMask;
+        }
+
+        std::vector<VkCommandBufferSubmitInfo> cmdInfos(commandBufferCount);
+        for (uint32_t i = 0; i < commandBufferCount; i++)
+        {
+            cmdInfos[i].sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+            cmdInfos[i].commandBuffer = commandBuffers[i];
+        }
+
+        VkSubmitInfo2 submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submitInfo.waitSemaphoreInfoCount = static_cast<uint32_t>(waitInfos.size());
+        submitInfo.pWaitSemaphoreInfos = waitInfos.data();
+        submitInfo.commandBufferInfoCount = static_cast<uint32_t>(cmdInfos.size());
+        submitInfo.pCommandBufferInfos = cmdInfos.data();
+        submitInfo.signalSemaphoreInfoCount = static_cast<uint32_t>(signalInfos.size());
+        submitInfo.pSignalSemaphoreInfos = signalInfos.data();
+
+        submitResult = vkQueueSubmit2(queue_, 1, &submitInfo, VK_NULL_HANDLE);
+    }
+    else
+    {
+        submitResult = SubmitLegacy(commandBuffers, commandBufferCount, waits, allSignals);
+    }
+
+    if (result != nullptr) { *result = submitResult; }
+
+    if (submitResult != VK_SUCCESS)
+    {
+        LOG_ERROR("Timeline: Queue submit failed ({})", static_cast<int32_t>(submitResult));
+        return submittedValue_.load(std::memory_order_relaxed);
+    }
+
+    submittedValue_.store(value, std::memory_order_release);
+    return value;
+}
+
+VkResult QueueTimeline::SubmitLegacy(
+    const VkCommandBuffer* commandBuffers,
+    uint32_t commandBufferCount,
+    const std::vector<SemaphoreSubmit>& waits,
+    const std::vector<SemaphoreSubmit>& signals)
+{
+    std::vector<VkSemaphore> waitSemaphores;
+    std::vector<uint64_t> waitValues;
+    std::vector<VkPipelineStageFlags> waitStages;
+    for (const SemaphoreSubmit& wait : waits)
+    {
+        waitSemaphores.push_back(wait.semaphore);
+        waitValues.push_back(wait.value);
+        // The legacy stage bits share their values with the low bits of the sync2 ones.
+        waitStages.push_back(static_cast<VkPipelineStageFlags>(wait.stageMask));
+    }
+
+    std::vector<VkSemaphore> signalSemaphores;
+    std::vector<uint64_t> signalValues;
+    for (const SemaphoreSubmit& signal : signals)
+    {
+        signalSemaphores.push_back(signal.semaphore);
+        signalValues.push_back(signal.value);
+    }
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+    timelineInfo.pWaitSemaphoreValues = waitValues.data();
+    timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+    timelineInfo.pSignalSemaphoreValues = signalValues.data();
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+    submitInfo.pWaitSemaphores = waitSemaphores.data();
+    submitInfo.pWaitDstStageMask = waitStages.data();
+    submitInfo.commandBufferCount = commandBufferCount;
+    submitInfo.pCommandBuffers = commandBuffers;
+    submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+    submitInfo.pSignalSemaphores = signalSemaphores.data();
+
+    return vkQueueSubmit(queue_, 1, &submitInfo, VK_NULL_HANDLE);
+}
+
+} // namespace Graphic
@@ -0,0 +1,503 @@
+#include <Graphics/Vulkan/VkTransferQueueImpl.ipp>
+#include <Graphics/Vulkan/VkInstanceImpl.ipp>
+#include <Graphics/Vulkan/VkUtil.ipp>
+#include <Core/Profiler.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <cstring>
+
+namespace Graphic
+{
+
+TransferQueue::TransferQueue(VkDeviceInstance* deviceInst)
+    : deviceInst_(deviceInst),
+      transferFamily_(deviceInst->GetTransferFamilyIdx()),
+      graphicsFamily_(deviceInst->GetGraphicsFamilyIdx())
+{
+    dedicated_ = (transferFamily_ != graphicsFamily_);
+    timeline_ = dedicated_ ? deviceInst->GetTransferTimeline() : deviceInst->GetGraphicsTimeline();
+
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = transferFamily_;
+
+    VK_CHECK(
+        vkCreateCommandPool(deviceInst_->GetLogicalDevice(), &poolInfo, deviceInst_->GetAllocator(), &commandPool_),
+        "Transfer: Failed to create command pool !!"
+    )
+
+    LOG_INFO("Transfer: Uploads on {} (family {})",
+             dedicated_ ? "dedicated transfer queue" : "graphics queue", transferFamily_);
+}
+
+TransferQueue::~TransferQueue()
+{
+    // Staging memory can only go once the copies reading from it are done.
+    timeline_->Wait(timeline_->GetSubmittedValue());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ReleaseFinished();
+        if (!pending_.empty())
+        {
+            LOG_WARN("Transfer: {} uploads were never acquired by the graphics queue", pending_.size());
+        }
+        for (PendingUpload& upload : pending_)
+        {
+            upload.acquired = true;
+        }
+        ReleaseFinished();
+
+        for (StagingBlock& block : stagingPool_)
+        {
+            DestroyStaging(block);
+        }
+        stagingPool_.clear();
+    }
+
+    vkDestroyCommandPool(deviceInst_->GetLogicalDevice(), commandPool_, deviceInst_->GetAllocator());
+}
+
+bool TransferQueue::CreateStaging(const void* data, VkDeviceSize size, PendingUpload& upload)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!AcquireStaging(size, upload.staging)) { return false; }
+    }
+
+    // The block is ours until the upload is submitted, copy without holding the lock.
+    memcpy(upload.staging.mapped, data, static_cast<size_t>(size));
+    return true;
+}
+
+bool TransferQueue::AcquireStaging(VkDeviceSize size, StagingBlock& block)
+{
+    // Smallest idle block that fits.
+    auto best = stagingPool_.end();
+    for (auto it = stagingPool_.begin(); it != stagingPool_.end(); ++it)
+    {
+        if ((it->size >= size) && ((best == stagingPool_.end()) || (it->size < best->size)))
+        {
+            best = it;
+        }
+    }
+
+    if (best != stagingPool_.end())
+    {
+        block = *best;
+        pooledStagingSize_ -= best->size;
+        stagingPool_.erase(best);
+        return true;
+    }
+
+    // Power of two sizes so blocks are reused across slightly different uploads.
+    VkDeviceSize blockSize = TRANSFER_STAGING_MIN_SIZE;
+    while (blockSize < size) { blockSize *= 2; }
+
+    deviceInst_->CreateBuffer(
+        blockSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        block.buffer,
+        block.memory,
+        MemoryCategory::Staging);
+    block.size = blockSize;
+
+    if (vkMapMemory(deviceInst_->GetLogicalDevice(), block.memory, 0, blockSize, 0, &block.mapped) != VK_SUCCESS)
+    {
+        LOG_ERROR("Transfer: Failed to map staging buffer !!");
+        block.mapped = nullptr;
+        DestroyStaging(block);
+        return false;
+    }
+
+    return true;
+}
+
+void TransferQueue::RecycleStaging(StagingBlock& block)
+{
+    if (block.buffer == VK_NULL_HANDLE) { return; }
+
+    if ((pooledStagingSize_ + block.size) <= TRANSFER_STAGING_POOL_SIZE)
+    {
+        pooledStagingSize_ += block.size;
+        stagingPool_.push_back(block);
+        block = {};
+        return;
+    }
+
+    DestroyStaging(block);
+}
+
+void TransferQueue::DestroyStaging(StagingBlock& block)
+{
+    VkDevice device = deviceInst_->GetLogicalDevice();
+    if (block.mapped != nullptr)
+    {
+        vkUnmapMemory(device, block.memory);
+    }
+    vkDestroyBuffer(device, block.buffer, deviceInst_->GetAllocator());
+    deviceInst_->FreeMemory(block.memory);
+    block = {};
+}
+
+VkDeviceSize TransferQueue::GetPooledStagingSize()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pooledStagingSize_;
+}
+
+VkCommandBuffer TransferQueue::BeginUpload()
+{
+    ReleaseFinished();
+
+    VkCommandBufferAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandPool = commandPool_;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    VK_CHECK(
+        vkAllocateCommandBuffers(deviceInst_->GetLogicalDevice(), &allocInfo, &commandBuffer),
+        "Transfer: Failed to allocate command buffer !!"
+    )
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    return commandBuffer;
+}
+
+TransferTicket TransferQueue::EndUpload(PendingUpload&& upload)
+{
+    vkEndCommandBuffer(upload.commandBuffer);
+
+    VkResult result = VK_SUCCESS;
+    upload.value = timeline_->Submit(&upload.commandBuffer, 1, {}, {}, &result);
+    if (result != VK_SUCCESS)
+    {
+        // Nothing was queued, release everything right away.
+        vkFreeCommandBuffers(deviceInst_->GetLogicalDevice(), commandPool_, 1, &upload.commandBuffer);
+        RecycleStaging(upload.staging);
+        return {};
+    }
+
+    // On a shared queue the barrier recorded with the copy already covers later submits.
+    upload.acquired = !dedicated_;
+    if (!dedicated_)
+    {
+        acquiredValue_ = std::max(acquiredValue_, upload.value);
+    }
+
+    TransferTicket ticket{upload.value};
+    pending_.push_back(std::move(upload));
+    return ticket;
+}
+
+TransferTicket TransferQueue::UploadBuffer(
+    VkBuffer dstBuffer,
+    const void* data,
+    VkDeviceSize size,
+    VkPipelineStageFlags dstStage,
+    VkAccessFlags dstAccess,
+    VkDeviceSize dstOffset)
+{
+    PROFILE_SCOPE("TransferQueue::UploadBuffer");
+
+    PendingUpload upload;
+    if (!CreateStaging(data, size, upload)) { return {}; }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    VkBuffer staging = upload.staging.buffer;
+    return RecordBufferCopy(std::move(upload), staging, dstBuffer, dstOffset, size, dstStage, dstAccess);
+}
+
+TransferTicket TransferQueue::CopyBuffer(
+    VkBuffer srcBuffer,
+    VkBuffer dstBuffer,
+    VkDeviceSize size,
+    VkPipelineStageFlags dstStage,
+    VkAccessFlags dstAccess)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return RecordBufferCopy(PendingUpload{}, srcBuffer, dstBuffer, 0, size, dstStage, dstAccess);
+}
+
+TransferTicket TransferQueue::RecordBufferCopy(
+    PendingUpload&& upload,
+    VkBuffer srcBuffer,
+    VkBuffer dstBuffer,
+    VkDeviceSize dstOffset,
+    VkDeviceSize size,
+    VkPipelineStageFlags dstStage,
+    VkAccessFlags dstAccess)
+{
+    upload.commandBuffer = BeginUpload();
+    upload.dstStage = dstStage;
+
+    VkBufferCopy copyRegion = {};
+    copyRegion.srcOffset = 0;
+    copyRegion.dstOffset = dstOffset;
+    copyRegion.size = size;
+    vkCmdCopyBuffer(upload.commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+
+    VkBufferMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.buffer = dstBuffer;
+    barrier.offset = dstOffset;
+    barrier.size = size;
+
+    if (dedicated_)
+    {
+        // Release half, the destination access is ignored and done by the acquire.
+        barrier.dstAccessMask = 0;
+        barrier.srcQueueFamilyIndex = transferFamily_;
+        barrier.dstQueueFamilyIndex = graphicsFamily_;
+        vkCmdPipelineBarrier(
+            upload.commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+        VkBufferMemoryBarrier acquire = barrier;
+        acquire.srcAccessMask = 0;
+        acquire.dstAccessMask = dstAccess;
+        upload.bufferAcquires.push_back(acquire);
+    }
+    else
+    {
+        barrier.dstAccessMask = dstAccess;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        vkCmdPipelineBarrier(
+            upload.commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+            0, 0, nullptr, 1, &barrier, 0, nullptr);
+    }
+
+    return EndUpload(std::move(upload));
+}
+
+TransferTicket TransferQueue::UploadImage(
+    VkImage dstImage,
+    const void* data,
+    VkDeviceSize size,
+    VkExtent3D extent,
+    uint32_t layerCount,
+    VkImageLayout finalLayout,
+    VkPipelineStageFlags dstStage,
+    VkAccessFlags dstAccess)
+{
+    PROFILE_SCOPE("TransferQueue::UploadImage");
+
+    PendingUpload upload;
+    if (!CreateStaging(data, size, upload)) { return {}; }
+
+    VkBufferImageCopy region = {};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, layerCount};
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = extent;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return RecordImageCopy(std::move(upload), dstImage, {region}, 1, layerCount, finalLayout, dstStage, dstAccess);
+}
+
+TransferTicket TransferQueue::UploadImageLevels(
+    VkImage dstImage,
+    const std::vector<ImageLevelData>& levels,
+    VkImageLayout finalLayout,
+    VkPipelineStageFlags dstStage,
+    VkAccessFlags dstAccess)
+{
+    PROFILE_SCOPE("TransferQueue::UploadImageLevels");
+
+    // Level offsets are aligned for any texel block size.
+    std::vector<VkBufferImageCopy> regions(levels.size());
+    VkDeviceSize totalSize = 0;
+    for (uint32_t level = 0; level < levels.size(); ++level)
+    {
+        VkBufferImageCopy& region = regions[level];
+        region.bufferOffset = totalSize;
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = levels[level].extent;
+        totalSize = (totalSize + levels[level].size + 15) & ~VkDeviceSize(15);
+    }
+
+    PendingUpload upload;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (levels.empty() || !AcquireStaging(totalSize, upload.staging)) { return {}; }
+    }
+
+    // Same as CreateStaging, the block is ours until the upload is submitted.
+    for (uint32_t level = 0; level < levels.size(); ++level)
+    {
+        memcpy(static_cast<uint8_t*>(upload.staging.mapped) + regions[level].bufferOffset,
+               levels[level].data, static_cast<size_t>(levels[level].size));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return RecordImageCopy(
+        std::move(upload), dstImage, regions, static_cast<uint32_t>(levels.size()), 1,
+        finalLayout, dstStage, dstAccess);
+}
+
+TransferTicket TransferQueue::RecordImageCopy(
+    PendingUpload&& upload,
+    VkImage dstImage,
+    const std::vector<VkBufferImageCopy>& regions,
+    uint32_t levelCount,
+    uint32_t layerCount,
+    VkImageLayout finalLayout,
+    VkPipelineStageFlags dstStage,
+    VkAccessFlags dstAccess)
+{
+    upload.commandBuffer = BeginUpload();
+    upload.dstStage = dstStage;
+
+    VkImageMemoryBarrier toTransfer = {};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransfer.srcAccessMask = 0;
+    toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = dstImage;
+    toTransfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, layerCount};
+
+    vkCmdPipelineBarrier(
+        upload.commandBuffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+    vkCmdCopyBufferToImage(
+        upload.commandBuffer,
+        upload.staging.buffer,
+        dstImage,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        static_cast<uint32_t>(regions.size()), regions.data());
+
+    // The layout transition is part of the ownership transfer, both halves must match.
+    VkImageMemoryBarrier toFinal = toTransfer;
+    toFinal.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toFinal.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    toFinal.newLayout = finalLayout;
+
+    if (dedicated_)
+    {
+        toFinal.dstAccessMask = 0;
+        toFinal.srcQueueFamilyIndex = transferFamily_;
+        toFinal.dstQueueFamilyIndex = graphicsFamily_;
+        vkCmdPipelineBarrier(
+            upload.commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &toFinal);
+
+        VkImageMemoryBarrier acquire = toFinal;
+        acquire.srcAccessMask = 0;
+        acquire.dstAccessMask = dstAccess;
+        upload.imageAcquires.push_back(acquire);
+    }
+    else
+    {
+        toFinal.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(
+            upload.commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+            0, 0, nullptr, 0, nullptr, 1, &toFinal);
+    }
+
+    return EndUpload(std::move(upload));
+}
+
+bool TransferQueue::IsReady(TransferTicket ticket)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (ticket.value <= acquiredValue_);
+}
+
+void TransferQueue::WaitReady(TransferTicket ticket)
+{
+    if (IsReady(ticket)) { return; }
+
+    PROFILE_SCOPE("TransferQueue::WaitReady");
+    timeline_->Wait(ticket.value);
+
+    // Acquire right away instead of waiting for the next frame.
+    VkCommandBuffer commandBuffer = deviceInst_->BeginSingleTimeCommands();
+    std::vector<SemaphoreSubmit> waits;
+    RecordAcquires(commandBuffer, waits);
+    vkEndCommandBuffer(commandBuffer);
+
+    QueueTimeline* graphicsTimeline = deviceInst_->GetGraphicsTimeline();
+    uint64_t value = graphicsTimeline->Submit(&commandBuffer, 1, waits);
+    graphicsTimeline->Wait(value);
+
+    vkFreeCommandBuffers(deviceInst_->GetLogicalDevice(), deviceInst_->GetCommandPool(), 1, &commandBuffer);
+}
+
+void TransferQueue::RecordAcquires(VkCommandBuffer commandBuffer, std::vector<SemaphoreSubmit>& waits)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint64_t waitValue = 0;
+    for (PendingUpload& upload : pending_)
+    {
+        if (upload.acquired) { continue; }
+
+        // Uploads finish in submission order, stop at the first one still running.
+        if (!timeline_->IsComplete(upload.value)) { break; }
+
+        RecordAcquireBarriers(commandBuffer, upload);
+        upload.acquired = true;
+        acquiredValue_ = std::max(acquiredValue_, upload.value);
+        waitValue = upload.value;
+    }
+
+    // Already signaled, only there to order the acquire after the release.
+    if (waitValue != 0)
+    {
+        waits.push_back({timeline_->GetSemaphore(), waitValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT});
+    }
+
+    ReleaseFinished();
+}
+
+void TransferQueue::RecordAcquireBarriers(VkCommandBuffer commandBuffer, const PendingUpload& upload)
+{
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, upload.dstStage,
+        0,
+        0, nullptr,
+        static_cast<uint32_t>(upload.bufferAcquires.size()), upload.bufferAcquires.data(),
+        static_cast<uint32_t>(upload.imageAcquires.size()), upload.imageAcquires.data());
+}
+
+void TransferQueue::ReleaseFinished()
+{
+    while (!pending_.empty())
+    {
+        PendingUpload& upload = pending_.front();
+        if (!upload.acquired || !timeline_->IsComplete(upload.value)) { break; }
+
+        vkFreeCommandBuffers(deviceInst_->GetLogicalDevice(), commandPool_, 1, &upload.commandBuffer);
+        RecycleStaging(upload.staging);
+        pending_.pop_front();
+    }
+}
+
+} // namespace Graphic
@@ -3,6 +3,9 @@
 // External Lib
 #include <Logging.hpp>
 
+// STD Lib
+#include <algorithm>
+
 namespace Graphic
 {
 
@@ -30,12 +33,22 @@ QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surfa
     for (uint32_t i = 0; i < familiesProperties.size(); ++i)
     {
         VkBool32 presentationSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i , surface, &presentationSupport);
 
         if (familiesProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
         {
             queueFamilyIndices.graphicsFamilyIdx = i;
             queueFamilyIndices.graphicsFamilyHaxValue = true;
+
+            // Offscreen rendering never presents, the graphics queue stands in.
+            if (surface == VK_NULL_HANDLE)
+            {
+                presentationSupport = true;
+            }
+        }
+
+        if (surface != VK_NULL_HANDLE)
+        {
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i , surface, &presentationSupport);
         }
 
         if (presentationSupport)
@@ -53,6 +66,101 @@ QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surfa
     return queueFamilyIndices;
 }
 
+uint32_t FindTransferQueueFamily(VkPhysicalDevice device, uint32_t fallbackFamily)
+{
+    std::vector<VkQueueFamilyProperties> familiesProperties = GetDeviceQueueFamilyProperties(device);
+
+    uint32_t nonGraphicsFamily = fallbackFamily;
+    for (uint32_t i = 0; i < familiesProperties.size(); ++i)
+    {
+        VkQueueFlags flags = familiesProperties[i].queueFlags;
+        if (!(flags & VK_QUEUE_TRANSFER_BIT) || (flags & VK_QUEUE_GRAPHICS_BIT)) { continue; }
+
+        if (!(flags & VK_QUEUE_COMPUTE_BIT))
+        {
+            return i;
+        }
+        if (nonGraphicsFamily == fallbackFamily)
+        {
+            nonGraphicsFamily = i;
+        }
+    }
+
+    return nonGraphicsFamily;
+}
+
+uint32_t FindComputeQueueFamily(VkPhysicalDevice device, uint32_t fallbackFamily)
+{
+    std::vector<VkQueueFamilyProperties> familiesProperties = GetDeviceQueueFamilyProperties(device);
+
+    for (uint32_t i = 0; i < familiesProperties.size(); ++i)
+    {
+        VkQueueFlags flags = familiesProperties[i].queueFlags;
+        if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT))
+        {
+            return i;
+        }
+    }
+
+    return fallbackFamily;
+}
+
+uint32_t GetQueueFamilyQueueCount(VkPhysicalDevice device, uint32_t family)
+{
+    std::vector<VkQueueFamilyProperties> familiesProperties = GetDeviceQueueFamilyProperties(device);
+    return (family < familiesProperties.size()) ? familiesProperties[family].queueCount : 0;
+}
+
+const char* GetDeviceTypeName(VkPhysicalDeviceType type)
+{
+    switch (type)
+    {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return "discrete";
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return "virtual";
+        case VK_PHYSICAL_DEVICE_TYPE_CPU: return "cpu";
+        default: return "other";
+    }
+}
+
+VkDeviceSize GetDeviceLocalHeapSize(VkPhysicalDevice device)
+{
+    VkPhysicalDeviceMemoryProperties memProperties = {};
+    vkGetPhysicalDeviceMemoryProperties(device, &memProperties);
+
+    VkDeviceSize largest = 0;
+    for (uint32_t i = 0; i < memProperties.memoryHeapCount; ++i)
+    {
+        if (memProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+        {
+            largest = std::max(largest, memProperties.memoryHeaps[i].size);
+        }
+    }
+
+    return largest;
+}
+
+std::string GetDeviceUUIDString(VkPhysicalDevice device)
+{
+    VkPhysicalDeviceIDProperties idProperties = {};
+    idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+    VkPhysicalDeviceProperties2 properties = {};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &idProperties;
+    vkGetPhysicalDeviceProperties2(device, &properties);
+
+    static const char hexDigits[] = "0123456789abcdef";
+    std::string uuid;
+    uuid.reserve(VK_UUID_SIZE * 2);
+    for (uint32_t i = 0; i < VK_UUID_SIZE; ++i)
+    {
+        uuid.push_back(hexDigits[idProperties.deviceUUID[i] >> 4]);
+        uuid.push_back(hexDigits[idProperties.deviceUUID[i] & 0xF]);
+    }
+
+    return uuid;
+}
+
 SwapChainCapabilities GetSwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface)
 {
     SwapChainCapabilities properties;
@@ -76,4 +184,52 @@ SwapChainCapabilities GetSwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR
     return properties;
 }
 
+VkImageAspectFlags GetDepthAspectMask(VkFormat depthFormat)
+{
+    VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    if ((depthFormat == VK_FORMAT_D32_SFLOAT_S8_UINT) ||
+        (depthFormat == VK_FORMAT_D24_UNORM_S8_UINT) ||
+        (depthFormat == VK_FORMAT_D16_UNORM_S8_UINT))
+    {
+        aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+    return aspectMask;
+}
+
+void ImageBarrier2(
+    VkCommandBuffer cmdBuffer,
+    VkImage image,
+    VkImageAspectFlags aspectMask,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    VkPipelineStageFlags2 srcStage,
+    VkAccessFlags2 srcAccess,
+    VkPipelineStageFlags2 dstStage,
+    VkAccessFlags2 dstAccess)
+{
+    VkImageMemoryBarrier2 barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = srcStage;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstStageMask = dstStage;
+    barrier.dstAccessMask = dstAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = aspectMask;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+    VkDependencyInfo dependencyInfo = {};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = 1;
+    dependencyInfo.pImageMemoryBarriers = &barrier;
+
+    vkCmdPipelineBarrier2(cmdBuffer, &dependencyInfo);
+}
+
 } // namespace Graphic
@@ -1,5 +1,6 @@
 #include <Graphics/WindowHandler.hpp>
 #include <Input/InputHandler.ipp>
+#include <Core/Profiler.ipp>
 
 // External Lib
 #include <GLFW/glfw3.h>
@@ -15,6 +16,15 @@ void KeyCallBack(GLFWwindow* window, int32_t key, int32_t scancode, int32_t acti
         glfwSetWindowShouldClose(window, true);
     }
 
+    if ((key == GLFW_KEY_F12) && (action == GLFW_PRESS))
+    {
+#if ENABLE_CPU_PROFILER
+        Core::Profiler::Get().DumpChromeTrace(std::string(PROJECT_DIRECTORY) + CPU_PROFILER_TRACE_PATH);
+#else
+        LOG_WARN("Input: CPU profiler is disabled, nothing to dump");
+#endif
+    }
+
     if ((key == GLFW_KEY_H) && (action == GLFW_PRESS) && (mods & GLFW_MOD_CONTROL))
     {
         LOG_ERROR_EXIT("TEST ERROR KEY");
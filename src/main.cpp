@@ -2,9 +2,17 @@
 
 int32_t main(int argc, const char * argv[])
 {
-    Graphic::Application gfxHandler;
+    Graphic::ApplicationConfig config = Graphic::ParseApplicationConfig(argc, argv);
+    Graphic::Application gfxHandler(config);
+
+    // Used by the WarmPipelineCache build target
+    if (config.warmPipelineCache)
+    {
+        gfxHandler.WarmPipelineCache();
+        return 0;
+    }
 
     gfxHandler.RenderLoop();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,82 @@
+// Packs asset directories into a single archive (Core/AssetArchive.hpp) mounted by the
+// renderer's virtual file system. Paths are stored relative to the root directory.
+//
+// Usage : AssetPacker <root dir> <output.pak> <dir relative to root>...
+
+#include <Core/AssetArchive.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Entries are only compressed when LZ4 saves at least this share of their size,
+// otherwise the read is cheaper than the decompression.
+constexpr float MIN_COMPRESSION_SAVINGS = 0.1f;
+
+static bool ReadWholeFile(const fs::path& filePath, std::vector<uint8_t>& data)
+{
+    std::ifstream file(filePath, std::ios::ate | std::ios::binary);
+    if (!file.is_open()) { return false; }
+
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+int32_t main(int argc, const char* argv[])
+{
+    if (argc < 4)
+    {
+        LOG_ERROR("Usage : AssetPacker <root dir> <output.pak> <dir relative to root>...");
+        return 1;
+    }
+
+    fs::path root = argv[1];
+    std::vector<Core::AssetArchiveInput> inputs;
+    uint64_t totalBytes = 0;
+
+    for (int i = 3; i < argc; ++i)
+    {
+        std::error_code errCode;
+        fs::recursive_directory_iterator it(root / argv[i], errCode);
+        if (errCode)
+        {
+            LOG_ERROR("Asset Packer: Failed to open {} : {}", (root / argv[i]).string(), errCode.message());
+            return 1;
+        }
+
+        for (const fs::directory_entry& entry : it)
+        {
+            if (!entry.is_regular_file()) { continue; }
+
+            Core::AssetArchiveInput input;
+            input.path = fs::relative(entry.path(), root).generic_string();
+            if (!ReadWholeFile(entry.path(), input.data))
+            {
+                LOG_ERROR("Asset Packer: Failed to read {}", entry.path().string());
+                return 1;
+            }
+
+            totalBytes += input.data.size();
+            inputs.push_back(std::move(input));
+        }
+    }
+
+    if (!Core::WriteAssetArchive(argv[2], inputs, MIN_COMPRESSION_SAVINGS))
+    {
+        return 1;
+    }
+
+    std::error_code errCode;
+    LOG_INFO("Asset Packer: {} files, {} bytes -> {} ({} bytes)",
+        inputs.size(), totalBytes, argv[2], fs::file_size(argv[2], errCode));
+    return 0;
+}
@@ -0,0 +1,161 @@
+// Cooks glTF / OBJ meshes into the native .gmesh format (Core/CookedMesh.hpp): vertex
+// and index blobs in the VkModel layout, bounds and a LOD table.
+//
+// Usage : MeshCooker <input.gltf|glb|obj> <output.gmesh> [--lods N]
+
+#include <Graphics/MeshImporter.ipp>
+#include <Core/CookedMesh.ipp>
+
+// External Lib
+#include <Logging.hpp>
+
+// STD Lib
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Levels including the full mesh, and the clustering grid of the first reduced level
+// (halved for every following one).
+constexpr uint32_t DEFAULT_LOD_COUNT = 4;
+constexpr uint32_t LOD_BASE_GRID = 256;
+
+// A level that doesn't drop at least this share of the previous one's triangles ends
+// the chain, it would cost memory without saving anything when drawn.
+constexpr float LOD_MIN_REDUCTION = 0.1f;
+
+using Graphic::MeshData;
+using Graphic::Vertex;
+
+static void ComputeBounds(const MeshData& mesh, Core::CookedMeshHeader& header)
+{
+    glm::vec2 boundsMin = mesh.vertices[0].position;
+    glm::vec2 boundsMax = mesh.vertices[0].position;
+    for (const Vertex& vertex : mesh.vertices)
+    {
+        boundsMin = {std::min(boundsMin.x, vertex.position.x), std::min(boundsMin.y, vertex.position.y)};
+        boundsMax = {std::max(boundsMax.x, vertex.position.x), std::max(boundsMax.y, vertex.position.y)};
+    }
+
+    header.boundsMin[0] = boundsMin.x;
+    header.boundsMin[1] = boundsMin.y;
+    header.boundsMax[0] = boundsMax.x;
+    header.boundsMax[1] = boundsMax.y;
+}
+
+// Vertex clustering : vertices are snapped to the first vertex of their grid cell and
+// triangles that collapse are dropped. Every level indexes the original vertex blob.
+static void BuildLod(
+    const MeshData& mesh,
+    const Core::CookedMeshHeader& header,
+    uint32_t gridSize,
+    std::vector<uint32_t>& lodIndices,
+    float& error)
+{
+    float extentX = std::max(header.boundsMax[0] - header.boundsMin[0], 1e-6f);
+    float extentY = std::max(header.boundsMax[1] - header.boundsMin[1], 1e-6f);
+    float cellSize = std::max(extentX, extentY) / static_cast<float>(gridSize);
+
+    std::unordered_map<uint64_t, uint32_t> cellVertex;
+    std::vector<uint32_t> remap(mesh.vertices.size());
+    for (uint32_t i = 0; i < mesh.vertices.size(); ++i)
+    {
+        const glm::vec2& position = mesh.vertices[i].position;
+        auto cellX = static_cast<uint64_t>((position.x - header.boundsMin[0]) / cellSize);
+        auto cellY = static_cast<uint64_t>((position.y - header.boundsMin[1]) / cellSize);
+        remap[i] = cellVertex.emplace((cellY << 32) | cellX, i).first->second;
+    }
+
+    lodIndices.clear();
+    for (size_t i = 0; (i + 2) < mesh.indices.size(); i += 3)
+    {
+        uint32_t a = remap[mesh.indices[i + 0]];
+        uint32_t b = remap[mesh.indices[i + 1]];
+        uint32_t c = remap[mesh.indices[i + 2]];
+        if ((a != b) && (b != c) && (a != c))
+        {
+            lodIndices.insert(lodIndices.end(), {a, b, c});
+        }
+    }
+
+    // A vertex moves at most to the far corner of its cell.
+    error = cellSize * std::sqrt(2.0f);
+}
+
+int32_t main(int argc, const char* argv[])
+{
+    std::string inputPath;
+    std::string outputPath;
+    uint32_t lodCount = DEFAULT_LOD_COUNT;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "--lods") == 0) && ((i + 1) < argc))
+        {
+            lodCount = std::max(1u, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        }
+        else if (inputPath.empty())
+        {
+            inputPath = argv[i];
+        }
+        else if (outputPath.empty())
+        {
+            outputPath = argv[i];
+        }
+    }
+
+    if (inputPath.empty() || outputPath.empty())
+    {
+        LOG_ERROR("Usage : MeshCooker <input.gltf|glb|obj> <output.{}> [--lods N]", Core::COOKED_MESH_EXTENSION);
+        return 1;
+    }
+
+    MeshData mesh;
+    Graphic::MeshImporter importer;
+    if (!importer.Import(inputPath, mesh) || mesh.indices.empty())
+    {
+        return 1;
+    }
+
+    Core::CookedMeshHeader header;
+    header.vertexLayout = static_cast<uint32_t>(Core::CookedVertexLayout::Position2Color3);
+    header.vertexStride = sizeof(Vertex);
+    header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    ComputeBounds(mesh, header);
+
+    // Level 0 is the full index list, reduced levels are appended after it.
+    std::vector<uint32_t> indices = mesh.indices;
+    std::vector<Core::CookedMeshLod> lods{{0, static_cast<uint32_t>(indices.size()), 0.0f, 0}};
+
+    std::vector<uint32_t> lodIndices;
+    for (uint32_t level = 1; level < lodCount; ++level)
+    {
+        float error = 0.0f;
+        BuildLod(mesh, header, std::max(1u, LOD_BASE_GRID >> (level - 1)), lodIndices, error);
+
+        uint32_t previousCount = lods.back().indexCount;
+        if (lodIndices.empty() ||
+            (static_cast<float>(lodIndices.size()) > (static_cast<float>(previousCount) * (1.0f - LOD_MIN_REDUCTION))))
+        {
+            break;
+        }
+
+        lods.push_back({static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(lodIndices.size()), error, 0});
+        indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+    }
+
+    if (!Core::WriteCookedMesh(outputPath, header, mesh.vertices.data(), indices, lods))
+    {
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < lods.size(); ++i)
+    {
+        LOG_INFO("Mesh Cooker: LOD {} : {} triangles, error {}", i, lods[i].indexCount / 3, lods[i].error);
+    }
+    LOG_INFO("Mesh Cooker: {} -> {}", inputPath, outputPath);
+    return 0;
+}